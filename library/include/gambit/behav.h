@@ -23,10 +23,13 @@
 #ifndef LIBGAMBIT_BEHAV_H
 #define LIBGAMBIT_BEHAV_H
 
+#include <vector>
 #include "game.h"
 
 namespace Gambit {
 
+class GameTreeRep;
+
 ///
 /// MixedBehaviorProfile<T> implements a randomized behavior profile on
 /// an extensive game.
@@ -37,9 +40,34 @@ protected:
 
   mutable bool m_cacheValid;
 
-  // structures for storing cached data: nodes
-  mutable Vector<T> m_realizProbs, m_beliefs, m_nvals, m_bvals;
-  mutable Matrix<T> m_nodeValues;
+  // The game, and the versions of its tree and payoffs for which the
+  // data below were compiled; none are compiled while m_tree is null
+  mutable const GameTreeRep *m_tree;
+  mutable unsigned long m_structureVersion, m_payoffVersion;
+
+  // data compiled from the game, indexed by the positions of nodes in
+  // the flattened tree: the index in the profile of the probability of
+  // the action leading to each node, which is 0 if the action is not in
+  // the support and -1 for chance actions; the probabilities of chance
+  // actions; and the payoffs of the outcome at each node and the sum of
+  // those along the path to each node, by node and then player
+  mutable std::vector<int> m_edgeIndex;
+  mutable std::vector<T> m_chanceProbs, m_outcomePayoffs, m_pathPayoffs;
+  // the information set, as indexed in the flattened tree, of each
+  // entry of the profile, and the offset of the values of the actions
+  // at each information set in m_actionValues and m_gripe
+  mutable std::vector<int> m_entryInfoset, m_actionBase;
+  // scratch marks for nodes and information sets to be recomputed
+  mutable std::vector<char> m_nodeMarks, m_infosetMarks;
+
+  // the probabilities at which the cached data were computed
+  mutable std::vector<T> m_cacheProbs;
+
+  // structures for storing cached data: nodes, by position in the
+  // flattened tree, with node values by node and then player
+  mutable std::vector<T> m_realizProbs, m_beliefs, m_nodeValues;
+  // structures used in converting mixed strategies, by node number
+  mutable Vector<T> m_nvals, m_bvals;
 
   // structures for storing cached data: information sets
   mutable PVector<T> m_infosetValues;
@@ -59,10 +87,16 @@ protected:
   
   /// @name Auxiliary functions for computation of interesting values
   //@{
-  void GetPayoff(GameTreeNodeRep *, const T &, int, T &) const;
-  
-  void ComputeSolutionDataPass2(const GameNode &node) const;
-  void ComputeSolutionDataPass1(const GameNode &node) const;
+  /// Returns the position of the node in the flattened tree
+  int NodeIndex(const GameNode &) const;
+  /// Returns the probability of the action leading to the node at position n
+  T EdgeProb(int n) const
+  { return (m_edgeIndex[n] > 0) ? (*this)[m_edgeIndex[n]] :
+      ((m_edgeIndex[n] == 0) ? (T) 0 : m_chanceProbs[n]); }
+
+  void CompileTree(void) const;
+  void ComputeNodeValue(int n) const;
+  void ComputeInfosetData(int h) const;
   void ComputeSolutionData(void) const;
   //@}
 
@@ -65,9 +65,22 @@ public:
   /// @name Reference counting
   //@{
   /// Increment the reference count
-  void IncRef(void) { m_refCount++; }
+  void IncRef(void)
+  {
+    // Handles to the same object may be copied by several threads
+    // evaluating profiles concurrently, so the count is kept atomically
+    // when built with OpenMP
+#pragma omp atomic
+    m_refCount++; 
+  }
   /// Decrement the reference count; delete if reference count is zero.
-  void DecRef(void) { if (!--m_refCount && !m_valid) delete this; }
+  void DecRef(void)
+  {
+    int count;
+#pragma omp atomic capture
+    count = --m_refCount;
+    if (!count && !m_valid) delete this;
+  }
   /// Returns the reference count
   int RefCount(void) const { return m_refCount; }
   //@}
@@ -190,6 +203,13 @@ public:
   virtual ~InvalidFileException() throw() { }
 };
 
+/// Exception thrown when a game table is too large to be stored
+class TableTooLargeException : public Exception {
+public:
+  TableTooLargeException(const std::string &s) : Exception(s) { }
+  virtual ~TableTooLargeException() throw() { }
+};
+
 //=======================================================================
 //             Classes representing objects in a game
 //=======================================================================
@@ -236,11 +256,7 @@ public:
   template <class T> const T &GetPayoff(int pl) const 
     { return (const T &) m_payoffs[pl]; }
   /// Sets the payoff to player 'pl'
-  void SetPayoff(int pl, const std::string &p_value)
-  {
-    m_payoffs[pl] = p_value;
-    //m_game->ClearComputedValues();
-  }
+  void SetPayoff(int pl, const std::string &p_value);
 
   /// Map the outcome to the corresponding outcome in the unrestricted game
   GameOutcome Unrestrict(void) const 
@@ -399,6 +415,7 @@ class GamePlayerRep : public GameObject {
   friend class GameTreeInfosetRep;
   friend class GameStrategyRep;
   friend class GameTreeNodeRep;
+  friend class FlatGameTree;
   friend class StrategySupportProfile;
   template <class T> friend class MixedBehaviorProfile;
   template <class T> friend class MixedStrategyProfile;
@@ -648,6 +665,7 @@ public:
 
 /// This is the class for representing an arbitrary finite game.
 class GameRep : public GameObject {
+  friend class GameOutcomeRep;
   friend class GameTreeInfosetRep;
   friend class GamePlayerRep;
   friend class GameTreeNodeRep;
@@ -655,12 +673,15 @@ class GameRep : public GameObject {
   friend class TablePureStrategyProfileRep;
   template <class T> friend class MixedBehaviorProfile;
   template <class T> friend class MixedStrategyProfile;
+  template <class T> friend class MixedStrategyProfileRep;
   template <class T> friend class TableMixedStrategyProfileRep;
 
 protected:
   std::string m_title, m_comment;
+  /// Incremented whenever any payoff in the game may have changed
+  mutable unsigned long m_payoffVersion;
 
-  GameRep(void) { }
+  GameRep(void) : m_payoffVersion(0) { }
 
   /// @name Managing the representation
   //@{
@@ -672,6 +693,8 @@ protected:
   virtual void BuildComputedValues(void) { }
   /// Have computed values been built?
   virtual bool HasComputedValues(void) const { return false; }
+  /// Discard any cached copies of outcome payoffs
+  virtual void ClearPayoffCache(void) const { m_payoffVersion++; }
   //@}
 
 
@@ -722,6 +745,18 @@ public:
   { GameInfoset s, t; return IsPerfectRecall(s, t); }
   //@}
 
+  /// @name Concurrent access
+  //@{
+  /// \brief Builds all data about the game that is computed on demand.
+  ///
+  /// Once this has been called, the game may be read by several threads
+  /// at once, for example to compute payoffs of different profiles, as
+  /// long as the game is not modified.  Returns false if the
+  /// representation does not support concurrent reads.
+  virtual bool PrepareConcurrentAccess(void)
+  { BuildComputedValues(); return true; }
+  //@}
+
   /// @name Writing data files
   //@{
   /// Write the game to a savefile in the specified format.
@@ -743,7 +778,7 @@ public:
   /// Gets the i'th strategy in the game, numbered globally
   virtual GameStrategy GetStrategy(int p_index) const = 0;
   /// Returns the number of strategy contingencies in the game
-  virtual int NumStrategyContingencies(void) const = 0;
+  virtual long NumStrategyContingencies(void) const = 0;
   /// Returns the total number of actions in the game
   virtual int BehavProfileLength(void) const = 0;
   /// Returns the total number of strategies in the game
@@ -816,6 +851,11 @@ Game NewTable(const Array<int> &p_dim, bool p_sparseOutcomes = false);
 // all classes to be defined.
 
 inline Game GameOutcomeRep::GetGame(void) const { return m_game; }
+inline void GameOutcomeRep::SetPayoff(int pl, const std::string &p_value)
+{
+  m_payoffs[pl] = p_value;
+  m_game->ClearPayoffCache();
+}
 
 inline GamePlayer GameStrategyRep::GetPlayer(void) const { return m_player; }
 
@@ -841,6 +881,11 @@ template<> inline std::string PureBehaviorProfile::GetPayoff(int pl) const
 
 /// Reads a game in .efg or .nfg format from the input stream
 Game ReadGame(std::istream &) throw (InvalidFileException);
+/// \brief Reads a game from the file
+///
+/// As ReadGame(), except that a file in binary table format is mapped
+/// into memory rather than copied.
+Game ReadGameFile(const std::string &p_filename) throw (InvalidFileException);
 
 } // end namespace gambit
 
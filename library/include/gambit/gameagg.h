@@ -70,7 +70,7 @@ public:
   /// Returns the total number of strategies in the game
   virtual int MixedProfileLength(void) const 
   { return aggPtr->getNumActions(); }
-  virtual int NumStrategyContingencies(void) const
+  virtual long NumStrategyContingencies(void) const
   { throw UndefinedException(); }
   //@}
 
@@ -134,6 +134,8 @@ public:
   //@{
   virtual bool IsTree(void) const { return false; }
   virtual bool IsAgg(void) const { return true; }
+  /// The payoff computations keep scratch data in the game
+  virtual bool PrepareConcurrentAccess(void) { return false; }
   virtual bool IsPerfectRecall(GameInfoset &, GameInfoset &) const
   { return true; }
   virtual bool IsConstSum(void) const;
@@ -63,7 +63,7 @@ public:
   virtual GameStrategy GetStrategy(int p_index) const
   { throw UndefinedException(); }
   /// Returns the number of strategy contingencies in the game
-  virtual int NumStrategyContingencies(void) const
+  virtual long NumStrategyContingencies(void) const
   { throw UndefinedException(); }
   /// Returns the total number of actions in the game
   virtual int BehavProfileLength(void) const
@@ -134,6 +134,8 @@ public:
   //@{
   virtual bool IsTree(void) const { return false; }
   virtual bool IsBagg(void) const { return true; }
+  /// The payoff computations keep scratch data in the game
+  virtual bool PrepareConcurrentAccess(void) { return false; }
   virtual bool IsPerfectRecall(GameInfoset &, GameInfoset &) const 
   { return true; }
   virtual bool IsConstSum(void) const { throw UndefinedException(); }
@@ -65,7 +65,7 @@ public:
   /// Gets the i'th strategy in the game, numbered globally
   virtual GameStrategy GetStrategy(int p_index) const;
   /// Returns the number of strategy contingencies in the game
-  virtual int NumStrategyContingencies(void) const;
+  virtual long NumStrategyContingencies(void) const;
   /// Returns the total number of strategies in the game
   virtual int MixedProfileLength(void) const;
   //@}
@@ -88,6 +88,13 @@ public:
   virtual GameOutcome GetOutcome(int index) const { return m_outcomes[index]; }
   /// Creates a new outcome in the game
   virtual GameOutcome NewOutcome(void);
+  //@}
+
+  /// @name Concurrent access
+  //@{
+  /// Builds the computed values and all representations of the payoffs
+  virtual bool PrepareConcurrentAccess(void);
+  //@}
 
   /// @name Writing data files
   //@{
@@ -23,10 +23,34 @@
 #ifndef GAMETABLE_H
 #define GAMETABLE_H
 
+#include <vector>
 #include "gameexpl.h"
 
 namespace Gambit {
 
+class BinaryTableData;
+
+///
+/// A table game may also be backed by a file in binary table format,
+/// which stores the payoffs of all contingencies without any outcome
+/// structure.  The file consists of a header of 32-bit little-endian
+/// unsigned integers,
+///   - the eight bytes "GAMBITNB" identifying the format,
+///   - the format version, currently 1,
+///   - the type of the payoffs, 1 for 32-bit signed integers or
+///     2 for IEEE 64-bit floating point numbers,
+///   - the number of players, and the number of strategies of each player,
+/// followed by zero padding to a multiple of eight bytes, and then the
+/// little-endian payoffs of each player in turn, over all contingencies
+/// with the first player's strategy varying fastest (that is, in the
+/// order given by the strategy offsets).
+///
+/// Such games are read without creating any outcomes, and payoffs are
+/// taken directly from the file, which is mapped into memory where the
+/// platform supports it.  Outcomes are created for all contingencies
+/// by Materialize(), or when the game is first modified; until then
+/// the game has none.
+///
 class GameTableRep : public GameExplicitRep {
   friend class StrategySupportProfile;
   friend class GamePlayerRep;
@@ -35,13 +59,39 @@ class GameTableRep : public GameExplicitRep {
   template <class T> friend class MixedStrategyProfile;
   template <class T> friend class TableMixedStrategyProfileRep;
 private:
-  Array<GameOutcomeRep *> m_results;
+  /// The outcome at each contingency; contingency i is at position i-1
+  std::vector<GameOutcomeRep *> m_results;
   Game m_unrestricted;
+  /// The binary table the payoffs are taken from, if any
+  BinaryTableData *m_binary;
+
+  /// @name Packed payoff tables
+  ///
+  /// The payoffs of all contingencies, stored contiguously for each
+  /// player in the same order as m_results.  These are built on demand
+  /// from the outcomes, and discarded whenever the outcomes change.
+  //@{
+  mutable std::vector<double> m_doublePayoffs;
+  mutable std::vector<Rational> m_rationalPayoffs;
+  /// Whether all payoffs are exact as doubles; -1 if not yet known
+  mutable int m_exactDoubles;
+  //@}
 
   /// @name Private auxiliary functions
   //@{
   void IndexStrategies(void);
+  void PrepareNewStrategy(int p_player);
   void RebuildTable(void);
+  template <class T> void BuildPayoffTable(std::vector<T> &) const;
+  //@}
+
+  /// Construct a table game with payoffs from the binary table
+  GameTableRep(BinaryTableData *p_data);
+
+  /// @name Managing the representation
+  //@{
+  /// Discard the packed payoff tables
+  virtual void ClearPayoffCache(void) const;
   //@}
 
 public:
@@ -49,14 +99,51 @@ public:
   //@{
   /// Construct a new table game with the given dimension
   /// If p_sparseOutcomes = true, outcomes for all contingencies are left null
+  /// Throws TableTooLargeException if the table cannot be stored.
   GameTableRep(const Array<int> &p_dim, bool p_sparseOutcomes = false);
+  /// Clean up the game, releasing any binary table
+  virtual ~GameTableRep();
   virtual Game Copy(void) const;
+
+  /// \brief Read a game from a file in binary table format
+  ///
+  /// The file is mapped read-only into memory where the platform
+  /// supports it, and read into memory otherwise.  The file must not
+  /// be modified while the game exists.
+  static Game MapBinaryFile(const std::string &p_filename);
+  /// Read a game from the contents of a file in binary table format
+  static Game ReadBinaryFile(const std::string &p_contents);
+  /// Returns true if the data begins with the binary table format marker
+  static bool IsBinaryFile(const std::string &p_header);
+  /// \brief Creates an outcome for each contingency of a binary table
+  ///
+  /// A game read from a binary table has no outcomes, its payoffs being
+  /// read from the table directly.  This replaces the table by an
+  /// outcome for each contingency, after which the game is an ordinary
+  /// table game; any modification of the game does so as well.  This
+  /// discards the packed payoff tables.  It has no effect on other games.
+  void Materialize(void);
+
+  /// \brief Estimates the memory required for a table of the given dimension
+  ///
+  /// Returns the approximate number of bytes needed to construct a
+  /// table game with the given dimension, including the outcomes created
+  /// if p_sparseOutcomes is false, and the packed double-precision payoff
+  /// table built when profiles on the game are evaluated.  The estimate
+  /// is computed in floating point, so it is meaningful even for tables
+  /// whose size exceeds the range of any integer type.
+  static double EstimateMemory(const Array<int> &p_dim,
+			       bool p_sparseOutcomes = false);
+  /// Returns the number of contingencies in the table
+  long NumContingencies(void) const;
   //@}
 
   /// @name General data access
   //@{
   virtual bool IsTree(void) const { return false; }
   virtual bool IsConstSum(void) const;
+  virtual Rational GetMinPayoff(int pl = 0) const;
+  virtual Rational GetMaxPayoff(int pl = 0) const;
   virtual bool IsPerfectRecall(GameInfoset &, GameInfoset &) const
   { return true; }
   //@}
@@ -112,14 +199,46 @@ public:
 
   /// @name Outcomes
   //@{
+  /// Creates a new outcome in the game
+  virtual GameOutcome NewOutcome(void);
   /// Deletes the specified outcome from the game
   virtual void DeleteOutcome(const GameOutcome &);
   //@}
 
+  /// @name Concurrent access
+  //@{
+  /// Builds the computed values, all representations of the payoffs, and
+  /// the packed payoff tables in both double and rational precision
+  virtual bool PrepareConcurrentAccess(void);
+  //@}
+
+  /// @name Packed payoff tables
+  //@{
+  /// \brief Returns the payoffs to player pl in all contingencies.
+  ///
+  /// Returns a pointer to the player's payoffs, with the payoff in
+  /// the contingency with table index i (as computed from the strategy
+  /// offsets) at position i-1.  The table is built on first use, and
+  /// the pointer remains valid until the payoffs or dimensions of the
+  /// game are changed.
+  template <class T> const T *GetPayoffTable(int pl) const;
+  /// \brief Returns true if the double payoffs are all exact.
+  ///
+  /// When this is true, comparisons of payoffs in the double-precision
+  /// table give the same results as comparisons of the exact payoffs.
+  bool HasExactDoublePayoffs(void) const;
+  //@}
+
   /// @name Writing data files
   //@{
   /// Write the game to a file in .nfg outcome format
   virtual void WriteNfgFile(std::ostream &) const;
+  /// \brief Write the strategic form of a game in binary table format
+  ///
+  /// Payoffs are written as integers if they all are integers in range,
+  /// and as floating point numbers otherwise.  Throws ValueException if
+  /// a payoff has no exact floating point representation.
+  static void WriteBinaryFile(std::ostream &, const Game &);
   //@}
 
   virtual PureStrategyProfile NewPureStrategyProfile(void) const;
@@ -130,6 +249,9 @@ public:
 
 };
 
+template<> const double *GameTableRep::GetPayoffTable(int pl) const;
+template<> const Rational *GameTableRep::GetPayoffTable(int pl) const;
+
 }
 
 
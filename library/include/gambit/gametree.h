@@ -23,6 +23,7 @@
 #ifndef GAMETREE_H
 #define GAMETREE_H
 
+#include <vector>
 #include "gameexpl.h"
 
 namespace Gambit {
@@ -58,6 +59,7 @@ public:
 
 class GameTreeInfosetRep : public GameInfosetRep {
   friend class GameTreeRep;
+  friend class FlatGameTree;
   friend class GameTreeActionRep;
   friend class GamePlayerRep;
   friend class GameTreeNodeRep;
@@ -132,6 +134,7 @@ class GameTreeNodeRep : public GameNodeRep {
   friend class GameTreeInfosetRep;
   friend class GamePlayerRep;
   friend class PureBehaviorProfile;
+  friend class FlatGameTree;
   template <class T> friend class MixedBehaviorProfile;
   
 protected:
@@ -196,14 +199,84 @@ public:
 };
 
 
+///
+/// The nodes of a game tree in preorder, stored as arrays indexed by
+/// the position of the node in the order.  The subtree of each node
+/// occupies a contiguous range of positions, and each node follows its
+/// parent, so that computations on the tree can be written as loops
+/// over arrays rather than recursions over nodes.  This is built on
+/// demand by the game, and rebuilt after any change to the tree.
+///
+class FlatGameTree {
+  friend class GameTreeRep;
+
+public:
+  /// @name Nodes
+  //@{
+  /// Returns the number of nodes in the tree
+  int NumNodes(void) const { return m_nodes.size(); }
+  /// Returns the node at position n
+  GameTreeNodeRep *GetNode(int n) const { return m_nodes[n]; }
+  /// Returns the position of the node
+  int GetIndex(const GameNodeRep *p_node) const
+  { return m_index[p_node->GetNumber()]; }
+  /// Returns the position of the parent of node n, or -1 at the root
+  int GetParent(int n) const { return m_parent[n]; }
+  /// Returns one past the position of the last node in the subtree of n
+  int GetEnd(int n) const { return m_end[n]; }
+  /// Returns the number of the action leading to node n, or 0 at the root
+  int GetActionNumber(int n) const { return m_action[n]; }
+  /// Returns the information set at node n, or null if it is terminal
+  GameTreeInfosetRep *GetInfoset(int n) const { return m_infoset[n]; }
+  /// Returns the player at node n, 0 for chance, or -1 if it is terminal
+  int GetPlayer(int n) const { return m_player[n]; }
+  /// Returns the outcome at node n, or null if there is none
+  GameOutcomeRep *GetOutcome(int n) const { return m_outcome[n]; }
+  //@}
+
+  /// @name Information sets of the personal players
+  //@{
+  /// Returns the number of information sets
+  int NumInfosets(void) const { return m_members.size(); }
+  /// Returns the index of the information set of the player,
+  /// counting those of all players in order from zero
+  int GetInfosetIndex(int pl, int iset) const
+  { return m_firstInfoset[pl] + iset - 1; }
+  /// Returns the index of the information set at node n, or -1 if
+  /// the node is terminal or belongs to chance
+  int GetInfosetIndex(int n) const { return m_infosetIndex[n]; }
+  /// Returns information set h
+  GameTreeInfosetRep *GetInfosetByIndex(int h) const { return m_infosets[h]; }
+  /// Returns the positions of the members of information set h
+  const std::vector<int> &GetMembers(int h) const { return m_members[h]; }
+  //@}
+
+private:
+  std::vector<GameTreeNodeRep *> m_nodes;
+  std::vector<int> m_index, m_parent, m_end, m_action, m_player;
+  std::vector<GameTreeInfosetRep *> m_infoset;
+  std::vector<GameOutcomeRep *> m_outcome;
+  std::vector<int> m_firstInfoset, m_infosetIndex;
+  std::vector<GameTreeInfosetRep *> m_infosets;
+  std::vector<std::vector<int> > m_members;
+
+  void Build(const GameTreeRep *p_game);
+};
+
 class GameTreeRep : public GameExplicitRep {
   friend class GameTreeNodeRep;
   friend class GameTreeInfosetRep;
   friend class GameTreeActionRep;
+  friend class FlatGameTree;
 protected:
   mutable bool m_computedValues, m_doCanon;
   GameTreeNodeRep *m_root;
   GamePlayerRep *m_chance;
+  mutable FlatGameTree m_flatTree;
+  mutable bool m_flatTreeValid;
+  /// Incremented whenever the tree, its outcomes or chance probabilities
+  /// may have changed
+  mutable unsigned long m_structureVersion;
 
   /// @name Private auxiliary functions
   //@{
@@ -253,10 +326,25 @@ public:
   virtual GameNode GetRoot(void) const { return m_root; } 
   /// Returns the number of nodes in the game
   int NumNodes(void) const;
+  /// \brief Returns the nodes of the game in preorder, as arrays
+  ///
+  /// The arrays are built on first use.  Threads sharing the game must
+  /// call PrepareConcurrentAccess() first, so that they are not built
+  /// concurrently.
+  const FlatGameTree &GetFlatTree(void) const;
+  /// Returns a number which changes whenever the flattened tree does
+  unsigned long GetStructureVersion(void) const { return m_structureVersion; }
   //@}
 
   virtual void DeleteOutcome(const GameOutcome &);
 
+  /// @name Concurrent access
+  //@{
+  /// Builds the computed values, all representations of the payoffs and
+  /// chance probabilities, and the flattened tree
+  virtual bool PrepareConcurrentAccess(void);
+  //@}
+
   /// @name Writing data files
   //@{
   virtual void WriteEfgFile(std::ostream &) const;
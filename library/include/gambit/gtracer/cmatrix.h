@@ -52,33 +52,27 @@ public:
 class cvector {
 friend class cmatrix;
 public:
- static int num_vec_cons; 
 	inline cvector() {
-	  cvector::num_vec_cons++;
 		m = 1;
 		x = new double[1];
 	}
 	inline cvector(int m) {
-	  cvector::num_vec_cons++;
 		this->m = m;
 		x = new double[m];
 	}
 	~cvector(); 
 	inline cvector(const cvector &v) {
-	  cvector::num_vec_cons++;
 		m = v.m;
 		x = new double[m];
 		//for(int i=0;i<m;i++) x[i] = v.x[i];
 		memcpy(x,v.x,m*sizeof(double));
 	}
 	inline cvector(int m, const double &a) {
-	  cvector::num_vec_cons++;
 		this->m = m;
 		x = new double[m];
 		for(int i=0;i<m;i++) x[i] = a;
 	}
 	inline cvector(double *v, int m, bool keep=false) {
-	  cvector::num_vec_cons++;
 		this->m = m;
 		if (keep) x = v;
 		else {
@@ -684,6 +678,23 @@ public:
 		return *this;
 	}
 
+	// Sets ret to the product of this and ma, without allocating;
+	// the result is the same as that of operator*=
+	inline void multiply(const cmatrix &ma, cmatrix &ret) const {
+		if (n!=ma.m || ret.m!=m || ret.n!=ma.n) {
+		  std::cerr << "invalid cmatrix multiply" << std::endl;
+		  //assert(0);
+		}
+		int i,j,k,c=0;
+		for(i=0;i<m;i++) {
+		  for(j=0;j<ma.n;j++,c++) {
+		    ret.x[c] = 0;
+		    for(k=0;k<n;k++)
+		      ret.x[c] += x[i*n+k] * ma.x[k*ma.n+j];
+		  }
+		}
+	}
+
 	inline cmatrix &operator+=(const double &a) {
 		for(int i=0;i<s;i++) x[i] += a;
 		return *this;
@@ -786,6 +797,8 @@ bool solve(cvector &b, cvector &dest);
 	cmatrix inv(bool &worked) const;
 	inline cmatrix inv() const { bool w; return inv(w); }
 	double adjoint();
+	// As adjoint(), using work (m by m) and index (length 3m) as scratch
+	double adjoint(cmatrix &work, std::vector<int> &index);
 	inline double trace();
 	double testAdjoint();
 	inline void multiply(const cvector &source, cvector &dest) {
@@ -256,6 +256,8 @@ class gnmgame {
   int numPlayers, numStrategies, numActions;
   int *actions;
   int maxActions;
+  // scratch storage for retract(), so that it does not allocate
+  std::vector<double> retractScratch;
 };
 
 }  // end namespace Gambit::gametracer
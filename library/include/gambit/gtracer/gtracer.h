@@ -33,7 +33,32 @@
 namespace Gambit {
 namespace gametracer {
 
-int GNM(gnmgame &A, cvector &g, cvector **&Eq, int steps, double fuzz, int LNMFreq, int LNMMax, double LambdaMin, bool wobble, double threshold, bool verbose);
+// Counts of the work done by GNM() in following one perturbation ray
+struct GNMStatistics {
+  int steps;    // linear steps taken along the path
+  int lnmCalls; // runs of the local Newton method
+
+  GNMStatistics() : steps(0), lnmCalls(0) { }
+};
+
+// Scratch storage for GNM().  A workspace may be used for any number of
+// calls on games with the given numbers of players and actions, so
+// that following a ray allocates nothing but the equilibria found.
+class GNMWorkspace {
+ public:
+  GNMWorkspace(int numPlayers, int numActions);
+
+  inline int getNumPlayers() const { return G.getm(); }
+  inline int getNumActions() const { return sigma.getm(); }
+
+  std::vector<int> s, B;
+  cmatrix DG, R, I, J, Y1, adjointWork;
+  std::vector<int> adjointIndex;
+  cvector sigma, g0, z, v, dz, dv, nothing, err, backup;
+  cvector G, yn1, ym1, ym2, ym3;
+};
+
+int GNM(gnmgame &A, cvector &g, std::vector<cvector> &Eq, GNMWorkspace &W, int steps, double fuzz, int LNMFreq, int LNMMax, double LambdaMin, bool wobble, double threshold, bool verbose, GNMStatistics *stats = 0);
 
 int IPA(gnmgame &A, cvector &g, cvector &zh, double alpha, double fuzz, cvector &ans,int maxiter=-1);
 
@@ -61,6 +61,9 @@ class nfgame : public gnmgame {
   double *scaleMatrix(cvector &s, double *m, int n);
   cvector payoffs;
   int *blockSize;
+  // scratch storage for the payoff computations, so that they do not
+  // allocate
+  std::vector<double> scratchPayoffs, scratchLocal;
 };
 
 inline std::ostream& operator<< (std::ostream& s, nfgame& g){
@@ -53,6 +53,18 @@ public:
     return true;
   }
   bool operator!=(const BFS &M) const  { return !(*this == M); }
+  // order BFS's lexicographically by their bases, consistently with
+  // operator==, so that they can be kept in sets
+  bool operator<(const BFS &M) const {
+    typename std::map<int, T>::const_iterator iter = m_map.begin();
+    typename std::map<int, T>::const_iterator other = M.m_map.begin();
+    for (; iter != m_map.end() && other != M.m_map.end(); iter++, other++) {
+      if ((*iter).first != (*other).first) {
+	return (*iter).first < (*other).first;
+      }
+    }
+    return (iter == m_map.end() && other != M.m_map.end());
+  }
 
   // Provide map-like operations
   int count(int key) const { return (m_map.count(key) > 0); }
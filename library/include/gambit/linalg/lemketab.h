@@ -53,6 +53,11 @@ public:
   int PivotIn(int i);
   int ExitIndex(int i);
   int LemkePath(int dup); // follow a path of ACBFS's from one CBFS to another
+
+private:
+  // Scratch space for ExitIndex(), to avoid allocating on every pivot
+  Vector<T> m_incol, m_col;
+  Array<int> m_best;
 };
 
 }  // end namespace Gambit::linalg
@@ -65,6 +65,8 @@ public:
   /// @name Raw Tableau functions
   //@{
   void Refactor(void) { T1.Refactor(); T2.Refactor(); }
+  void SetDense(bool p_dense) { T1.SetDense(p_dense); T2.SetDense(p_dense); }
+  bool IsDense(void) const { return T1.IsDense(); }
   //@}
   
   /// @name Miscellaneous functions
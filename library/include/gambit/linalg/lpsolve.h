@@ -42,6 +42,9 @@ namespace linalg {
 /// solution.  The components are indexed by the columns of A, with the 
 /// excess columns representing the artificial and slack variables.   
 ///
+/// Once solved, the problem may be solved again for another objective
+/// by Reoptimize(), which starts from the optimal basis already found.
+///
 template <class T> class LPSolve {
 private:
   bool well_formed, feasible, bounded;
@@ -57,6 +60,7 @@ private:
   void Solve(int phase = 0);
   int Enter(void);
   int Exit(int);
+  void StoreSolution(void);
 
   static Array<int> Artificials(const Vector<T> &);
   
@@ -64,12 +68,18 @@ public:
   LPSolve(const Matrix<T> &A, const Vector<T> &B, const Vector<T> &C,
 	  int nequals);   // nequals = number of equalities (last nequals rows)
   ~LPSolve();
+
+  /// Maximizes c x over the same constraints, starting from the current
+  /// basis, which remains feasible
+  void Reoptimize(const Vector<T> &c);
   
   T OptimumCost(void) const { return total_cost; }
   const Vector<T> &OptimumVector(void) const { return (*xx); }
   const List< BFS<T> > &GetAll(void);
   const LPTableau<T> &GetTableau(void) const { return tab; }
   const BFS<T> &OptimumBFS(void) const { return opt_bfs; }
+  /// The values of the dual variables, indexed by the rows of A
+  const Vector<T> &DualVector(void) const { return y; }
   
   bool IsWellFormed(void) const { return well_formed; }
   bool IsFeasible(void) const { return feasible; }
@@ -23,6 +23,7 @@
 #ifndef TABLEAU_H  
 #define TABLEAU_H
 
+#include <vector>
 #include "gambit/linalg/btableau.h"
 #include "gambit/linalg/ludecomp.h"
 
@@ -63,6 +64,9 @@ public:
 
   void Refactor();
   void SetRefactor(int);
+  // Pivot on an explicit dense tableau instead of the LU decomposition
+  void SetDense(bool);
+  bool IsDense(void) const { return m_dense; }
 
   void SetConst(const Vector<double> &bnew);
   void SetBasis( const Basis &); // set new Tableau
@@ -75,6 +79,22 @@ private:
   LUdecomp<double> B;
   // A temporary column vector, to avoid frequent allocation
   mutable Vector<double> tmpcol;
+
+  // In dense mode, B is not maintained; instead the whole tableau is
+  // kept explicitly, row-major, one row per basis position.  Each row
+  // holds the slack columns (which make up the basis inverse), the
+  // structural and artificial columns, and the right-hand side.
+  bool m_dense;
+  int m_rows, m_width;
+  std::vector<double> m_tab;
+  // Scratch space for Solve() and SolveT(), to avoid allocation
+  std::vector<double> m_scratch;
+  // Refactoring frequency, as for LUdecomp, and pivots since the last one
+  int m_refactor, m_sinceRefactor;
+
+  int DenseColumn(int label) const;
+  void DenseFactor();
+  void DensePivot(int row, int col);
 };
 
 
@@ -82,16 +102,33 @@ template<>
 class Tableau<Rational> : public TableauInterface<Rational>{
 private:
   int remap(int col_index) const;  // aligns the column indexes
-  Matrix<Rational> GetInverse();
-
-  Matrix<Integer> Tabdat;  // This caries the full tableau
-  Vector<Integer> Coeff;   // and coeffieient vector
+  void MultiplyInverse(const Vector<Integer> &, Vector<Integer> &) const;
+
+  // The full fraction-free tableau, row-major, one row per basis
+  // position, with the coefficient vector as the last column.  Entries
+  // are held as machine integers; an entry whose pivot update would
+  // overflow is promoted to an Integer on its own, and demoted again
+  // once it fits.
+  int m_cols;  // number of columns, not counting the coefficients
+  std::vector<long> m_small;
+  std::vector<char> m_isBig;
+  std::vector<Integer> m_big;  // allocated on the first promotion
   Integer totdenom;  // This carries the denominator for Q data or 1 for Z
   Integer denom;  // This is the denominator for the simplex
 
-  mutable Vector<Rational> tmpcol; // temporary column vector, to avoid allocation
+  int Index(int row, int col) const
+    { return (row - MinRow()) * (m_cols + 1) + (col - MinCol()); }
+  int CoeffIndex(int row) const
+    { return (row - MinRow()) * (m_cols + 1) + m_cols; }
+  Integer Entry(int index) const
+    { return (m_isBig[index]) ? m_big[index] : Integer(m_small[index]); }
+  const Integer &EntryRef(int index, Integer &p_scratch) const
+    { if (m_isBig[index]) return m_big[index];
+      p_scratch = m_small[index]; return p_scratch; }
+  void SetEntry(int index, const Integer &);
+  void InitEntries(void);
 
-  void MySolveColumn(int, Vector<Rational> &);  // column in new basis 
+  mutable Vector<Rational> tmpcol; // temporary column vector, to avoid allocation
 
 protected:
   Array<int> nonbasic;     //** nonbasic variables -- should be moved to Basis
@@ -121,6 +158,9 @@ public:
 
   void Refactor();
   void SetRefactor(int);
+  // The exact tableau is always kept explicitly
+  void SetDense(bool) { }
+  bool IsDense(void) const { return true; }
 
   void SetConst(const Vector<Rational> &bnew);
   void SetBasis( const Basis &); // set new Tableau
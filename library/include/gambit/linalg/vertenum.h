@@ -38,6 +38,8 @@ namespace linalg {
 // where b <= 0.  Enumeration starts from the vertex y = 0.
 // All computation is done in the class constructor. The 
 // list of vertices can be accessed by VertexList()
+// If p_dense is set, the search uses dense tableaux; see
+// Tableau<double>::SetDense().
 //  
 // The code is based on the reverse Pivoting algorithm of Avis 
 // and Fukuda, Discrete Computational Geom (1992) 8:295-313.
@@ -45,6 +47,7 @@ namespace linalg {
 template <class T> class VertexEnumerator {
 private:
   int mult_opt,depth;
+  bool dense;  // pivot on explicit dense tableaux (floating-point only)
   int n;  // N is the number of columns, which is the # of dimensions.
   int k;  // K is the number of inequalities given.
   const Matrix<T> &A;   
@@ -63,7 +66,7 @@ private:
   void DualSearch(LPTableau<T> &tab);
 
 public:
-  VertexEnumerator(const Matrix<T> &, const Vector<T> &);
+  VertexEnumerator(const Matrix<T> &, const Vector<T> &, bool p_dense = false);
   VertexEnumerator(LPTableau<T> &);
   ~VertexEnumerator() { }
   
@@ -23,13 +23,29 @@
 #ifndef LIBGAMBIT_MIXED_H
 #define LIBGAMBIT_MIXED_H
 
+#include <vector>
 #include "vector.h"
+#include "matrix.h"
 #include "gameagg.h"
 #include "gamebagg.h"
 
 namespace Gambit {
 
 template <class T> class MixedStrategyProfileRep {
+private:
+  /// @name Cached bulk payoff computations
+  //@{
+  /// The probabilities and payoff version the cached values refer to
+  mutable Vector<T> m_cacheProbs;
+  mutable unsigned long m_cacheVersion;
+  mutable bool m_valuesValid, m_jacobianValid;
+  mutable Vector<T> m_values;
+  mutable Matrix<T> m_jacobian;
+
+  /// Discards the cached values if the profile or game has changed since
+  void CheckCache(void) const;
+  //@}
+
 public:
   Vector<T> m_probs;
   StrategySupportProfile m_support;
@@ -52,6 +68,23 @@ public:
   virtual T GetPayoff(int pl) const = 0;
   virtual T GetPayoffDeriv(int pl, const GameStrategy &) const = 0;
   virtual T GetPayoffDeriv(int pl, const GameStrategy &, const GameStrategy &) const = 0;
+  /// Computes the payoffs to each of player pl's strategies in the support
+  virtual Vector<T> GetStrategyValues(int pl) const;
+  /// \brief Computes the strategy values and payoff Jacobian together
+  ///
+  /// Fills p_values with the payoff to each strategy in the support, and
+  /// p_jacobian with the second derivative of the payoff to the player
+  /// choosing the row strategy with respect to the row and column
+  /// strategies.  Both are indexed in profile order, and are correctly
+  /// dimensioned on entry.  Entries of p_jacobian for two strategies of
+  /// the same player are zero on entry, and need not be written.
+  virtual void ComputePayoffJacobian(Vector<T> &p_values,
+				     Matrix<T> &p_jacobian) const;
+
+  /// Returns the payoff to each strategy in the support, in profile order
+  const Vector<T> &GetStrategyValues(void) const;
+  /// Returns the payoff Jacobian of the profile, in profile order
+  const Matrix<T> &GetPayoffJacobian(void) const;
 };
 
 template <class T> class TreeMixedStrategyProfileRep 
@@ -72,16 +105,31 @@ public:
 template <class T> class TableMixedStrategyProfileRep
   : public MixedStrategyProfileRep<T> {
 private:
-  /// @name Private recursive payoff functions
+  /// @name Private payoff computation
   //@{
-  /// Recursive computation of payoff to player pl
-  T GetPayoff(int pl, int index, int i) const;
-  /// Recursive computation of payoff derivative
-  void GetPayoffDeriv(int pl, int const_pl, int cur_pl, long index,
-		      const T &prob, T &value) const;
-  /// Recursive computation of payoff second derivative
-  void GetPayoffDeriv(int pl, int const_pl1, int const_pl2, 
-		      int cur_pl, long index, const T &prob, T &value) const;
+  /// \brief Contracts a packed payoff table with the profile.
+  ///
+  /// Sums the payoffs over the strategies of all players other than
+  /// p_skip1 and p_skip2 (zero if not used), weighted by the probabilities
+  /// they are played.  The contraction proceeds from the last player
+  /// to the first, so each step is a sequence of multiply-adds over
+  /// contiguous blocks of the table.  On return, p_result holds the
+  /// table over the strategies of the skipped players, in their 
+  /// original order.  If p_positive is true, strategies with
+  /// nonpositive probability are omitted; otherwise only strategies 
+  /// with zero probability are omitted.
+  void Contract(const T *p_payoffs, int p_skip1, int p_skip2,
+		bool p_positive, std::vector<T> &p_result) const;
+  /// \brief Contracts a partially-contracted table with the profile.
+  ///
+  /// As Contract(), but p_table is laid out over the strategies of
+  /// players 1 through p_last, repeated p_outer times, and only players
+  /// p_first through p_last are summed over.  On return, p_result
+  /// holds the table over players before p_first, followed by the
+  /// skipped players in the range, followed by the outer block.
+  void Contract(const T *p_table, int p_first, int p_last, long p_outer,
+		int p_skip1, int p_skip2, bool p_positive,
+		std::vector<T> &p_result) const;
   //@}
 
 public:
@@ -94,6 +142,9 @@ public:
   virtual T GetPayoff(int pl) const;
   virtual T GetPayoffDeriv(int pl, const GameStrategy &) const;
   virtual T GetPayoffDeriv(int pl, const GameStrategy &, const GameStrategy &) const;
+  virtual Vector<T> GetStrategyValues(int pl) const;
+  virtual void ComputePayoffJacobian(Vector<T> &p_values,
+				     Matrix<T> &p_jacobian) const;
 };
 
 template <class T> class AggMixedStrategyProfileRep
@@ -253,6 +304,36 @@ public:
   T GetPayoff(const GameStrategy &p_strategy) const
   { return GetPayoffDeriv(p_strategy->GetPlayer()->GetNumber(), p_strategy); }
 
+  /// \brief Computes the payoffs to all of the player's strategies
+  ///
+  /// Computes the payoff to playing each of the player's strategies
+  /// in the support against the profile, in the same order as
+  /// operator[](const GamePlayer &).  This is equivalent to, but for
+  /// table games much faster than, calling GetPayoff() on each strategy.
+  Vector<T> GetStrategyValues(const GamePlayer &p_player) const
+  { return m_rep->GetStrategyValues(p_player->GetNumber()); }
+
+  /// \brief Computes the payoffs to all strategies in the support
+  ///
+  /// Returns the payoff to playing each strategy in the support against
+  /// the profile, indexed in the same order as the profile itself.
+  /// The result is cached until the profile or the game is modified.
+  const Vector<T> &GetStrategyValues(void) const
+  { return m_rep->GetStrategyValues(); }
+
+  /// \brief Computes the Jacobian of the strategy values
+  ///
+  /// Returns the matrix whose (i,j) entry is the second derivative of
+  /// the payoff to the player owning strategy i, with respect to the
+  /// probabilities of strategies i and j; that is, the derivative of
+  /// the value of strategy i with respect to the probability of j.
+  /// Entries are zero where i and j belong to the same player.  Rows and
+  /// columns are indexed in the same order as the profile.  The result
+  /// is computed along with GetStrategyValues(), and is cached until the
+  /// profile or the game is modified.
+  const Matrix<T> &GetPayoffJacobian(void) const
+  { return m_rep->GetPayoffJacobian(); }
+
   /// \brief Computes the Lyapunov value of the profile
   ///
   /// Computes the Lyapunov value of the profile.  This is a nonnegative
@@ -142,6 +142,28 @@ private:
   int m_numDecimals;
 };
 
+//
+// Passes on profiles computed on a game obtained by
+// StrategySupportProfile::Restrict() to another renderer, as profiles
+// on the game it was restricted from.
+//
+template <class T>
+class UnrestrictedStrategyRenderer : public StrategyProfileRenderer<T> {
+public:
+  UnrestrictedStrategyRenderer(shared_ptr<StrategyProfileRenderer<T> > p_renderer)
+    : m_renderer(p_renderer) { }
+  virtual ~UnrestrictedStrategyRenderer() { }
+  virtual void Render(const MixedStrategyProfile<T> &p_profile,
+		      const std::string &p_label = "NE") const
+  { m_renderer->Render(p_profile.Unrestrict(), p_label); }
+  virtual void Render(const MixedBehaviorProfile<T> &p_profile,
+		      const std::string &p_label = "NE") const
+  { Render(p_profile.ToMixedProfile(), p_label); }
+
+private:
+  shared_ptr<StrategyProfileRenderer<T> > m_renderer;
+};
+
 //------------------------------------------------------------------------
 //                      Algorithm base classes
 //------------------------------------------------------------------------
@@ -186,23 +208,26 @@ protected:
   shared_ptr<StrategySolver<T> > m_solver;
 };
 
+//
+// Computes subgame perfect equilibria by solving each subgame with
+// another solver, working up from the deepest subgames.  Up to
+// p_threads subgames at the same depth are solved concurrently, which
+// requires that the solver can be used from several threads at once.
+// Subgames which are the same game, once their own subgames are
+// replaced by the values of their equilibria, are solved only once.
+//
 template <class T> class SubgameBehavSolver : public BehavSolver<T> {
 public:
   SubgameBehavSolver(shared_ptr<BehavSolver<T> > p_solver,
-		     shared_ptr<StrategyProfileRenderer<T> > p_onEquilibrium = 0);
+		     shared_ptr<StrategyProfileRenderer<T> > p_onEquilibrium = 0,
+		     int p_threads = 1);
   virtual ~SubgameBehavSolver()  { }
 
   virtual List<MixedBehaviorProfile<T> > Solve(const BehaviorSupportProfile &) const;
 
 protected:
   shared_ptr<BehavSolver<T> > m_solver;
-
-private:
-  void SolveSubgames(const BehaviorSupportProfile &p_support,
-		     const DVector<T> &p_templateSolution,
-		     GameNode n,
-		     List<DVector<T> > &solns,
-		     List<GameOutcome> &values) const;
+  int m_threads;
 };
 
 //
@@ -65,8 +65,12 @@ private:
 
 template <class T> class EnumMixedStrategySolver : public StrategySolver<T> {
 public:
-  EnumMixedStrategySolver(shared_ptr<StrategyProfileRenderer<T> > p_onEquilibrium = 0)
-    : StrategySolver<T>(p_onEquilibrium) {}
+  /// If p_dense is set, the floating-point solver enumerates vertices
+  /// pivoting on explicit dense tableaux instead of updating LU
+  /// decompositions of the bases.
+  EnumMixedStrategySolver(shared_ptr<StrategyProfileRenderer<T> > p_onEquilibrium = 0,
+			  bool p_dense = false)
+    : StrategySolver<T>(p_onEquilibrium), m_dense(p_dense) {}
   virtual ~EnumMixedStrategySolver() { }
 
   shared_ptr<EnumMixedStrategySolution<T> > SolveDetailed(const Game &p_game) const;
@@ -75,6 +79,8 @@ public:
   
   
 private:
+  bool m_dense;
+
   /// Implement fuzzy equality for floating-point version when testing Nashness
   static bool EqZero(const T &x);
 };
@@ -29,6 +29,22 @@
 namespace Gambit {
 namespace Nash {
 
+/// Summary of the tracing of one perturbation ray
+class NashGNMRaySummary {
+public:
+  /// Linear steps taken along the path
+  int m_steps;
+  /// Runs of the local Newton method
+  int m_lnmCalls;
+  /// Equilibria found on the ray, including any found on other rays
+  int m_equilibria;
+  /// Wall-clock time spent tracing the ray, in seconds
+  double m_seconds;
+
+  NashGNMRaySummary(void)
+    : m_steps(0), m_lnmCalls(0), m_equilibria(0), m_seconds(0.0) { }
+};
+
 class NashGNMStrategySolver : public StrategySolver<double> {
 public:
   NashGNMStrategySolver(shared_ptr<StrategyProfileRenderer<double> > p_onEquilibrium = 0,
@@ -41,6 +57,18 @@ public:
   List<MixedStrategyProfile<double> > Solve(const Game &p_game) const;
   List<MixedStrategyProfile<double> > Solve(const Game &p_game,
 					    const MixedStrategyProfile<double> &p_pert) const;
+  /// \brief Traces each of the perturbation rays.
+  ///
+  /// Up to p_threads rays are traced concurrently, each on its own copy
+  /// of the game representation.  Equilibria are reported as they are
+  /// found, except those already found on another ray.  In verbose mode,
+  /// or for action graph games, the rays are traced one at a time.
+  /// Returns the distinct equilibria found; if p_summaries is not null,
+  /// it is set to the summaries of the rays, in the order given.
+  List<MixedStrategyProfile<double> > 
+  Solve(const Game &p_game,
+	const List<MixedStrategyProfile<double> > &p_perts,
+	int p_threads = 1, List<NashGNMRaySummary> *p_summaries = 0) const;
 
 private:
   bool m_verbose;
@@ -48,6 +76,12 @@ private:
   List<MixedStrategyProfile<double> > Solve(const Game &p_game,
 					    shared_ptr<gametracer::gnmgame> A,
 					    const gametracer::cvector &p_pert) const;
+  /// Traces a single normalized ray, without reporting the equilibria
+  List<MixedStrategyProfile<double> > TraceRay(const Game &p_game,
+					       gametracer::gnmgame &A,
+					       gametracer::GNMWorkspace &p_workspace,
+					       const gametracer::cvector &p_pert,
+					       NashGNMRaySummary &p_summary) const;
   shared_ptr<gametracer::gnmgame> BuildRepresentation(const Game &p_game) const;
 
   static MixedStrategyProfile<double> ToProfile(const Game &p_game,
@@ -36,16 +36,26 @@ namespace Nash {
  
 template <class T> class NashLcpStrategySolver : public StrategySolver<T> {
 public:
+  /// When following paths from every equilibrium found (that is,
+  /// unless p_stopAfter is 1), up to p_threads paths are followed at
+  /// once; equilibria are then reported in the order they are found.
+  /// If p_dense is set, the floating-point solver pivots on explicit
+  /// dense tableaux instead of updating LU decompositions of the bases
+  /// (see Tableau<double>::SetDense()); this is usually much faster on
+  /// games with dense payoff matrices.
   NashLcpStrategySolver(int p_stopAfter, int p_maxDepth,
-			Gambit::shared_ptr<StrategyProfileRenderer<T> > p_onEquilibrium = 0)
+			Gambit::shared_ptr<StrategyProfileRenderer<T> > p_onEquilibrium = 0,
+			int p_threads = 1, bool p_dense = false)
     : StrategySolver<T>(p_onEquilibrium),
-      m_stopAfter(p_stopAfter), m_maxDepth(p_maxDepth) { }
+      m_stopAfter(p_stopAfter), m_maxDepth(p_maxDepth), 
+      m_threads(p_threads), m_dense(p_dense) { }
   virtual ~NashLcpStrategySolver()  { }
 
   virtual List<MixedStrategyProfile<T> > Solve(const Game &) const;
 
 private:
-  int m_stopAfter, m_maxDepth;
+  int m_stopAfter, m_maxDepth, m_threads;
+  bool m_dense;
 
   class Solution;
 
@@ -27,6 +27,27 @@
 
 namespace Gambit {
 namespace Nash {
+
+/// Summary of one run of simplicial subdivision from a starting point
+class NashSimpdivRunSummary {
+public:
+  /// Factor by which the grid is refined at each step
+  int m_gridResize;
+  /// Grids on which the algorithm ran to completion
+  int m_grids;
+  /// Grid points labeled, and how many of those labels were computed exactly
+  int m_labels, m_exactLabels;
+  /// Moves from one simplex to an adjacent one
+  int m_pivots;
+  /// Whether the run reached an approximate equilibrium before being stopped
+  bool m_converged;
+  /// Wall-clock time spent on the run, in seconds
+  double m_seconds;
+
+  NashSimpdivRunSummary(void)
+    : m_gridResize(0), m_grids(0), m_labels(0), m_exactLabels(0),
+      m_pivots(0), m_converged(false), m_seconds(0.0) { }
+};
   
 ///
 /// This is a simplicial subdivision algorithm with restart, for finding
@@ -37,40 +58,98 @@ class NashSimpdivStrategySolver : public StrategySolver<Rational> {
 public:
   NashSimpdivStrategySolver(int p_gridResize = 2, int p_leashLength = 0,
 			    bool p_verbose = false,
-			    shared_ptr<StrategyProfileRenderer<Rational> > p_onEquilibrium = 0)
+			    shared_ptr<StrategyProfileRenderer<Rational> > p_onEquilibrium = 0,
+			    bool p_fastLabels = false)
     : StrategySolver<Rational>(p_onEquilibrium),
       m_gridResize(p_gridResize),
       m_leashLength((p_leashLength > 0) ? p_leashLength : 32000),
-      m_verbose(p_verbose)
+      m_verbose(p_verbose), m_fastLabels(p_fastLabels)
   { }
   virtual ~NashSimpdivStrategySolver() { }
 
   List<MixedStrategyProfile<Rational> > Solve(const MixedStrategyProfile<Rational> &p_start) const;
   List<MixedStrategyProfile<Rational> > Solve(const Game &p_game) const;
+  /// \brief Runs the algorithm from each starting point with each
+  /// refinement factor.
+  ///
+  /// Up to p_threads runs proceed concurrently.  Equilibria are reported
+  /// as they are found, except those already found by another run.
+  /// Runs still in progress are stopped, and those not yet started are
+  /// skipped, once p_stopAfter equilibria have been found or p_maxSeconds
+  /// have elapsed; either limit is ignored if not positive.  In verbose
+  /// mode, or for action graph games, runs are done one at a time.
+  /// Returns the distinct equilibria found; if p_summaries is not null,
+  /// it is set to the summaries of the runs, ordered by starting point
+  /// and then by refinement factor.
+  List<MixedStrategyProfile<Rational> >
+  Solve(const List<MixedStrategyProfile<Rational> > &p_starts,
+	const Array<int> &p_gridResizes, int p_threads = 1,
+	int p_stopAfter = 0, double p_maxSeconds = 0.0,
+	List<NashSimpdivRunSummary> *p_summaries = 0) const;
 
 
 private:
   int m_gridResize, m_leashLength;
-  bool m_verbose;
+  bool m_verbose, m_fastLabels;
+
+  /// Tracks one run, and decides whether it should stop early
+  class RunControl {
+  public:
+    NashSimpdivRunSummary &m_summary;
+    /// Set to nonzero, possibly by another thread, to stop the run
+    const int *m_cancel;
+    /// Wall-clock time at which to stop the run, or zero for no limit
+    double m_deadline;
+    bool m_stopped;
+
+    RunControl(NashSimpdivRunSummary &p_summary, const int *p_cancel = 0,
+	       double p_deadline = 0.0)
+      : m_summary(p_summary), m_cancel(p_cancel), m_deadline(p_deadline),
+	m_stopped(false) { }
+    bool Stop(void);
+  };
 
+  ///
+  /// The points visited by the algorithm all lie on a grid with a common
+  /// denominator D; they are stored as integer numerators over D, with T
+  /// being either long or, once D outgrows a machine word, Integer.
+  /// When fast labeling is enabled, labels are computed in floating point,
+  /// and only recomputed exactly when a comparison is too close to call
+  /// given rounding error.
+  ///
   class State {
   public:
     int t, ibar;
-    Rational d, pay, maxz, bestz;
+    Integer D;
+    Rational bestz;
+    bool useDouble, bestzExact;
+    double tol, bestzApprox;
+    int exactLabels;
+    MixedStrategyProfile<Rational> exact;
+    MixedStrategyProfile<double> approx;
     
-    State(void) : t(0), ibar(1), bestz(1.0e30) { }
-    Rational getlabel(MixedStrategyProfile<Rational> &yy, Array<int> &, 
-		      PVector<Rational> &);
+    State(const Game &p_game, const Integer &p_D, bool p_useDouble);
+    template <class T> 
+    void getlabel(const PVector<T> &yy, Array<int> &, PVector<T> &);
+    template <class T> 
+    Rational getlabelExact(const PVector<T> &yy, Array<int> &);
+    template <class T> bool getlabelApprox(const PVector<T> &yy, Array<int> &,
+					   double &);
   };
 
-  Rational Simplex(MixedStrategyProfile<Rational> &, const Rational &d) const;
-  void update(State &, RectArray<int> &, RectArray<int> &, PVector<Rational> &,
+  bool Run(MixedStrategyProfile<Rational> &, int p_gridResize,
+	   RunControl &) const;
+  template <class T>
+  Rational Simplex(MixedStrategyProfile<Rational> &, const Integer &D,
+		   RunControl &) const;
+  void update(State &, RectArray<int> &, RectArray<int> &, PVector<int> &,
 	      const PVector<int> &, int j, int i) const;
-  void getY(State &, MixedStrategyProfile<Rational> &x, PVector<Rational> &, 
+  template <class T>
+  void getY(State &, PVector<T> &x, const PVector<T> &, 
 	    const PVector<int> &, const PVector<int> &, 
-	    const PVector<Rational> &, const RectArray<int> &, int k) const;
-  void getnexty(State &, 
-		MixedStrategyProfile<Rational> &x, const RectArray<int> &,
+	    const PVector<int> &, const RectArray<int> &, int k) const;
+  template <class T>
+  void getnexty(State &, PVector<T> &x, const RectArray<int> &,
 		const PVector<int> &, int i) const;
   int get_c(int j, int h, int nstrats, const PVector<int> &) const;
   int get_b(int j, int h, int nstrats, const PVector<int> &) const;
@@ -25,34 +25,66 @@
 
 namespace Gambit {
 
-/// This simple class stores a numerical datum.
+/// \brief This simple class stores a numerical datum.
+///
+/// A number is given as text, which is interpreted as a rational number.
+/// Integers, decimals and fractions whose numerator and denominator fit
+/// in machine words are held inline as a small fixed-width rational,
+/// from which the original text can be reproduced exactly; the
+/// arbitrary-precision Rational and the text are created only when
+/// asked for.  Other numbers keep their text and Rational representation.
+///
+/// The double-precision value is always available without any
+/// allocation.  Because the other representations are created lazily,
+/// concurrent conversions of the same number to Rational or to text
+/// must be serialized by the caller, or preceded by BuildExtended().
 class Number {
 private:
-  std::string m_text;
-  Rational m_rational;
+  /// Representations created on demand
+  struct Extended {
+    std::string m_text;
+    Rational m_rational;
+    bool m_hasText, m_hasRational;
+
+    Extended(void) : m_hasText(false), m_hasRational(false) { }
+  };
+
+  enum { NUMBER_GENERAL = 0, NUMBER_FRACTION = 1, NUMBER_DECIMAL = 2 };
+
   double m_double;
+  /// Numerator; for decimals, all digits of the number
+  long m_num;
+  /// Denominator; for decimals, ten to the power m_places
+  unsigned int m_den;
+  unsigned char m_kind, m_places;
+  mutable Extended *m_extended;
+
+  /// Interprets the text as a small rational, if possible
+  bool ParseSmall(const std::string &);
+  void ComputeDouble(void);
+  Extended *GetExtended(void) const;
 
 public:
   Number(void)
-    : m_text("0"), m_rational(0), m_double(0.0) { }
-  Number(const std::string &p_text)
-    : m_text(p_text), m_rational(lexical_cast<Rational>(p_text)), 
-      m_double((double) m_rational)
-  { }
+    : m_double(0.0), m_num(0), m_den(1), m_kind(NUMBER_DECIMAL), m_places(0),
+      m_extended(0) { }
+  Number(const std::string &p_text);
+  Number(const Number &);
+  ~Number() { delete m_extended; }
   
-  Number &operator=(const std::string &p_text)
-  {
-    // We call lexical_cast<Rational>() first because it throws a ValueException
-    // if the conversion of the text fails
-    m_rational = lexical_cast<Rational>(p_text);
-    m_text = p_text;
-    m_double = (double) m_rational;
-    return *this; 
-  }
+  Number &operator=(const Number &);
+  Number &operator=(const std::string &p_text);
 
   operator const double &(void) const { return m_double; }
-  operator const Rational &(void) const { return m_rational; }
-  operator const std::string &(void) const { return m_text; }
+  operator const Rational &(void) const;
+  operator const std::string &(void) const;
+
+  /// Returns true if the double value is known to equal the number exactly
+  bool IsExactDouble(void) const
+  { return m_kind != NUMBER_GENERAL && m_den == 1; }
+  /// Creates the Rational and text representations, after which
+  /// conversions of the number only read it
+  void BuildExtended(void) const;
 };
 
 }
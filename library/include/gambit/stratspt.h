@@ -45,6 +45,7 @@ class StrategySupportProfile {
   template <class T> friend class MixedStrategyProfileRep;
   template <class T> friend class AggMixedStrategyProfileRep;
   template <class T> friend class BagentMixedStrategyProfileRep;
+  template <class T> friend class TableMixedStrategyProfileRep;
 protected:
   Game m_nfg;
   Array<Array<GameStrategy> > m_support;
@@ -140,6 +141,26 @@ public:
   /// Returns a copy of the support with dominated strategies eliminated
   StrategySupportProfile Undominated(bool p_strict, bool p_external = false) const;
   StrategySupportProfile Undominated(bool strong, const Array<int> &players) const;
+  /// \brief Returns a copy of the support with dominated strategies 
+  /// eliminated iteratively.
+  ///
+  /// Returns the support reached by eliminating the dominated strategies
+  /// of all players until none remain, with the same result as applying
+  /// Undominated() until the support no longer changes.  The payoffs are
+  /// read once, and after each round only the comparisons which may
+  /// have changed are repeated.
+  StrategySupportProfile IteratedUndominated(bool p_strict) const;
+  /// \brief Returns a copy of the support with strategies strictly
+  /// dominated by mixed strategies eliminated.
+  ///
+  /// A strategy is eliminated if some mixture of the player's other
+  /// strategies in the support gives a higher payoff against every
+  /// contingency of the other players, which is found by solving one
+  /// linear program for each strategy.  Up to p_threads strategies of a
+  /// player are considered at once.  If p_iterated is set, elimination
+  /// continues until no such strategies remain.
+  StrategySupportProfile MixedUndominated(bool p_iterated = false,
+					  int p_threads = 1) const;
   //@}
 
   /// @name Identification of overwhelmed strategies
@@ -118,8 +118,8 @@ EnumMixedStrategySolver<T>::SolveDetailed(const Game &p_game) const
   b2 = (T) -1;
 
   // enumerate vertices of A1 x + b1 <= 0 and A2 x + b2 <= 0
-  VertexEnumerator<T> poly1(A1, b1);
-  VertexEnumerator<T> poly2(A2, b2);
+  VertexEnumerator<T> poly1(A1, b1, m_dense);
+  VertexEnumerator<T> poly2(A2, b2, m_dense);
 
   const List<BFS<T> > &verts1(poly1.VertexList());
   const List<BFS<T> > &verts2(poly2.VertexList());
@@ -23,12 +23,14 @@
 #include <cstdlib>
 #include <cctype>
 #include <iostream>
+#include <fstream>
 #include <sstream>
 #include <map>
 
 #include "gambit/gambit.h"
 // for explicit access to turning off canonicalization
 #include "gambit/gametree.h"
+#include "gambit/gametable.h"
   
 
 namespace {
@@ -631,7 +633,9 @@ Game BuildNfg(GameParserState &p_parser, TableFileGame &p_data)
     dim[pl] = p_data.NumStrategies(pl);
   }
 
-  GameRep *nfg = NewTable(dim);
+  // Files in outcome format list their own outcomes, so there is no
+  // need to create an outcome for each contingency
+  GameRep *nfg = NewTable(dim, p_parser.GetCurrentToken() == TOKEN_LBRACE);
   // Assigning this to the container assures that, if something goes
   // wrong, the class will automatically be cleaned up
   Game game = nfg;
@@ -1055,6 +1059,14 @@ Game ReadGame(std::istream &p_file) throw (InvalidFileException)
 {
   std::stringstream buffer;
   buffer << p_file.rdbuf();
+  if (GameTableRep::IsBinaryFile(buffer.str().substr(0, 8))) {
+    try {
+      return GameTableRep::ReadBinaryFile(buffer.str());
+    }
+    catch (std::exception &ex) {
+      throw InvalidFileException(ex.what());
+    }
+  }
   try {
     GameXMLSavefile doc(buffer.str());
     return doc.GetGame();
@@ -1097,4 +1109,25 @@ Game ReadGame(std::istream &p_file) throw (InvalidFileException)
   }
 }
 
+Game ReadGameFile(const std::string &p_filename) throw (InvalidFileException)
+{
+  std::ifstream file(p_filename.c_str(), std::ios::in | std::ios::binary);
+  if (!file.is_open()) {
+    throw InvalidFileException("Unable to open file " + p_filename);
+  }
+  char header[8];
+  if (file.read(header, 8) && 
+      GameTableRep::IsBinaryFile(std::string(header, 8))) {
+    try {
+      return GameTableRep::MapBinaryFile(p_filename);
+    }
+    catch (std::exception &ex) {
+      throw InvalidFileException(ex.what());
+    }
+  }
+  file.clear();
+  file.seekg(0, std::ios::beg);
+  return ReadGame(file);
+}
+
 } // end namespace Gambit
@@ -22,6 +22,7 @@
 
 #include <iostream>
 #include <sstream>
+#include <limits>
 
 #include "gambit/gambit.h"
 #include "gambit/gametree.h"
@@ -79,6 +80,7 @@ GamePlayerRep::~GamePlayerRep()
 GameStrategy GamePlayerRep::NewStrategy(void)
 {
   if (m_game->IsTree())  throw UndefinedException();
+  dynamic_cast<GameTableRep *>(m_game)->PrepareNewStrategy(m_number);
 
   GameStrategyRep *strategy = new GameStrategyRep(this);
   m_strategies.Append(strategy);
@@ -557,12 +559,16 @@ GameStrategy GameExplicitRep::GetStrategy(int p_index) const
   throw IndexException();
 }
 
-int GameExplicitRep::NumStrategyContingencies(void) const
+long GameExplicitRep::NumStrategyContingencies(void) const
 {
   const_cast<GameExplicitRep *>(this)->BuildComputedValues();
-  int ncont = 1;
+  long ncont = 1L;
   for (int pl = 1; pl <= m_players.Length(); pl++) {
-    ncont *= m_players[pl]->m_strategies.Length();
+    int dim = m_players[pl]->m_strategies.Length();
+    if (dim > 0 && ncont > std::numeric_limits<long>::max() / dim) {
+      throw TableTooLargeException("Game has too many contingencies to index");
+    }
+    ncont *= dim;
   }
   return ncont;
 }
@@ -587,6 +593,22 @@ GameOutcome GameExplicitRep::NewOutcome(void)
   return m_outcomes[m_outcomes.Last()];
 }
 
+//------------------------------------------------------------------------
+//                  GameExplicitRep: Concurrent access
+//------------------------------------------------------------------------
+
+bool GameExplicitRep::PrepareConcurrentAccess(void)
+{
+  GameRep::PrepareConcurrentAccess();
+  for (int outc = 1; outc <= m_outcomes.Length(); outc++) {
+    const Array<Number> &payoffs = m_outcomes[outc]->m_payoffs;
+    for (int pl = 1; pl <= payoffs.Length(); pl++) {
+      payoffs[pl].BuildExtended();
+    }
+  }
+  return true;
+}
+
 //------------------------------------------------------------------------
 //                GameExplicitRep: Writing data files
 //------------------------------------------------------------------------
@@ -602,6 +624,9 @@ void GameExplicitRep::Write(std::ostream &p_stream,
 	   (p_format == "native" && !IsTree())) {
     WriteNfgFile(p_stream);
   }
+  else if (p_format == "nfgbin") {
+    GameTableRep::WriteBinaryFile(p_stream, const_cast<GameExplicitRep *>(this));
+  }
   else {
     throw UndefinedException();
   }
@@ -21,13 +21,273 @@
 //
 
 #include <iostream>
+#include <fstream>
 #include <sstream>
+#include <iomanip>
+#include <algorithm>
+#include <limits>
+#include <cstring>
+#include <unistd.h>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif  // _WIN32
 
 #include "gambit/gambit.h"
 #include "gambit/gametable.h"
 
 namespace Gambit {
 
+//========================================================================
+//                        class BinaryTableData
+//========================================================================
+
+namespace {
+
+const char BINARY_MAGIC[] = "GAMBITNB";
+const unsigned int BINARY_VERSION = 1;
+const unsigned int BINARY_INT32 = 1;
+const unsigned int BINARY_FLOAT64 = 2;
+
+bool IsLittleEndian(void)
+{
+  const unsigned short one = 1;
+  return *reinterpret_cast<const unsigned char *>(&one) == 1;
+}
+
+unsigned int ReadUInt32(const unsigned char *p)
+{
+  return ((unsigned int) p[0] | ((unsigned int) p[1] << 8) |
+	  ((unsigned int) p[2] << 16) | ((unsigned int) p[3] << 24));
+}
+
+void WriteUInt32(std::ostream &p_stream, unsigned int p_value)
+{
+  for (int i = 0; i < 4; i++) {
+    p_stream.put((char) ((p_value >> (8 * i)) & 0xff));
+  }
+}
+
+/// Copies the little-endian value at p_bytes into the native value
+template <class T> T ReadValue(const unsigned char *p_bytes)
+{
+  unsigned char native[sizeof(T)];
+  if (IsLittleEndian()) {
+    memcpy(native, p_bytes, sizeof(T));
+  }
+  else {
+    std::reverse_copy(p_bytes, p_bytes + sizeof(T), native);
+  }
+  T value;
+  memcpy(&value, native, sizeof(T));
+  return value;
+}
+
+template <class T> void WriteValue(std::ostream &p_stream, T p_value)
+{
+  unsigned char bytes[sizeof(T)];
+  memcpy(bytes, &p_value, sizeof(T));
+  if (!IsLittleEndian()) {
+    std::reverse(bytes, bytes + sizeof(T));
+  }
+  p_stream.write(reinterpret_cast<const char *>(bytes), sizeof(T));
+}
+
+} // end anonymous namespace
+
+/// The header and payoffs of a game in binary table format, either
+/// mapped from a file or held in memory.
+class BinaryTableData {
+private:
+  void *m_map;
+  size_t m_mapLength;
+  std::vector<double> m_buffer;
+  const unsigned char *m_data;
+  size_t m_length;
+
+  Array<int> m_dim;
+  unsigned int m_type;
+  long m_numContingencies;
+  const unsigned char *m_payoffs;
+
+  /// Checks and decodes the header
+  void ParseHeader(void);
+
+public:
+  /// Map the file read-only, or read it where mapping is not supported
+  BinaryTableData(const std::string &p_filename);
+  /// Take a copy of the contents of a file
+  BinaryTableData(const char *p_contents, size_t p_length);
+  ~BinaryTableData();
+
+  const Array<int> &NumStrategies(void) const { return m_dim; }
+  long NumContingencies(void) const { return m_numContingencies; }
+
+  /// Returns the payoff to player pl at contingency p_index (from zero)
+  double GetPayoff(int pl, long p_index) const
+  {
+    const unsigned char *entry = m_payoffs + 
+      ((pl - 1) * m_numContingencies + p_index) * ((m_type == BINARY_INT32) ? 4 : 8);
+    if (m_type == BINARY_INT32) {
+      return (double) ReadValue<int>(entry);
+    }
+    return ReadValue<double>(entry);
+  }
+  /// Returns the payoff as an exact rational number
+  Rational GetRationalPayoff(int pl, long p_index) const
+  {
+    const unsigned char *entry = m_payoffs + 
+      ((pl - 1) * m_numContingencies + p_index) * ((m_type == BINARY_INT32) ? 4 : 8);
+    if (m_type == BINARY_INT32) {
+      return Rational(ReadValue<int>(entry));
+    }
+    return Rational(ReadValue<double>(entry));
+  }
+  /// Returns the text representation of a payoff
+  std::string GetPayoffText(int pl, long p_index) const;
+
+  /// \brief Returns the payoffs to player pl in place, if possible.
+  ///
+  /// Returns a pointer to the payoffs of the player if they are stored
+  /// as native doubles, and null otherwise.
+  const double *GetDoublePayoffs(int pl) const
+  {
+    if (m_type != BINARY_FLOAT64 || !IsLittleEndian()) return 0;
+    return reinterpret_cast<const double *>(m_payoffs) + (pl - 1) * m_numContingencies;
+  }
+};
+
+BinaryTableData::BinaryTableData(const std::string &p_filename)
+  : m_map(0), m_mapLength(0), m_data(0), m_length(0)
+{
+#ifndef _WIN32
+  int fd = open(p_filename.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw InvalidFileException("Unable to open file " + p_filename);
+  }
+  struct stat info;
+  if (fstat(fd, &info) != 0 || info.st_size == 0) {
+    close(fd);
+    throw InvalidFileException("Unable to read file " + p_filename);
+  }
+  void *map = mmap(0, info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (map == MAP_FAILED) {
+    throw InvalidFileException("Unable to map file " + p_filename);
+  }
+  m_map = map;
+  m_mapLength = m_length = info.st_size;
+  m_data = static_cast<const unsigned char *>(map);
+#else
+  std::ifstream file(p_filename.c_str(), std::ios::in | std::ios::binary);
+  if (!file.is_open()) {
+    throw InvalidFileException("Unable to open file " + p_filename);
+  }
+  std::stringstream contents;
+  contents << file.rdbuf();
+  std::string data = contents.str();
+  // A vector of doubles guarantees the payoffs are suitably aligned
+  m_buffer.resize(data.size() / sizeof(double) + 1);
+  memcpy(&m_buffer[0], data.data(), data.size());
+  m_data = reinterpret_cast<const unsigned char *>(&m_buffer[0]);
+  m_length = data.size();
+#endif  // _WIN32
+  try {
+    ParseHeader();
+  }
+  catch (...) {
+#ifndef _WIN32
+    munmap(m_map, m_mapLength);
+#endif  // _WIN32
+    throw;
+  }
+}
+
+BinaryTableData::BinaryTableData(const char *p_contents, size_t p_length)
+  : m_map(0), m_mapLength(0), 
+    m_buffer(p_length / sizeof(double) + 1), m_length(p_length)
+{
+  // A vector of doubles guarantees the payoffs are suitably aligned
+  memcpy(&m_buffer[0], p_contents, p_length);
+  m_data = reinterpret_cast<const unsigned char *>(&m_buffer[0]);
+  ParseHeader();
+}
+
+BinaryTableData::~BinaryTableData()
+{
+#ifndef _WIN32
+  if (m_map) {
+    munmap(m_map, m_mapLength);
+  }
+#endif  // _WIN32
+}
+
+void BinaryTableData::ParseHeader(void)
+{
+  if (m_length < 20 || memcmp(m_data, BINARY_MAGIC, 8) != 0) {
+    throw InvalidFileException("Not a binary table file");
+  }
+  if (ReadUInt32(m_data + 8) != BINARY_VERSION) {
+    throw InvalidFileException("Unsupported binary table file version");
+  }
+  m_type = ReadUInt32(m_data + 12);
+  if (m_type != BINARY_INT32 && m_type != BINARY_FLOAT64) {
+    throw InvalidFileException("Unsupported payoff type in binary table file");
+  }
+  unsigned int numPlayers = ReadUInt32(m_data + 16);
+  size_t header = 20 + 4 * (size_t) numPlayers;
+  if (numPlayers == 0 || m_length < header) {
+    throw InvalidFileException("Invalid header in binary table file");
+  }
+  header = (header + 7) / 8 * 8;
+
+  m_dim = Array<int>(numPlayers);
+  double size = 1.0;
+  m_numContingencies = 1L;
+  for (unsigned int pl = 1; pl <= numPlayers; pl++) {
+    unsigned int dim = ReadUInt32(m_data + 20 + 4 * (pl - 1));
+    if (dim == 0 || dim > (unsigned int) std::numeric_limits<int>::max()) {
+      throw InvalidFileException("Invalid number of strategies in binary table file");
+    }
+    m_dim[pl] = dim;
+    size *= (double) dim;
+    if (size > (double) std::numeric_limits<long>::max()) {
+      throw TableTooLargeException("Game table has too many contingencies to index");
+    }
+    m_numContingencies *= dim;
+  }
+
+  double payload = size * numPlayers * ((m_type == BINARY_INT32) ? 4 : 8);
+  if (m_length < header || (double) (m_length - header) < payload) {
+    throw InvalidFileException("Binary table file is truncated");
+  }
+  m_payoffs = m_data + header;
+}
+
+namespace {
+
+void GetBinaryPayoff(const BinaryTableData &p_data, int pl, long p_index,
+		     double &p_value)
+{ p_value = p_data.GetPayoff(pl, p_index); }
+
+void GetBinaryPayoff(const BinaryTableData &p_data, int pl, long p_index,
+		     Rational &p_value)
+{ p_value = p_data.GetRationalPayoff(pl, p_index); }
+
+} // end anonymous namespace
+
+std::string BinaryTableData::GetPayoffText(int pl, long p_index) const
+{
+  if (m_type == BINARY_INT32) {
+    return lexical_cast<std::string>((int) GetPayoff(pl, p_index));
+  }
+  std::ostringstream s;
+  // Enough digits to recover the double exactly
+  s << std::setprecision(17) << GetPayoff(pl, p_index);
+  return s.str();
+}
+
 //========================================================================
 //                  class TablePureStrategyProfileRep
 //========================================================================
@@ -82,17 +342,29 @@ void TablePureStrategyProfileRep::SetStrategy(const GameStrategy &s)
 
 GameOutcome TablePureStrategyProfileRep::GetOutcome(void) const
 { 
-  return dynamic_cast<GameTableRep &>(*m_nfg).m_results[m_index]; 
+  GameTableRep &game = dynamic_cast<GameTableRep &>(*m_nfg);
+  if (game.m_binary) {
+    // The payoffs are in the binary table; there are no outcomes
+    throw UndefinedException();
+  }
+  return game.m_results[m_index - 1]; 
 }
 
 void TablePureStrategyProfileRep::SetOutcome(GameOutcome p_outcome)
 {
-  dynamic_cast<GameTableRep &>(*m_nfg).m_results[m_index] = p_outcome; 
+  GameTableRep &game = dynamic_cast<GameTableRep &>(*m_nfg);
+  game.Materialize();
+  game.m_results[m_index - 1] = p_outcome; 
+  game.ClearPayoffCache();
 }
 
 Rational TablePureStrategyProfileRep::GetPayoff(int pl) const
 {
-  GameOutcomeRep *outcome = dynamic_cast<GameTableRep &>(*m_nfg).m_results[m_index];
+  GameTableRep &game = dynamic_cast<GameTableRep &>(*m_nfg);
+  if (game.m_binary) {
+    return game.m_binary->GetRationalPayoff(pl, m_index - 1);
+  }
+  GameOutcomeRep *outcome = game.m_results[m_index - 1];
   if (outcome) {
     return outcome->GetPayoff<Rational>(pl);
   }
@@ -105,7 +377,12 @@ Rational
 TablePureStrategyProfileRep::GetStrategyValue(const GameStrategy &p_strategy) const
 {
   int player = p_strategy->GetPlayer()->GetNumber();
-  GameOutcomeRep *outcome = dynamic_cast<GameTableRep &>(*m_nfg).m_results[m_index - m_profile[player]->m_offset + p_strategy->m_offset];
+  GameTableRep &game = dynamic_cast<GameTableRep &>(*m_nfg);
+  long index = m_index - 1 - m_profile[player]->m_offset + p_strategy->m_offset;
+  if (game.m_binary) {
+    return game.m_binary->GetRationalPayoff(player, index);
+  }
+  GameOutcomeRep *outcome = game.m_results[index];
   if (outcome) {
     return outcome->GetPayoff<Rational>(player);
   }
@@ -127,21 +404,73 @@ PureStrategyProfile GameTableRep::NewPureStrategyProfile(void) const
 
 namespace {
 /// This convenience function computes the Cartesian product of the
-/// elements in dim.
-int Product(const Array<int> &dim)
+/// elements in dim.  It returns -1 if the product does not fit in a long.
+long Product(const Array<int> &dim)
 {
-  int accum = 1;
-  for (int i = 1; i <= dim.Length(); accum *= dim[i++]);
+  long accum = 1L;
+  for (int i = 1; i <= dim.Length(); i++) {
+    if (dim[i] > 0 && accum > std::numeric_limits<long>::max() / dim[i]) {
+      return -1L;
+    }
+    accum *= dim[i];
+  }
   return accum;
 }
 
+/// Returns the physical memory of the machine in bytes, or zero if
+/// this cannot be determined.
+double PhysicalMemory(void)
+{
+#if defined(_SC_PHYS_PAGES) && defined(_SC_PAGESIZE)
+  long pages = sysconf(_SC_PHYS_PAGES), pageSize = sysconf(_SC_PAGESIZE);
+  if (pages > 0 && pageSize > 0) {
+    return (double) pages * (double) pageSize;
+  }
+#endif  // _SC_PHYS_PAGES && _SC_PAGESIZE
+  return 0.0;
+}
+
 } // end anonymous namespace
 
+double GameTableRep::EstimateMemory(const Array<int> &p_dim,
+				    bool p_sparseOutcomes /* = false */)
+{
+  double ncont = 1.0;
+  for (int pl = 1; pl <= p_dim.Length(); pl++) {
+    ncont *= (double) p_dim[pl];
+  }
+  double perContingency = sizeof(GameOutcomeRep *) + 
+    p_dim.Length() * sizeof(double);
+  if (!p_sparseOutcomes) {
+    perContingency += sizeof(GameOutcomeRep) + sizeof(GameOutcomeRep *) +
+      p_dim.Length() * sizeof(Number);
+  }
+  return ncont * perContingency;
+}
   
 GameTableRep::GameTableRep(const Array<int> &dim, 
 			   bool p_sparseOutcomes /* = false */)
+  : m_binary(0), m_exactDoubles(-1)
 {
-  m_results = Array<GameOutcomeRep *>(Product(dim));
+  long ncont = Product(dim);
+  double memory = EstimateMemory(dim, p_sparseOutcomes);
+  double available = PhysicalMemory();
+  if (ncont < 0 || (unsigned long) ncont > m_results.max_size() ||
+      (!p_sparseOutcomes && ncont > std::numeric_limits<int>::max()) ||
+      (available > 0.0 && memory > available)) {
+    double count = 1.0;
+    for (int pl = 1; pl <= dim.Length(); count *= (double) dim[pl++]);
+    std::ostringstream msg;
+    msg << "Game table with " << count 
+	<< " contingencies would require about " 
+	<< memory / 1048576.0 << " MB";
+    if (available > 0.0) {
+      msg << ", but only " << available / 1048576.0 << " MB are installed";
+    }
+    throw TableTooLargeException(msg.str());
+  }
+
+  m_results.resize(ncont);
   for (int pl = 1; pl <= dim.Length(); pl++)  {
     m_players.Append(new GamePlayerRep(this, pl, dim[pl]));
     m_players[pl]->m_label = lexical_cast<std::string>(pl);
@@ -152,18 +481,54 @@ GameTableRep::GameTableRep(const Array<int> &dim,
   IndexStrategies();
 
   if (p_sparseOutcomes) {
-    for (int cont = 1; cont <= m_results.Length();
-	 m_results[cont++] = 0);
+    std::fill(m_results.begin(), m_results.end(), (GameOutcomeRep *) 0);
   }
   else {
-    m_outcomes = Array<GameOutcomeRep *>(m_results.Length());
+    // Each contingency has its own outcome; the check above ensures
+    // these can be numbered
+    m_outcomes = Array<GameOutcomeRep *>(ncont);
     for (int i = 1; i <= m_outcomes.Length(); i++) {
       m_outcomes[i] = new GameOutcomeRep(this, i);
+      m_results[i - 1] = m_outcomes[i];
     }
-    m_results = m_outcomes;
   }
 }
 
+GameTableRep::GameTableRep(BinaryTableData *p_data)
+  : m_binary(p_data), m_exactDoubles(-1)
+{
+  const Array<int> &dim = p_data->NumStrategies();
+  for (int pl = 1; pl <= dim.Length(); pl++)  {
+    m_players.Append(new GamePlayerRep(this, pl, dim[pl]));
+    m_players[pl]->m_label = lexical_cast<std::string>(pl);
+    for (int st = 1; st <= m_players[pl]->NumStrategies(); st++) {
+      m_players[pl]->m_strategies[st]->SetLabel(lexical_cast<std::string>(st));
+    }
+  }
+  IndexStrategies();
+}
+
+GameTableRep::~GameTableRep()
+{
+  delete m_binary;
+}
+
+Game GameTableRep::MapBinaryFile(const std::string &p_filename)
+{
+  return new GameTableRep(new BinaryTableData(p_filename));
+}
+
+Game GameTableRep::ReadBinaryFile(const std::string &p_contents)
+{
+  return new GameTableRep(new BinaryTableData(p_contents.data(),
+					      p_contents.size()));
+}
+
+bool GameTableRep::IsBinaryFile(const std::string &p_header)
+{
+  return (p_header.size() >= 8 && p_header.compare(0, 8, BINARY_MAGIC) == 0);
+}
+
 Game GameTableRep::Copy(void) const
 {
   std::ostringstream os;
@@ -176,6 +541,41 @@ Game GameTableRep::Copy(void) const
 //                  GameTableRep: General data access
 //------------------------------------------------------------------------
 
+long GameTableRep::NumContingencies(void) const
+{
+  return (m_binary) ? m_binary->NumContingencies() : (long) m_results.size();
+}
+
+Rational GameTableRep::GetMinPayoff(int pl) const
+{
+  if (!m_binary) {
+    return GameExplicitRep::GetMinPayoff(pl);
+  }
+  int p1 = (pl) ? pl : 1, p2 = (pl) ? pl : NumPlayers();
+  double minpay = m_binary->GetPayoff(p1, 0);
+  for (int p = p1; p <= p2; p++) {
+    for (long i = 0; i < m_binary->NumContingencies(); i++) {
+      minpay = std::min(minpay, m_binary->GetPayoff(p, i));
+    }
+  }
+  return Rational(minpay);
+}
+
+Rational GameTableRep::GetMaxPayoff(int pl) const
+{
+  if (!m_binary) {
+    return GameExplicitRep::GetMaxPayoff(pl);
+  }
+  int p1 = (pl) ? pl : 1, p2 = (pl) ? pl : NumPlayers();
+  double maxpay = m_binary->GetPayoff(p1, 0);
+  for (int p = p1; p <= p2; p++) {
+    for (long i = 0; i < m_binary->NumContingencies(); i++) {
+      maxpay = std::max(maxpay, m_binary->GetPayoff(p, i));
+    }
+  }
+  return Rational(maxpay);
+}
+
 bool GameTableRep::IsConstSum(void) const
 {
   TablePureStrategyProfileRep profile(const_cast<GameTableRep *>(this));
@@ -231,6 +631,12 @@ std::string EscapeQuotes(const std::string &s)
 ///  
 void GameTableRep::WriteNfgFile(std::ostream &p_file) const
 { 
+  if (m_binary) {
+    // There is no outcome structure to preserve
+    GameRep::WriteNfgFile(p_file);
+    return;
+  }
+
   p_file << "NFG 1 R";
   p_file << " \"" << EscapeQuotes(GetTitle()) << "\" { ";
 
@@ -251,11 +657,6 @@ void GameTableRep::WriteNfgFile(std::ostream &p_file) const
 
   p_file << "\"" << EscapeQuotes(m_comment) << "\"\n\n";
 
-  int ncont = 1;
-  for (int i = 1; i <= NumPlayers(); i++) {
-    ncont *= m_players[i]->m_strategies.Length();
-  }
-
   p_file << "{\n";
   for (int outc = 1; outc <= m_outcomes.Length(); outc++)   {
     p_file << "{ \"" << EscapeQuotes(m_outcomes[outc]->m_label) << "\" ";
@@ -272,7 +673,7 @@ void GameTableRep::WriteNfgFile(std::ostream &p_file) const
   }
   p_file << "}\n";
   
-  for (int cont = 1; cont <= ncont; cont++)  {
+  for (long cont = 0; cont < (long) m_results.size(); cont++)  {
     if (m_results[cont] != 0) {
       p_file << m_results[cont]->m_number << ' ';
     }
@@ -290,6 +691,7 @@ void GameTableRep::WriteNfgFile(std::ostream &p_file) const
 
 GamePlayer GameTableRep::NewPlayer(void)
 {
+  Materialize();
   GamePlayerRep *player = 0;
   player = new GamePlayerRep(this, m_players.Length() + 1, 1);
   m_players.Append(player);
@@ -297,6 +699,7 @@ GamePlayer GameTableRep::NewPlayer(void)
     m_outcomes[outc]->m_payoffs.Append(Number());
   }
   ClearComputedValues();
+  ClearPayoffCache();
   return player;
 }
 
@@ -304,18 +707,88 @@ GamePlayer GameTableRep::NewPlayer(void)
 //                        GameTableRep: Outcomes
 //------------------------------------------------------------------------
 
+GameOutcome GameTableRep::NewOutcome(void)
+{
+  Materialize();
+  return GameExplicitRep::NewOutcome();
+}
+
 void GameTableRep::DeleteOutcome(const GameOutcome &p_outcome)
 {
-  for (int i = 1; i <= m_results.Length(); i++) {
-    if (m_results[i] == p_outcome) {
-      m_results[i] = 0;
-    }
-  }
+  Materialize();
+  std::replace(m_results.begin(), m_results.end(), 
+	       (GameOutcomeRep *) p_outcome, (GameOutcomeRep *) 0);
   m_outcomes.Remove(m_outcomes.Find(p_outcome))->Invalidate();
   for (int outc = 1; outc <= m_outcomes.Length(); outc++) {
     m_outcomes[outc]->m_number = outc;
   }
   ClearComputedValues();
+  ClearPayoffCache();
+}
+
+//------------------------------------------------------------------------
+//                   GameTableRep: Packed payoff tables
+//------------------------------------------------------------------------
+
+bool GameTableRep::PrepareConcurrentAccess(void)
+{
+  GameExplicitRep::PrepareConcurrentAccess();
+  if (m_players.Length() > 0) {
+    GetPayoffTable<double>(1);
+    GetPayoffTable<Rational>(1);
+  }
+  HasExactDoublePayoffs();
+  return true;
+}
+
+template<> const double *GameTableRep::GetPayoffTable(int pl) const
+{
+  if (m_binary && m_binary->GetDoublePayoffs(pl)) {
+    return m_binary->GetDoublePayoffs(pl);
+  }
+  if (m_doublePayoffs.empty()) {
+    BuildPayoffTable(m_doublePayoffs);
+  }
+  return &m_doublePayoffs[(pl - 1) * NumContingencies()];
+}
+
+template<> const Rational *GameTableRep::GetPayoffTable(int pl) const
+{
+  if (m_rationalPayoffs.empty()) {
+    BuildPayoffTable(m_rationalPayoffs);
+  }
+  return &m_rationalPayoffs[(pl - 1) * NumContingencies()];
+}
+
+//
+// Payoffs from binary tables are integers or doubles, and their exact
+// values are taken to be those of the doubles.  Payoffs of outcomes are
+// only known to be exact when they are integers small enough to be
+// held in a double.
+//
+bool GameTableRep::HasExactDoublePayoffs(void) const
+{
+  if (m_exactDoubles < 0) {
+    m_exactDoubles = 1;
+    for (int outc = 1; !m_binary && m_exactDoubles && outc <= m_outcomes.Length(); outc++) {
+      for (int pl = 1; pl <= m_players.Length(); pl++) {
+	if (!m_outcomes[outc]->m_payoffs[pl].IsExactDouble()) {
+	  m_exactDoubles = 0;
+	  break;
+	}
+      }
+    }
+  }
+  return (m_exactDoubles == 1);
+}
+
+void GameTableRep::ClearPayoffCache(void) const
+{
+  GameRep::ClearPayoffCache();
+  m_exactDoubles = -1;
+  // Swapping with an empty vector releases the storage as well
+  std::vector<double>().swap(m_doublePayoffs);
+  std::vector<Rational>().swap(m_rationalPayoffs);
 }
 
 //------------------------------------------------------------------------
@@ -345,11 +818,30 @@ MixedStrategyProfile<Rational> GameTableRep::NewMixedStrategyProfile(const Ratio
 //              GameTableRep: Private auxiliary functions
 //------------------------------------------------------------------------
 
+/// Prepares for adding a strategy for player p_player, throwing
+/// TableTooLargeException if the table would then be too large to index.
+/// This is done before the strategy is added, so that on failure the
+/// game is left unchanged.
+void GameTableRep::PrepareNewStrategy(int p_player)
+{
+  Materialize();
+
+  Array<int> dim(m_players.Length());
+  for (int pl = 1; pl <= m_players.Length(); pl++) {
+    dim[pl] = m_players[pl]->NumStrategies() + ((pl == p_player) ? 1 : 0);
+  }
+  if (Product(dim) < 0) {
+    throw TableTooLargeException("Game table has too many contingencies to index");
+  }
+}
+
 /// This rebuilds a new table of outcomes after the game has been
 /// redimensioned (change in the number of strategies).  Strategies
 /// numbered -1 are identified as the new strategies.
 void GameTableRep::RebuildTable(void)
 {
+  Materialize();
+
   long size = 1L;
   Array<long> offsets(m_players.Length());
   for (int pl = 1; pl <= m_players.Length(); pl++) {
@@ -357,12 +849,11 @@ void GameTableRep::RebuildTable(void)
     size *= m_players[pl]->NumStrategies();
   }
 
-  Array<GameOutcomeRep *> newResults(size);
-  for (int i = 1; i <= newResults.Length(); newResults[i++] = 0);
+  std::vector<GameOutcomeRep *> newResults(size, (GameOutcomeRep *) 0);
 
   for (StrategyProfileIterator iter(StrategySupportProfile(const_cast<GameTableRep *>(this)));
        !iter.AtEnd(); iter++) {
-    long newindex = 1L;
+    long newindex = 0L;
     for (int pl = 1; pl <= m_players.Length(); pl++) {
       if (iter.m_profile->GetStrategy(pl)->m_offset < 0) {
 	// This is a contingency involving a new strategy... skip
@@ -374,14 +865,106 @@ void GameTableRep::RebuildTable(void)
       }
     }
 
-    if (newindex >= 1) {
-      newResults[newindex] = m_results[iter.m_profile->GetIndex()];
+    if (newindex >= 0) {
+      newResults[newindex] = m_results[iter.m_profile->GetIndex() - 1];
     }
   }
 
-  m_results = newResults;
+  m_results.swap(newResults);
 
   IndexStrategies();
+  ClearPayoffCache();
+}
+
+/// Fills in the packed payoff table from the outcomes.  Contingencies
+/// with no outcome attached have payoffs of zero.
+template <class T>
+void GameTableRep::BuildPayoffTable(std::vector<T> &p_table) const
+{
+  size_t ncont = NumContingencies();
+  p_table.assign(m_players.Length() * ncont, T(0));
+  for (int pl = 1; pl <= m_players.Length(); pl++) {
+    typename std::vector<T>::iterator entry = p_table.begin() + (pl - 1) * ncont;
+    for (size_t cont = 0; cont < ncont; cont++, ++entry) {
+      if (m_binary) {
+	GetBinaryPayoff(*m_binary, pl, cont, *entry);
+      }
+      else if (m_results[cont]) {
+	*entry = m_results[cont]->GetPayoff<T>(pl);
+      }
+    }
+  }
+}
+
+/// Creates an outcome for each contingency of a game read from a
+/// binary table, after which the game is an ordinary table game.
+void GameTableRep::Materialize(void)
+{
+  if (!m_binary) return;
+
+  long ncont = m_binary->NumContingencies();
+  if (ncont > std::numeric_limits<int>::max()) {
+    throw TableTooLargeException("Game table has too many contingencies to create outcomes");
+  }
+  m_results.resize(ncont);
+  m_outcomes = Array<GameOutcomeRep *>(ncont);
+  for (int i = 1; i <= m_outcomes.Length(); i++) {
+    m_outcomes[i] = new GameOutcomeRep(this, i);
+    for (int pl = 1; pl <= m_players.Length(); pl++) {
+      m_outcomes[i]->m_payoffs[pl] = m_binary->GetPayoffText(pl, i - 1);
+    }
+    m_results[i - 1] = m_outcomes[i];
+  }
+  delete m_binary;
+  m_binary = 0;
+  ClearPayoffCache();
+}
+
+void GameTableRep::WriteBinaryFile(std::ostream &p_stream, const Game &p_game)
+{
+  int numPlayers = p_game->NumPlayers();
+  StrategySupportProfile support(p_game);
+
+  // Integers are used if all payoffs are integers in range, and doubles
+  // otherwise.  Payoffs are read back as the values written, so any
+  // which doubles do not represent exactly are refused.
+  bool integers = true;
+  for (StrategyProfileIterator iter(support); !iter.AtEnd(); iter++) {
+    for (int pl = 1; pl <= numPlayers; pl++) {
+      Rational payoff = (*iter)->GetPayoff(pl);
+      if (payoff.denominator() != 1 ||
+	  payoff > Rational(std::numeric_limits<int>::max()) ||
+	  payoff < Rational(std::numeric_limits<int>::min())) {
+	integers = false;
+	if (Rational((double) payoff) != payoff) {
+	  throw ValueException("Payoff " + lexical_cast<std::string>(payoff) +
+			       " cannot be stored exactly in binary table format");
+	}
+      }
+    }
+  }
+
+  p_stream.write(BINARY_MAGIC, 8);
+  WriteUInt32(p_stream, BINARY_VERSION);
+  WriteUInt32(p_stream, (integers) ? BINARY_INT32 : BINARY_FLOAT64);
+  WriteUInt32(p_stream, numPlayers);
+  for (int pl = 1; pl <= numPlayers; pl++) {
+    WriteUInt32(p_stream, p_game->GetPlayer(pl)->NumStrategies());
+  }
+  for (int pad = (20 + 4 * numPlayers) % 8; pad > 0 && pad < 8; pad++) {
+    p_stream.put('\0');
+  }
+
+  for (int pl = 1; pl <= numPlayers; pl++) {
+    for (StrategyProfileIterator iter(support); !iter.AtEnd(); iter++) {
+      if (integers) {
+	WriteValue<int>(p_stream, (*iter)->GetPayoff(pl).numerator().as_long());
+      }
+      else {
+	WriteValue<double>(p_stream, (double) (*iter)->GetPayoff(pl));
+      }
+    }
+  }
 }
 
 void GameTableRep::IndexStrategies(void)
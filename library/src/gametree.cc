@@ -22,6 +22,8 @@
 
 #include <iostream>
 #include <sstream>
+#include <map>
+#include <algorithm>
 
 #include "gambit/gambit.h"
 #include "gambit/gametree.h"
@@ -290,6 +292,7 @@ void GameTreeNodeRep::SetOutcome(const GameOutcome &p_outcome)
   if (p_outcome != outcome) {
     outcome = p_outcome;
     m_efg->ClearComputedValues();
+    m_efg->ClearPayoffCache();
   }
 }
 
@@ -433,12 +436,79 @@ void GameTreeNodeRep::MoveTree(GameNode p_src)
   m_efg->Canonicalize();
 }
 
+namespace {
+
+//
+// Copies the subtree rooted at p_src to the terminal node p_dest of a
+// game with the same players.  Information sets and outcomes are
+// created in the copy the first time they are encountered, as they are
+// when reading the subtree back from a file; the maps record the
+// copies made so far.
+//
+void CopyNode(const GameNode &p_src, const GameNode &p_dest,
+	      std::map<GameInfosetRep *, GameInfoset> &p_infosets,
+	      std::map<GameOutcomeRep *, GameOutcome> &p_outcomes)
+{
+  Game game = p_dest->GetGame();
+  p_dest->SetLabel(p_src->GetLabel());
+
+  if (p_src->NumChildren() > 0) {
+    GameInfoset infoset = p_src->GetInfoset();
+    if (p_infosets.count(infoset.operator->())) {
+      p_dest->AppendMove(p_infosets[infoset.operator->()]);
+    }
+    else {
+      GamePlayer player = (infoset->IsChanceInfoset()) ? game->GetChance() :
+	game->GetPlayer(infoset->GetPlayer()->GetNumber());
+      GameInfoset copy = p_dest->AppendMove(player, infoset->NumActions());
+      copy->SetLabel(infoset->GetLabel());
+      for (int act = 1; act <= infoset->NumActions(); act++) {
+	copy->GetAction(act)->SetLabel(infoset->GetAction(act)->GetLabel());
+	if (infoset->IsChanceInfoset()) {
+	  copy->SetActionProb(act, infoset->GetActionProb(act, ""));
+	}
+      }
+      p_infosets[infoset.operator->()] = copy;
+    }
+  }
+
+  GameOutcome outcome = p_src->GetOutcome();
+  if (outcome) {
+    if (!p_outcomes.count(outcome.operator->())) {
+      GameOutcome copy = game->NewOutcome();
+      copy->SetLabel(outcome->GetLabel());
+      for (int pl = 1; pl <= game->NumPlayers(); pl++) {
+	copy->SetPayoff(pl, outcome->GetPayoff<std::string>(pl));
+      }
+      p_outcomes[outcome.operator->()] = copy;
+    }
+    p_dest->SetOutcome(p_outcomes[outcome.operator->()]);
+  }
+
+  for (int i = 1; i <= p_src->NumChildren(); i++) {
+    CopyNode(p_src->GetChild(i), p_dest->GetChild(i), p_infosets, p_outcomes);
+  }
+}
+
+}  // end anonymous namespace
+
 Game GameTreeNodeRep::CopySubgame(void) const
 {
-  std::ostringstream os;
-  m_efg->WriteEfgFile(os, const_cast<GameTreeNodeRep *>(this));
-  std::istringstream is(os.str());
-  return ReadGame(is);
+  GameTreeRep *efg = new GameTreeRep();
+  Game game = efg;
+  efg->SetCanonicalization(false);
+  efg->SetTitle(m_efg->GetTitle());
+  efg->SetComment(m_efg->GetComment());
+  for (int pl = 1; pl <= m_efg->NumPlayers(); pl++) {
+    efg->NewPlayer()->SetLabel(m_efg->GetPlayer(pl)->GetLabel());
+  }
+
+  std::map<GameInfosetRep *, GameInfoset> infosets;
+  std::map<GameOutcomeRep *, GameOutcome> outcomes;
+  CopyNode(const_cast<GameTreeNodeRep *>(this), efg->GetRoot(),
+	   infosets, outcomes);
+  efg->SetCanonicalization(true);
+  return game;
 }
 
 void GameTreeNodeRep::SetInfoset(GameInfoset p_infoset)
@@ -550,7 +620,8 @@ GameInfoset GameTreeNodeRep::InsertMove(GameInfoset p_infoset)
 //------------------------------------------------------------------------
 
 GameTreeRep::GameTreeRep(void)
-  : m_computedValues(false), m_doCanon(true)
+  : m_computedValues(false), m_doCanon(true),
+    m_flatTreeValid(false), m_structureVersion(0)
 {
   m_chance = new GamePlayerRep(this, 0);
   m_root = new GameTreeNodeRep(this, 0);
@@ -731,6 +802,9 @@ void GameTreeRep::Canonicalize(void)
       player->m_infosets[iset]->m_number = iset;
     }
   }
+
+  m_flatTreeValid = false;
+  m_structureVersion++;
 }
 
 void GameTreeRep::ClearComputedValues(void) const
@@ -742,6 +816,8 @@ void GameTreeRep::ClearComputedValues(void) const
   }
 
   m_computedValues = false;
+  m_flatTreeValid = false;
+  m_structureVersion++;
 }
 
 void GameTreeRep::BuildComputedValues(void)
@@ -1029,6 +1105,109 @@ int GameTreeRep::NumNodes(void) const
   return CountNodes(m_root);
 }
 
+const FlatGameTree &GameTreeRep::GetFlatTree(void) const
+{
+  if (!m_flatTreeValid) {
+    m_flatTree.Build(this);
+    m_flatTreeValid = true;
+  }
+  return m_flatTree;
+}
+
+bool GameTreeRep::PrepareConcurrentAccess(void)
+{
+  GameExplicitRep::PrepareConcurrentAccess();
+  for (int iset = 1; iset <= m_chance->m_infosets.Length(); iset++) {
+    const Array<Number> &probs = m_chance->m_infosets[iset]->m_probs;
+    for (int act = 1; act <= probs.Length(); act++) {
+      probs[act].BuildExtended();
+    }
+  }
+  GetFlatTree();
+  return true;
+}
+
+//------------------------------------------------------------------------
+//                   FlatGameTree: Building the arrays
+//------------------------------------------------------------------------
+
+void FlatGameTree::Build(const GameTreeRep *p_game)
+{
+  m_nodes.clear();
+  m_parent.clear();
+  m_action.clear();
+  m_infoset.clear();
+  m_player.clear();
+  m_outcome.clear();
+  int maxNumber = 0;
+
+  std::vector<GameTreeNodeRep *> stack;
+  std::vector<int> parents;
+  stack.push_back(p_game->m_root);
+  parents.push_back(-1);
+  while (!stack.empty()) {
+    GameTreeNodeRep *node = stack.back();
+    int parent = parents.back();
+    stack.pop_back();
+    parents.pop_back();
+
+    int n = m_nodes.size();
+    m_nodes.push_back(node);
+    m_parent.push_back(parent);
+    m_action.push_back(0);
+    m_infoset.push_back(node->infoset);
+    m_player.push_back((node->infoset) ?
+		       node->infoset->m_player->m_number : -1);
+    m_outcome.push_back(node->outcome);
+    maxNumber = std::max(maxNumber, node->number);
+    for (int i = node->children.Length(); i >= 1; i--) {
+      stack.push_back(node->children[i]);
+      parents.push_back(n);
+    }
+  }
+
+  int numNodes = m_nodes.size();
+  m_index.assign(maxNumber + 1, -1);
+  m_end.assign(numNodes, 0);
+  for (int n = numNodes - 1; n >= 0; n--) {
+    m_index[m_nodes[n]->number] = n;
+    if (m_end[n] == 0) {
+      m_end[n] = n + 1;
+    }
+    if (m_parent[n] >= 0) {
+      m_end[m_parent[n]] = std::max(m_end[m_parent[n]], m_end[n]);
+    }
+  }
+  for (int n = 0; n < numNodes; n++) {
+    for (int c = n + 1, act = 1; c < m_end[n]; c = m_end[c], act++) {
+      m_action[c] = act;
+    }
+  }
+
+  m_firstInfoset.assign(p_game->m_players.Length() + 1, 0);
+  m_infosets.clear();
+  m_members.clear();
+  for (int pl = 1; pl <= p_game->m_players.Length(); pl++) {
+    GamePlayerRep *player = p_game->m_players[pl];
+    m_firstInfoset[pl] = m_members.size();
+    for (int iset = 1; iset <= player->m_infosets.Length(); iset++) {
+      GameTreeInfosetRep *infoset = player->m_infosets[iset];
+      m_infosets.push_back(infoset);
+      m_members.push_back(std::vector<int>());
+      for (int i = 1; i <= infoset->m_members.Length(); i++) {
+	m_members.back().push_back(m_index[infoset->m_members[i]->number]);
+      }
+    }
+  }
+  m_infosetIndex.assign(numNodes, -1);
+  for (int n = 0; n < numNodes; n++) {
+    if (m_player[n] > 0) {
+      m_infosetIndex[n] = GetInfosetIndex(m_player[n],
+					  m_infoset[n]->m_number);
+    }
+  }
+}
+
 //------------------------------------------------------------------------
 //                     GameTreeRep: Factory functions
 //------------------------------------------------------------------------
@@ -20,9 +20,16 @@
 // Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
 //
 
+#include <algorithm>
+#include <vector>
+#ifdef _OPENMP
+#include <omp.h>
+#endif  // _OPENMP
+
 #include "gambit/gambit.h"
 #include "gambit/nash/gnm.h"
 #include "gambit/gtracer/gtracer.h"
+#include "../multirun.h"
 
 using namespace Gambit::gametracer;
 
@@ -40,35 +47,58 @@ NashGNMStrategySolver::ToProfile(const Game &p_game,
   return msp;
 }
 
+namespace {
+
+const int STEPS = 100;
+const double FUZZ = 1e-12;
+const int LNMFREQ = 3;
+const int LNMMAX = 10;
+const double LAMBDAMIN = -10.0;
+const bool WOBBLE = false;
+const double THRESHOLD = 1e-2;
+
+}  // end anonymous namespace
+
+List<MixedStrategyProfile<double> >
+NashGNMStrategySolver::TraceRay(const Game &p_game, gnmgame &A,
+				GNMWorkspace &p_workspace,
+				const cvector &p_pert,
+				NashGNMRaySummary &p_summary) const
+{
+  List<MixedStrategyProfile<double> > eqa;
+  double start = WallClock();
+  GNMStatistics stats;
+  cvector norm_pert = p_pert / p_pert.norm(); 
+  std::vector<cvector> answers;
+  int numEq = GNM(A, norm_pert, answers, p_workspace,
+		  STEPS, FUZZ, LNMFREQ, LNMMAX, LAMBDAMIN, WOBBLE, THRESHOLD,
+		  m_verbose, &stats);
+  for (int i = 0; i < numEq; i++) {
+    eqa.push_back(ToProfile(p_game, answers[i]));
+  }
+
+  p_summary.m_steps = stats.steps;
+  p_summary.m_lnmCalls = stats.lnmCalls;
+  p_summary.m_equilibria = numEq;
+  p_summary.m_seconds = WallClock() - start;
+  return eqa;
+}
+
 List<MixedStrategyProfile<double> >
 NashGNMStrategySolver::Solve(const Game &p_game,
 			     shared_ptr<gnmgame> p_rep,
 			     const cvector &p_pert) const
 {
-  const int STEPS = 100;
-  const double FUZZ = 1e-12;
-  const int LNMFREQ = 3;
-  const int LNMMAX = 10;
-  const double LAMBDAMIN = -10.0;
-  const bool WOBBLE = false;
-  const double THRESHOLD = 1e-2;
-
-  List<MixedStrategyProfile<double> > eqa;
-  
   if (m_verbose) {
     m_onEquilibrium->Render(ToProfile(p_game, p_pert), "pert");
   }
-  cvector norm_pert = p_pert / p_pert.norm(); 
-  cvector **answers;
-  int numEq = GNM(*p_rep, norm_pert, answers,
-		  STEPS, FUZZ, LNMFREQ, LNMMAX, LAMBDAMIN, WOBBLE, THRESHOLD,
-		  m_verbose);
-  for (int i = 0; i < numEq; i++) {
-    eqa.push_back(ToProfile(p_game, *answers[i]));
-    m_onEquilibrium->Render(eqa.back());
-    free(answers[i]);
+  NashGNMRaySummary summary;
+  GNMWorkspace workspace(p_rep->getNumPlayers(), p_rep->getNumActions());
+  List<MixedStrategyProfile<double> > eqa = TraceRay(p_game, *p_rep, workspace,
+						     p_pert, summary);
+  for (size_t i = 1; i <= eqa.size(); i++) {
+    m_onEquilibrium->Render(eqa[i]);
   }
-  free(answers);
   return eqa;
 }
 
@@ -143,5 +173,80 @@ NashGNMStrategySolver::Solve(const Game &p_game,
   return Solve(p_game, A, g);
 }
 
+//
+// Each thread traces rays on its own copy of the game representation,
+// which GNM() uses for scratch computations, and reuses its own GNM
+// workspace from one ray to the next.  The representations are
+// built beforehand, as is everything in the game computed on demand,
+// so that within the parallel loop the game is only read.
+//
+List<MixedStrategyProfile<double> >
+NashGNMStrategySolver::Solve(const Game &p_game,
+			     const List<MixedStrategyProfile<double> > &p_perts,
+			     int p_threads,
+			     List<NashGNMRaySummary> *p_summaries) const
+{
+  if (!p_game->IsPerfectRecall()) {
+    throw UndefinedException("Computing equilibria of games with imperfect recall is not supported.");
+  }
+  if (!p_game->PrepareConcurrentAccess() || m_verbose) {
+    // Action graph representations share scratch data, and the verbose
+    // output of GNM() is not synchronized
+    p_threads = 1;
+  }
+  p_threads = std::max(1, std::min(p_threads, (int) p_perts.size()));
+
+  std::vector<cvector> rays;
+  for (size_t i = 1; i <= p_perts.size(); i++) {
+    cvector g(p_perts[i].MixedProfileLength());
+    for (int j = 0; j < g.getm(); j++) {
+      g[j] = p_perts[i][j+1];
+    }
+    g /= g.norm();
+    rays.push_back(g);
+  }
+  std::vector<shared_ptr<gnmgame> > reps;
+  std::vector<shared_ptr<GNMWorkspace> > workspaces;
+  for (int t = 0; t < p_threads; t++) {
+    reps.push_back(BuildRepresentation(p_game));
+    workspaces.push_back(new GNMWorkspace(reps[t]->getNumPlayers(),
+					  reps[t]->getNumActions()));
+  }
+  std::vector<NashGNMRaySummary> summaries(rays.size());
+
+  List<MixedStrategyProfile<double> > solutions;
+#pragma omp parallel for schedule(dynamic) num_threads(p_threads)
+  for (int i = 0; i < (int) rays.size(); i++) {
+#ifdef _OPENMP
+    int t = omp_get_thread_num();
+#else
+    int t = 0;
+#endif  // _OPENMP
+    gnmgame &A = *reps[t];
+    if (m_verbose) {
+      m_onEquilibrium->Render(ToProfile(p_game, rays[i]), "pert");
+    }
+    List<MixedStrategyProfile<double> > eqa = TraceRay(p_game, A, *workspaces[t],
+						       rays[i], summaries[i]);
+#pragma omp critical(gnm_results)
+    {
+      for (size_t j = 1; j <= eqa.size(); j++) {
+	if (IsNewEquilibrium(solutions, eqa[j])) {
+	  m_onEquilibrium->Render(eqa[j]);
+	  solutions.push_back(eqa[j]);
+	}
+      }
+    }
+  }
+
+  if (p_summaries) {
+    *p_summaries = List<NashGNMRaySummary>();
+    for (size_t i = 0; i < summaries.size(); i++) {
+      p_summaries->push_back(summaries[i]);
+    }
+  }
+  return solutions;
+}
+
 }  // end namespace Gambit::Nash
 }  // end namespace Gambit
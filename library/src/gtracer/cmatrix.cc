@@ -25,7 +25,6 @@
 #include <cmath>
 #include <cfloat>
 #include "gambit/gtracer/cmatrix.h"
-#include "gambit/matrix.h"
 
 namespace Gambit {
 namespace gametracer {
@@ -35,7 +34,6 @@ cvector::~cvector() { delete []x; }
 cmatrix::~cmatrix()
  { delete []x; }
 
-int cvector::num_vec_cons = 0;
 cmatrix cmatrix::inv(bool &worked) const {
 	if (m!=n) {
 		std::cerr << "invalid cmatrix inverse" << std::endl;
@@ -401,16 +399,21 @@ void cmatrix::svd(cmatrix &u, cmatrix &v, double *w) {
 }
 
 double cmatrix::adjoint() {
+  cmatrix work(m, m);
+  std::vector<int> index(3*m);
+  return adjoint(work, index);
+}
+
+// This does the same computation as adjoint(), with all intermediate
+// values held in work (an m by m matrix) and index (of length 3m), so
+// that nothing is allocated.
+double cmatrix::adjoint(cmatrix &work, std::vector<int> &index) {
   int i, j, i0, j0, maxi, lastj = -1;
   double max, pivot;
-  std::vector<int> r(m);
-  std::vector<int> r2(m);
-  std::vector<int> c(m);
+  int *r = &index[0], *r2 = &index[m], *c = &index[2*m];
   double D = 1.0;
-  Gambit::Matrix<double> retval(0, m-1, 0, m-1);
-  for(i = 0; i < m; i++)
-    for(j = 0; j < m; j++)
-      retval(i, j) = x[i*n+j];
+  double *retval = work.x;
+  memcpy(retval, x, m*m*sizeof(double));
 
   for(i= 0; i < m; i++) {
     r[i] = -1;
@@ -421,8 +424,8 @@ double cmatrix::adjoint() {
     max = -1.0;
     maxi = -1;
     for(i = 0; i < m; i++) {
-      if(r[i] < 0 && fabs(retval(i,j)) > max) {
-	max = fabs(retval(i,j));
+      if(r[i] < 0 && fabs(retval[i*m+j]) > max) {
+	max = fabs(retval[i*m+j]);
 	maxi = i;
       }
     }
@@ -439,22 +442,22 @@ double cmatrix::adjoint() {
     }
 
     i = maxi;
-    pivot = retval(i,j);
+    pivot = retval[i*m+j];
     for(i0 = 0; i0 < m; i0++) {
       if(i0 != i) {
 	for(j0 = 0; j0 < m; j0++) {
 	  if(j0 != j) {
-	    retval(i0,j0) *= pivot;
-	    retval(i0,j0) -= retval(i0,j) * retval(i,j0);
-	    retval(i0,j0) /= D;
+	    retval[i0*m+j0] *= pivot;
+	    retval[i0*m+j0] -= retval[i0*m+j] * retval[i*m+j0];
+	    retval[i0*m+j0] /= D;
 	  }
 	}
       }
     }
     for(i0 = 0; i0 < m; i0++) {
-      retval(i0,j) = -retval(i0,j);
+      retval[i0*m+j] = -retval[i0*m+j];
     }
-    retval(i,j) = D;
+    retval[i*m+j] = D;
     D = pivot;
     r[i] = j;
     c[j] = i;
@@ -463,10 +466,9 @@ double cmatrix::adjoint() {
     if(j == m-1 && lastj >= 0)
       j = lastj - 1;
   }
-  //  std::cout << retval << std::endl << std::endl;
   int s=0;
   i = 0;
-  r2 = r;
+  memcpy(r2, r, m*sizeof(int));
   while(i < m-1) {
     j = r2[i];
     if(i != j) {
@@ -478,12 +480,11 @@ double cmatrix::adjoint() {
   }
   for(i = 0; i < m; i++)
     for(j = 0; j < m; j++)
-      x[i*n+j] = retval(c[i],r[j]);
+      x[i*n+j] = retval[c[i]*m+r[j]];
   if(s%2 == 1) {
     negate();
     D = -D;
   }
-  // std::cout << *this << std::endl << std::endl;
   return D;
 }
 
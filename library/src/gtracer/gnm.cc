@@ -41,12 +41,36 @@ void PrintProfile(std::ostream &p_stream,
   p_stream << std::endl;
 }
 
-// gnm(A,g,Eq,steps,fuzz,LNMFreq,LNMMax,LambdaMin,wobble,threshold)
-// ----------------------------------------------------------------
+GNMWorkspace::GNMWorkspace(int numPlayers, int numActions)
+  : s(numActions),   // current best responses
+    B(numActions),   // current support
+    DG(numActions, numActions),  // jacobian of the payoff function
+    R(numActions, numActions),   // jacobian of the retraction operator
+    I(numActions, numActions, 1, 1),  // identity
+    J(numActions, numActions),   // adjoint of the jacobian of the vector field
+    Y1(numActions, numActions),  // intermediate values
+    adjointWork(numActions, numActions),  // scratch for cmatrix::adjoint()
+    adjointIndex(3 * numActions),
+    sigma(numActions),  // current strategy profile
+    g0(numActions),     // original perturbation ray
+    z(numActions),      // current position in space of games
+    v(numActions),      // current cvector of payoffs for each pure strategy
+    dz(numActions),     // derivative of z w.r.t. time
+    dv(numActions),     // derivative of v w.r.t. time
+    nothing(numActions, 0),  // cvector of all zeros
+    err(numActions),
+    backup(numActions),
+    G(numPlayers), yn1(numPlayers),  // intermediate values
+    ym1(numActions), ym2(numActions), ym3(numActions)
+{ }
+
+// gnm(A,g,Eq,W,steps,fuzz,LNMFreq,LNMMax,LambdaMin,wobble,threshold)
+// ------------------------------------------------------------------
 // This executes the GNM algorithm on game A.
 // Interpretation of parameters:
 // g: perturbation ray.
-// Eq: an array of equilibria will be stored here
+// Eq: the equilibria found are stored here
+// W: the scratch storage used, which must match the dimensions of A
 // steps: number of steps to take within a support cell; higher 
 //        values of this parameter slow GNM down, but may help it
 //        avoid getting off the path.
@@ -66,8 +90,10 @@ void PrintProfile(std::ostream &p_stream,
 // threshold: the equilibrium error threshold for doing a wobble.  If
 //            wobbles are disabled, GNM will terminate if the error
 //            reaches this threshold.
+// stats: if not null, the number of steps taken and LNM runs are
+//        added to it.
 
-int GNM(gnmgame &A, cvector &g, cvector **&Eq, int steps, double fuzz, int LNMFreq, int LNMMax, double LambdaMin, bool wobble, double threshold, bool verbose)
+int GNM(gnmgame &A, cvector &g, std::vector<cvector> &Eq, GNMWorkspace &W, int steps, double fuzz, int LNMFreq, int LNMMax, double LambdaMin, bool wobble, double threshold, bool verbose, GNMStatistics *stats)
 {
   int i, // utility variables
     bestAction,  
@@ -78,7 +104,6 @@ int GNM(gnmgame &A, cvector &g, cvector **&Eq, int steps, double fuzz, int LNMFr
     s_hat_old=-1, // the last pure strategy to enter or leave the support
     s_hat, // the next pure strategy to enter or leave the support
     Index = 1, // index of the equilibrium we're moving towards
-    numEq = 0, // number of equilibria found so far
     stepsLeft; // number of linear steps remaining until we hit the boundary
 
   int N = A.getNumPlayers(), 
@@ -96,34 +121,21 @@ int GNM(gnmgame &A, cvector &g, cvector **&Eq, int steps, double fuzz, int LNMFr
     ee,
     V = 0.0; // scale factor for perturbation
 
-  std::vector<int> s(M); // current best responses
-  std::vector<int> B(M); // current support
-
-  for (int i = 0; i < M; B[i++] = 0);
-
-  cmatrix DG(M,M), // jacobian of the payoff function
-    R(M,M), // jacobian of the retraction operator
-    I(M,M,1,1), // identity
-    Dpsi, // jacobian of the cvector field
-    J(M,M); // adjoint of Dpsi
-
-  cvector sigma(M), // current strategy profile
-    g0(M), // original perturbation ray
-    z(M), // current position in space of games
-    v(M), // current cvector of payoffs for each pure strategy
-    dz(M), // derivative of z w.r.t. time
-    dv(M), // derivative of v w.r.t. time
-    nothing(M,0),// cvector of all zeros
-    err(M),
-    backup(M); 
+  if (W.getNumPlayers() != N || W.getNumActions() != M) {
+    throw DimensionException();
+  }
 
+  // The workspace is documented in GNMWorkspace::GNMWorkspace()
+  std::vector<int> &s = W.s, &B = W.B;
+  cmatrix &DG = W.DG, &R = W.R, &I = W.I, &J = W.J, &Y1 = W.Y1;
+  cvector &sigma = W.sigma, &g0 = W.g0, &z = W.z, &v = W.v, &dz = W.dz,
+    &dv = W.dv, &nothing = W.nothing, &err = W.err, &backup = W.backup;
+  cvector &G = W.G, &yn1 = W.yn1, &ym1 = W.ym1, &ym2 = W.ym2, &ym3 = W.ym3;
 
-  // utility variables for use as intermediate values in computations
-  cmatrix Y1(M,M), Y2(M,M), Y3(M,M);
-  cvector G(N), yn1(N), ym1(M), ym2(M), ym3(M);
+  for (int i = 0; i < M; B[i++] = 0);
 
   // INITIALIZATION
-  Eq = (cvector **)malloc(sizeof(cvector *));
+  Eq.clear();
 
   // Find the lone equilibrium of the perturbed game
   for(n = 0; n < N; n++) {
@@ -216,13 +228,13 @@ int GNM(gnmgame &A, cvector &g, cvector **&Eq, int steps, double fuzz, int LNMFr
     // take the specified number of steps within these support boundaries.  
     for(stepsLeft = steps; stepsLeft > 0; stepsLeft--) { 
       //find J = Adj psi
-      J = I;
-      J += DG;
-      J *= R;
+      Y1 = I;
+      Y1 += DG;
+      Y1.multiply(R, J);
       J -= I;
       J.negate();
       // J = I-((I+DG)*R);
-      det = J.adjoint(); // sets J = adjoint(J)
+      det = J.adjoint(W.adjointWork, W.adjointIndex); // sets J = adjoint(J)
 
       // find derivatives of z and lambda
       J.multiply(g,dz);
@@ -278,7 +290,7 @@ int GNM(gnmgame &A, cvector &g, cvector **&Eq, int steps, double fuzz, int LNMFr
 	if (verbose) {
 	  std::cerr << "gnm(): return since the path crosses no more support boundaries and no next eqlm" << std::endl;
 	}
-	return numEq;
+	return Eq.size();
       }
       
       // each step covers 1.0/steps of the distance to the boundary
@@ -304,27 +316,26 @@ int GNM(gnmgame &A, cvector &g, cvector **&Eq, int steps, double fuzz, int LNMFr
 	  ee = 0.0;
 	  if(N > 2) { // if N=2, the graph is linear, so we are at a
 	    //precise equilibrium.  otherwise, refine it.
-	    J = DG;
-	    J += I;
-	    J *= R;
+	    Y1 = DG;
+	    Y1 += I;
+	    Y1.multiply(R, J);
 	    J -= I; 
 	    J.negate();
 	    //J=I-((I+DG)*R);
-	    det = J.adjoint();
+	    det = J.adjoint(W.adjointWork, W.adjointIndex);
 	    ee = A.LNM(z, nothing, det, J, DG, sigma, LNMMax, fuzz,ym1,ym2,ym3);
+	    if (stats) stats->lnmCalls++;
 	  }
 	  for (int idx=0;idx<M;idx++)
 	    if (! std::isfinite(sigma[idx])){
 	      if(verbose) {
 		std::cerr << "gnm(): return since sigma is not finite" << std::endl;
 	      }
-	      return numEq;
+	      return Eq.size();
 	    }
 	  if(ee < fuzz) { // only save high quality equilibria;
 	    // this restriction could be removed.
-	    Eq = (cvector **)realloc(Eq, (numEq+2)*sizeof(cvector *));	
-	    Eq[numEq] = new cvector(M);
-	    *(Eq[numEq++]) = sigma;
+	    Eq.push_back(sigma);
 
 	    //PrintProfile(std::cout, "NE", sigma);
       }
@@ -338,12 +349,13 @@ int GNM(gnmgame &A, cvector &g, cvector **&Eq, int steps, double fuzz, int LNMFr
 	if (verbose) {
 	  std::cerr << "gnm(): return since no next support boundary after this eqlm" << std::endl;
 	}
-	return numEq;
+	return Eq.size();
       }
 
       backup = z;
 
       // do the step
+      if (stats) stats->steps++;
       ym1 = dz;
       ym1 *= delta;
       z += ym1;
@@ -356,7 +368,7 @@ int GNM(gnmgame &A, cvector &g, cvector **&Eq, int steps, double fuzz, int LNMFr
 	if (verbose) {
 	  std::cerr << "gnm(): return due to too far out in the reverse direction" << std::endl;
 	}
-	return numEq;
+	return Eq.size();
       }
       A.retract(sigma,z);
       A.payoffMatrix(DG, sigma,fuzz);
@@ -390,13 +402,14 @@ int GNM(gnmgame &A, cvector &g, cvector **&Eq, int steps, double fuzz, int LNMFr
 	  if(verbose) {
 	    std::cerr << "gnm(): return due to too much error. error is " << ee << std::endl;
 	  }
-	  return numEq;
+	  return Eq.size();
 	}
       }
 
       // if we've done LNMMax repetitions, time to get back on the path
       if(stepsLeft > 1 && (++k == LNMFreq)) {
 	A.LNM(z, g0, det, J, DG, sigma, LNMMax, fuzz,ym1,ym2,ym3);
+	if (stats) stats->lnmCalls++;
 	k = 0;
       }
     } // end of for loop
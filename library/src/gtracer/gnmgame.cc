@@ -48,6 +48,7 @@ gnmgame::gnmgame(int numPlayers, int *actions): numPlayers(numPlayers) {
       maxActions = actions[i];
   }
   strategyOffset[i] = numActions;
+  retractScratch.resize(numActions);
 }
   
 gnmgame::~gnmgame() {
@@ -91,37 +92,22 @@ int compareDouble(const void *d1, const void *d2) {
 void gnmgame::retract(cvector &dest, cvector &z) {
   int n, i;
   double v, sumz;
-  // FIXME: The original Gametracer code had a variable-sized array for 'y', which is
-  // not permitted by ISO C++.  However, the implementation of this function is
-  // not well-encapsulated, in particular, it uses pointer manipulation to segregate
-  // out the probabilities for each player, and uses qsort() directly on those pointers.
-  // So, it is not straightforward to translate this to use, e.g., std::vector.
-  // 
-  // The immediate solution is to allocate dynamically, and use try..catch to ensure
-  // deallocation.  Encapsulation is of course a superior solution eventually.
-  double *y = new double[numActions];
-  try {
-    memcpy(y,z.values(),numActions*sizeof(double));
-    for(n = 0; n < numPlayers; n++) {
-      qsort(y+firstAction(n),actions[n],sizeof(double),compareDouble);
-      sumz = y[firstAction(n)];
-      for(i=firstAction(n)+1; i < lastAction(n); i++) {
-        if(sumz - (i-firstAction(n)) * y[i] > 1)
-	      break;
-        sumz += y[i];
-      }
-      v = (sumz - 1) / (double)(i-firstAction(n));
-      for(i = firstAction(n); i < lastAction(n); i++) {
-        dest[i] = z[i] - v;
-        if(dest[i] < 0.0)
-          dest[i] = 0.0;
-      }
+  double *y = &retractScratch[0];
+  memcpy(y,z.values(),numActions*sizeof(double));
+  for(n = 0; n < numPlayers; n++) {
+    qsort(y+firstAction(n),actions[n],sizeof(double),compareDouble);
+    sumz = y[firstAction(n)];
+    for(i=firstAction(n)+1; i < lastAction(n); i++) {
+      if(sumz - (i-firstAction(n)) * y[i] > 1)
+	break;
+      sumz += y[i];
+    }
+    v = (sumz - 1) / (double)(i-firstAction(n));
+    for(i = firstAction(n); i < lastAction(n); i++) {
+      dest[i] = z[i] - v;
+      if(dest[i] < 0.0)
+	dest[i] = 0.0;
     }
-    delete [] y;
-  }
-  catch (...) {
-    delete [] y;
-    throw;
   }
 }
 void gnmgame::retract(cvector &dest, cvector &z, bool ksym){
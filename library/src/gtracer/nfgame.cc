@@ -35,6 +35,8 @@ nfgame::nfgame(int numPlayers, int *actions, const cvector &payoffs) : gnmgame(n
   for(int i = 1; i <= numPlayers; i++) {
     blockSize[i] = blockSize[i-1]*actions[i-1];
   }
+  scratchPayoffs.resize(blockSize[numPlayers]);
+  scratchLocal.resize(maxActions*maxActions);
 }
 
 nfgame::~nfgame() {
@@ -49,17 +51,9 @@ int nfgame::findIndex(int player, int *s) {
 }
 
 double nfgame::getMixedPayoff(int player, cvector &s) {
-  double *m = new double[blockSize[numPlayers]];
-  try {
-    memcpy(m, payoffs.values() + player * blockSize[numPlayers], blockSize[numPlayers]*sizeof(double));
-    double p = localPayoff(s, m, numPlayers-1);
-    delete [] m;
-    return p;
-  }
-  catch (...) {
-    delete [] m;
-    throw;
-  }
+  double *m = &scratchPayoffs[0];
+  memcpy(m, payoffs.values() + player * blockSize[numPlayers], blockSize[numPlayers]*sizeof(double));
+  return localPayoff(s, m, numPlayers-1);
 }
 
 void nfgame::getPayoffVector(cvector &dest, int player, const cvector &s){
@@ -71,42 +65,33 @@ void nfgame::getPayoffVector(cvector &dest, int player, const cvector &s){
 void nfgame::payoffMatrix(cmatrix &dest, cvector &s, double fuzz) {
   int rown, coln, rowi, coli;
   double fuzzcount;
-  double *m = new double[blockSize[numPlayers]];
-  double *local = new double[maxActions*maxActions];
-  try {
-    for(rown = 0; rown < numPlayers; rown++) {
-      for(coln = 0; coln < numPlayers; coln++) {
-        if(rown == coln) {
-	  fuzzcount = fuzz;
-	  for(rowi=firstAction(rown); rowi < lastAction(rown); rowi++) {
-	    for(coli=firstAction(coln); coli < lastAction(coln); coli++) {
-	      dest[rowi][coli]=fuzzcount;
-	      fuzzcount += fuzz;
-	    }
+  double *m = &scratchPayoffs[0];
+  double *local = &scratchLocal[0];
+  for(rown = 0; rown < numPlayers; rown++) {
+    for(coln = 0; coln < numPlayers; coln++) {
+      if(rown == coln) {
+	fuzzcount = fuzz;
+	for(rowi=firstAction(rown); rowi < lastAction(rown); rowi++) {
+	  for(coli=firstAction(coln); coli < lastAction(coln); coli++) {
+	    dest[rowi][coli]=fuzzcount;
+	    fuzzcount += fuzz;
 	  }
-        } else {
-	  // set m to be the payoffs for player rown
-	  memcpy(m, payoffs.values() + rown * blockSize[numPlayers], blockSize[numPlayers] * sizeof(double));
-	  localPayoffMatrix(local, rown, coln, s, m, numPlayers-1);
-	  for(rowi = firstAction(rown); rowi < lastAction(rown); rowi++) {
-	    for(coli = firstAction(coln); coli < lastAction(coln); coli++) {
-	      if(rown > coln) {
-	        dest[rowi][coli] = *(local + (rowi - firstAction(rown))*actions[coln] + (coli - firstAction(coln)));
-	      } else {
-	        dest[rowi][coli] = *(local + (coli - firstAction(coln))*actions[rown] + (rowi - firstAction(rown)));
-	      }
+	}
+      } else {
+	// set m to be the payoffs for player rown
+	memcpy(m, payoffs.values() + rown * blockSize[numPlayers], blockSize[numPlayers] * sizeof(double));
+	localPayoffMatrix(local, rown, coln, s, m, numPlayers-1);
+	for(rowi = firstAction(rown); rowi < lastAction(rown); rowi++) {
+	  for(coli = firstAction(coln); coli < lastAction(coln); coli++) {
+	    if(rown > coln) {
+	      dest[rowi][coli] = *(local + (rowi - firstAction(rown))*actions[coln] + (coli - firstAction(coln)));
+	    } else {
+	      dest[rowi][coli] = *(local + (coli - firstAction(coln))*actions[rown] + (rowi - firstAction(rown)));
 	    }
 	  }
-        }
+	}
       }
     }
-    delete [] local;
-    delete [] m;
-  }
-  catch (...) {
-    delete [] local;
-    delete [] m;
-    throw;
   }
 }
 
@@ -108,7 +108,8 @@ inline static unsigned short extract(unsigned long x)
   return (unsigned short) (x & I_MAXNUM);
 }
 
-// transfer high bits to low
+// transfer high bits to low.  This keeps a single digit, so a long,
+// which may span more than two digits, is split by shifting instead.
 
 inline static unsigned long down(unsigned long x)
 {
@@ -322,7 +323,7 @@ IntegerRep* Icopy_ulong(IntegerRep* old, unsigned long x)
   while (x != 0)
   {
     src[srclen++] = extract(x);
-    x = down(x);
+    x >>= I_SHIFT;
   }
 
   IntegerRep* rep;
@@ -591,7 +592,7 @@ int compare(const IntegerRep* x, long  y)
         while (uy != 0)
         {
           tmp[yl++] = extract(uy);
-          uy = down(uy);
+          uy >>= I_SHIFT;
         }
         diff = xl - yl;
         if (diff == 0)
@@ -620,7 +621,7 @@ int ucompare(const IntegerRep* x, long  y)
       while (uy != 0)
       {
         tmp[yl++] = extract(uy);
-        uy = down(uy);
+        uy >>= I_SHIFT;
       }
       diff = xl - yl;
       if (diff == 0)
@@ -778,11 +779,13 @@ IntegerRep* add(const IntegerRep* x, int negatex, long y, IntegerRep* r)
     const unsigned short* as =  (xrsame)? r->s : x->s;
     const unsigned short* topa = &(as[xl]);
     unsigned long sum = 0;
-    while (as < topa && uy != 0)
+    while (uy != 0)
     {
       unsigned long u = extract(uy);
-      uy = down(uy);
-      sum += (unsigned long)(*as++) + u;
+      uy >>= I_SHIFT;
+      sum += u;
+      if (as < topa)
+        sum += (unsigned long)(*as++);
       *rs++ = extract(sum);
       sum = down(sum);
     }
@@ -805,7 +808,7 @@ IntegerRep* add(const IntegerRep* x, int negatex, long y, IntegerRep* r)
     while (uy != 0)
     {
       tmp[yl++] = extract(uy);
-      uy = down(uy);
+      uy >>= I_SHIFT;
     }
     int comp = xl - yl;
     if (comp == 0)
@@ -1033,7 +1036,7 @@ IntegerRep* multiply(const IntegerRep* x, long y, IntegerRep* r)
     while (uy != 0)
     {
       tmp[yl++] = extract(uy);
-      uy = down(uy);
+      uy >>= I_SHIFT;
     }
 
     int rl = xl + yl;
@@ -1296,7 +1299,7 @@ IntegerRep* div(const IntegerRep* x, long y, IntegerRep* q)
   while (u != 0)
   {
     ys[yl++] = extract(u);
-    u = down(u);
+    u >>= I_SHIFT;
   }
 
   int comp = xl - yl;
@@ -1322,10 +1325,11 @@ IntegerRep* div(const IntegerRep* x, long y, IntegerRep* q)
 	 unsigned short prescale = (unsigned short) (I_RADIX / (1 + ys[yl - 1]));
     if (prescale != 1)
     {
-      unsigned long prod = (unsigned long)prescale * (unsigned long)ys[0];
-      ys[0] = extract(prod);
-      prod = down(prod) + (unsigned long)prescale * (unsigned long)ys[1];
-      ys[1] = extract(prod);
+      unsigned long prod = 0;
+      for (int i = 0; i < yl; i++) {
+        prod = down(prod) + (unsigned long)prescale * (unsigned long)ys[i];
+        ys[i] = extract(prod);
+      }
       r = multiply(x, ((long)prescale & I_MAXNUM), r);
     }
     else
@@ -1367,7 +1371,7 @@ void divide(const Integer& Ix, long y, Integer& Iq, long& rem)
   while (u != 0)
   {
     ys[yl++] = extract(u);
-    u = down(u);
+    u >>= I_SHIFT;
   }
 
   int comp = xl - yl;
@@ -1397,10 +1401,11 @@ void divide(const Integer& Ix, long y, Integer& Iq, long& rem)
 	 unsigned short prescale = (unsigned short) (I_RADIX / (1 + ys[yl - 1]));
     if (prescale != 1)
     {
-      unsigned long prod = (unsigned long)prescale * (unsigned long)ys[0];
-      ys[0] = extract(prod);
-      prod = down(prod) + (unsigned long)prescale * (unsigned long)ys[1];
-      ys[1] = extract(prod);
+      unsigned long prod = 0;
+      for (int i = 0; i < yl; i++) {
+        prod = down(prod) + (unsigned long)prescale * (unsigned long)ys[i];
+        ys[i] = extract(prod);
+      }
       r = multiply(x, ((long)prescale & I_MAXNUM), r);
     }
     else
@@ -1578,7 +1583,7 @@ IntegerRep* mod(const IntegerRep* x, long y, IntegerRep* r)
   while (u != 0)
   {
     ys[yl++] = extract(u);
-    u = down(u);
+    u >>= I_SHIFT;
   }
 
   int comp = xl - yl;
@@ -1602,10 +1607,11 @@ IntegerRep* mod(const IntegerRep* x, long y, IntegerRep* r)
 	 unsigned short prescale = (unsigned short) (I_RADIX / (1 + ys[yl - 1]));
     if (prescale != 1)
     {
-      unsigned long prod = (unsigned long)prescale * (unsigned long)ys[0];
-      ys[0] = extract(prod);
-      prod = down(prod) + (unsigned long)prescale * (unsigned long)ys[1];
-      ys[1] = extract(prod);
+      unsigned long prod = 0;
+      for (int i = 0; i < yl; i++) {
+        prod = down(prod) + (unsigned long)prescale * (unsigned long)ys[i];
+        ys[i] = extract(prod);
+      }
       r = multiply(x, ((long)prescale & I_MAXNUM), r);
     }
     else
@@ -1775,7 +1781,7 @@ IntegerRep* bitop(const IntegerRep* x, long y, IntegerRep* r, char op)
   while (u != 0)
   {
 	 tmp[l++] = extract(u);
-	 u = down(u);
+	 u >>= I_SHIFT;
   }
 
   int xl = x->len;
@@ -1908,6 +1914,22 @@ IntegerRep* gcd(const IntegerRep* x, const IntegerRep* y)
   else if (ul == 0)
     return Ialloc(0, y->s, vl, I_POSITIVE, vl);
 
+  // Most gcds, for instance when normalizing rationals, are of numbers
+  // that fit in a machine word; use Euclid's algorithm on those
+  if ((unsigned) ul <= SHORT_PER_LONG && (unsigned) vl <= SHORT_PER_LONG)
+  {
+    unsigned long a = 0, b = 0;
+    for (int i = ul - 1; i >= 0; --i)  a = up(a) | x->s[i];
+    for (int i = vl - 1; i >= 0; --i)  b = up(b) | y->s[i];
+    while (b != 0)
+    {
+      unsigned long t = a % b;
+      a = b;
+      b = t;
+    }
+    return Icopy_ulong(0, a);
+  }
+
   IntegerRep* u = Ialloc(0, x->s, ul, I_POSITIVE, ul);
   IntegerRep* v = Ialloc(0, y->s, vl, I_POSITIVE, vl);
 
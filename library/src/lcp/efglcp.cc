@@ -24,6 +24,7 @@
 #include <cstdio>
 #include <unistd.h>
 #include <iostream>
+#include <set>
 #include "gambit/gambit.h"
 #include "gambit/linalg/lemketab.h"
 #include "gambit/linalg/lhtab.h"
@@ -38,7 +39,7 @@ public:
   Rational maxpay;
   T eps;
   List<GameInfoset> isets1, isets2;
-  List<Gambit::linalg::BFS<T> > m_list;
+  std::set<Gambit::linalg::BFS<T> > m_list;
   List<MixedBehaviorProfile<T> > m_equilibria;
 
   bool AddBFS(const linalg::LemkeTableau<T> &);
@@ -59,13 +60,7 @@ NashLcpBehaviorSolver<T>::Solution::AddBFS(const linalg::LemkeTableau<T> &tablea
     }
   }
 
-  if (!m_list.Contains(cbfs)) {
-    m_list.push_back(cbfs);
-    return true;
-  }
-  else {
-    return false;
-  }
+  return m_list.insert(cbfs).second;
 }
 
 //
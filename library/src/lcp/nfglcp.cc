@@ -23,6 +23,7 @@
 #include <cstdio>
 #include <unistd.h>
 #include <iostream>
+#include <set>
 
 #include "gambit/gambit.h"
 #include "gambit/linalg/lhtab.h"
@@ -112,29 +113,67 @@ template <class T> Vector<T> Make_b2(const Game &p_game)
   return b2;
 }
 
+//
+// A copy of a floating-point tableau solves through the factorization
+// of the tableau it was copied from, whose eta file is not safe to read
+// from several threads at once.  Paths run as parallel tasks therefore
+// refactor their copy first.  Exact and dense tableaux share nothing.
+//
+template <class T> void DetachTableau(linalg::LHTableau<T> &) { }
+
+template<> void DetachTableau(linalg::LHTableau<double> &p_tableau)
+{
+  if (!p_tableau.IsDense()) {
+    p_tableau.Refactor();
+  }
+}
+
 }  // end anonymous namespace
   
 
+//
+// The state of the search shared by all paths.  With several threads,
+// the set of CBFS seen and the equilibria are only accessed within the
+// critical section lcp_strategy_solution.
+//
 template <class T>
 class NashLcpStrategySolver<T>::Solution {
 public:
-  List<Gambit::linalg::BFS<T> > m_bfsList;
+  std::set<Gambit::linalg::BFS<T> > m_bfsSet;
   List<MixedStrategyProfile<T> > m_equilibria;
+  int m_threads;
+  /// Set once the equilibrium limit is reached, or a path fails
+  int m_stopped;
+  std::string m_error;
 
-  bool Contains(const Gambit::linalg::BFS<T> &p_bfs) const
-  { return m_bfsList.Contains(p_bfs); }
-  void push_back(const Gambit::linalg::BFS<T> &p_bfs)
-  { m_bfsList.push_back(p_bfs); }
+  Solution(int p_threads) : m_threads(p_threads), m_stopped(0) { }
+
+  /// Returns true if the CBFS has not been seen before
+  bool Insert(const Gambit::linalg::BFS<T> &p_bfs)
+  { return m_bfsSet.insert(p_bfs).second; }
 
   int EquilibriumCount(void) const { return m_equilibria.size(); }
+
+  bool IsStopped(void) const
+  {
+    int stopped;
+#pragma omp atomic read
+    stopped = m_stopped;
+    return stopped;
+  }
+  void Stop(void)
+  {
+#pragma omp atomic write
+    m_stopped = 1;
+  }
 };
   
 //
 // Function called when a CBFS is encountered.
-// If it is not already in the list p_list, it is added.
-// The corresponding equilibrium is computed and output.
-// Returns 'true' if the CBFS is new; 'false' if it already appears in the
-// list.
+// If it has not already been seen, it is recorded, and the
+// corresponding equilibrium is computed and output.
+// Returns 'true' if the CBFS is new; 'false' if it has been seen
+// before.
 //
 template <class T> bool
 NashLcpStrategySolver<T>::OnBFS(const Game &p_game,
@@ -142,10 +181,12 @@ NashLcpStrategySolver<T>::OnBFS(const Game &p_game,
 				Solution &p_solution) const
 {
   Gambit::linalg::BFS<T> cbfs(p_tableau.GetBFS());
-  if (p_solution.Contains(cbfs)) {
+  bool isNew;
+#pragma omp critical(lcp_strategy_solution)
+  isNew = p_solution.Insert(cbfs);
+  if (!isNew) {
     return false;
   }
-  p_solution.push_back(cbfs);
 
   MixedStrategyProfile<T> profile(p_game->NewMixedStrategyProfile(static_cast<T>(0.0)));
   int n1 = p_game->Players()[1]->Strategies().size();
@@ -185,22 +226,31 @@ NashLcpStrategySolver<T>::OnBFS(const Game &p_game,
     }
   }
   
-  this->m_onEquilibrium->Render(profile);
-  p_solution.m_equilibria.push_back(profile);
-
-  if (m_stopAfter > 0 && p_solution.EquilibriumCount() >= m_stopAfter) {
-    throw EquilibriumLimitReached();
+#pragma omp critical(lcp_strategy_solution)
+  {
+    if (!p_solution.IsStopped()) {
+      this->m_onEquilibrium->Render(profile);
+      p_solution.m_equilibria.push_back(profile);
+      if (m_stopAfter > 0 && p_solution.EquilibriumCount() >= m_stopAfter) {
+	p_solution.Stop();
+      }
+    }
   }
-
   return true;
 }
 
 //
 // AllLemke finds all accessible Nash equilibria by recursively 
-// calling itself.  p_list maintains the list of basic variables 
-// for the equilibria that have already been found.  
-// From each new accessible equilibrium, it follows
-// all possible paths, adding any new equilibria to the List.  
+// calling itself.  p_solution records the CBFS that have already been
+// seen.  From each new accessible equilibrium, it follows
+// all possible paths, adding any new equilibria to the solution.
+//
+// Each path is followed as a task, on its own copy of the tableau.
+// With one thread the tasks are run as soon as they are created, so
+// the paths are followed depth-first in the same order as a plain
+// recursion.  The search stops once p_solution is stopped; exceptions
+// cannot leave a task, so a failure on any path is recorded in
+// p_solution and stops the search likewise.
 //
 template <class T> void 
 NashLcpStrategySolver<T>::AllLemke(const Game &p_game,
@@ -208,6 +258,9 @@ NashLcpStrategySolver<T>::AllLemke(const Game &p_game,
 				   Solution &p_solution,
 				   int depth) const
 {
+  if (p_solution.IsStopped()) {
+    return;
+  }
   if (m_maxDepth != 0 && depth > m_maxDepth) {
     return;
   }
@@ -218,13 +271,37 @@ NashLcpStrategySolver<T>::AllLemke(const Game &p_game,
     return;
   }
   
+  const Game *game = &p_game;
+  linalg::LHTableau<T> *tableau = &B;
+  Solution *solution = &p_solution;
   for (int i = B.MinCol(); i <= B.MaxCol(); i++) {
     if (i != j)  {
-      linalg::LHTableau<T> Bcopy(B);
-      Bcopy.LemkePath(i);
-      AllLemke(p_game, i, Bcopy, p_solution, depth+1);
+#pragma omp task if(solution->m_threads > 1) firstprivate(i, game, tableau, solution, depth)
+      {
+	if (!solution->IsStopped()) {
+	  try {
+	    linalg::LHTableau<T> Bcopy(*tableau);
+	    if (solution->m_threads > 1) {
+	      DetachTableau(Bcopy);
+	    }
+	    Bcopy.LemkePath(i);
+	    AllLemke(*game, i, Bcopy, *solution, depth+1);
+	  }
+	  catch (std::runtime_error &e) {
+#pragma omp critical(lcp_strategy_solution)
+	    {
+	      if (solution->m_error == "") {
+		solution->m_error = e.what();
+	      }
+	    }
+	    solution->Stop();
+	  }
+	}
+      }
     }
   }
+  // Paths from here use the tableau B, which must outlive them
+#pragma omp taskwait
 }
 
 template <class T> List<MixedStrategyProfile<T> > 
@@ -236,7 +313,8 @@ NashLcpStrategySolver<T>::Solve(const Game &p_game) const
   if (!p_game->IsPerfectRecall()) {
     throw UndefinedException("Computing equilibria of games with imperfect recall is not supported.");
   }
-  Solution solution;
+  int threads = (m_threads > 1 && p_game->PrepareConcurrentAccess()) ? m_threads : 1;
+  Solution solution(threads);
 
   try {
     Matrix<T> A1 = Make_A1<T>(p_game);
@@ -244,22 +322,29 @@ NashLcpStrategySolver<T>::Solve(const Game &p_game) const
     Matrix<T> A2 = Make_A2<T>(p_game);
     Vector<T> b2 = Make_b2<T>(p_game);
     linalg::LHTableau<T> B(A1, A2, b1, b2);
+    B.SetDense(m_dense);
 
     if (m_stopAfter != 1) {
-      AllLemke(p_game, 0, B, solution, 0);
+      if (threads > 1) {
+#pragma omp parallel num_threads(threads)
+#pragma omp single
+	AllLemke(p_game, 0, B, solution, 0);
+      }
+      else {
+	AllLemke(p_game, 0, B, solution, 0);
+      }
     }
     else  {
       B.LemkePath(1);
       OnBFS(p_game, B, solution);
     }
   }
-  catch (EquilibriumLimitReached &) {
-    // This pseudo-exception requires no additional action;
-    // solution contains details of all equilibria found
-  }
   catch (std::runtime_error &e) {
     std::cerr << "ERROR: " << e.what() << std::endl;
   }
+  if (solution.m_error != "") {
+    std::cerr << "ERROR: " << solution.m_error << std::endl;
+  }
   return solution.m_equilibria;
 }
 
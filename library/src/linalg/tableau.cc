@@ -20,6 +20,9 @@
 // Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
 //
 
+#include <algorithm>
+#include <climits>
+#include <cmath>
 #include "gambit/linalg/tableau.h"
 
 namespace Gambit {
@@ -33,21 +36,26 @@ namespace linalg {
 // Constructors and Destructor
  
 Tableau<double>::Tableau(const Matrix<double> &A, const Vector<double> &b)
-  : TableauInterface<double>(A,b), B(*this), tmpcol(b.First(),b.Last())
+  : TableauInterface<double>(A,b), B(*this), tmpcol(b.First(),b.Last()),
+    m_dense(false), m_rows(0), m_width(0), m_refactor(0), m_sinceRefactor(0)
 {
   Solve(b, solution);
 }
 
 Tableau<double>::Tableau(const Matrix<double> &A, const Array<int> &art, 
 			 const Vector<double> &b)
-  : TableauInterface<double>(A,art,b), B(*this), tmpcol(b.First(),b.Last())
+  : TableauInterface<double>(A,art,b), B(*this), tmpcol(b.First(),b.Last()),
+    m_dense(false), m_rows(0), m_width(0), m_refactor(0), m_sinceRefactor(0)
 {
   Solve(b, solution);
 }
 
 
 Tableau<double>::Tableau(const Tableau<double> &orig)
-  : TableauInterface<double>(orig), B(orig.B,*this), tmpcol(orig.tmpcol)
+  : TableauInterface<double>(orig), B(orig.B,*this), tmpcol(orig.tmpcol),
+    m_dense(orig.m_dense), m_rows(orig.m_rows), m_width(orig.m_width),
+    m_tab(orig.m_tab), m_scratch(orig.m_scratch),
+    m_refactor(orig.m_refactor), m_sinceRefactor(orig.m_sinceRefactor)
 { }
 
 Tableau<double>::~Tableau()
@@ -59,6 +67,13 @@ Tableau<double>& Tableau<double>::operator=(const Tableau<double> &orig)
   if(this!= &orig) {
     B.Copy(orig.B,*this);
     tmpcol = orig.tmpcol;
+    m_dense = orig.m_dense;
+    m_rows = orig.m_rows;
+    m_width = orig.m_width;
+    m_tab = orig.m_tab;
+    m_scratch = orig.m_scratch;
+    m_refactor = orig.m_refactor;
+    m_sinceRefactor = orig.m_sinceRefactor;
   }
   return *this;
 }
@@ -84,6 +99,25 @@ void Tableau<double>::Pivot(int outrow,int col)
   // gout << " outlabel: " << outlabel;
   // gout << " inlabel: " << col;
   // BigDump(gout);
+  if (m_dense) {
+    // As LUdecomp::update() does, refactor from the new basis rather
+    // than updating once enough pivots have accumulated
+    int interval = (m_refactor > 0) ? m_refactor : std::max(50, 2 * m_rows);
+    if (m_refactor >= 0 && ++m_sinceRefactor >= interval) {
+      basis.Pivot(outrow,col);
+      DenseFactor();
+    }
+    else {
+      DensePivot(outrow - MinRow(), DenseColumn(col));
+      basis.Pivot(outrow,col);
+    }
+    for (int i = 0; i < m_rows; i++) {
+      solution[MinRow() + i] = m_tab[i * m_width + m_width - 1];
+    }
+    npivots++;
+    return;
+  }
+
   basis.Pivot(outrow,col);
   
   B.update(outrow, col);
@@ -94,10 +128,17 @@ void Tableau<double>::Pivot(int outrow,int col)
 
 void Tableau<double>::SolveColumn(int col, Vector<double> &out)
 {
-  //** can we use tmpcol here, instead of allocating new vector?
-  Vector<double> tmpcol2(MinRow(),MaxRow());
-  GetColumn(col,tmpcol2);
-  Solve(tmpcol2,out);
+  if (m_dense) {
+    int j = DenseColumn(col);
+    for (int i = 0; i < m_rows; i++) {
+      out[MinRow() + i] = m_tab[i * m_width + j];
+    }
+    return;
+  }
+  // Solve() allows its arguments to be the same vector, so this
+  // is safe even when out is tmpcol
+  GetColumn(col,tmpcol);
+  Solve(tmpcol,out);
 }
 
 void Tableau<double>::BasisVector(Vector<double> &out) const
@@ -111,7 +152,12 @@ void Tableau<double>::BasisVector(Vector<double> &out) const
 
 void Tableau<double>::Refactor()
 {
-  B.refactor();
+  if (m_dense) {
+    DenseFactor();
+  }
+  else {
+    B.refactor();
+  }
   //** is re-solve necessary here?
   Solve(*b, solution);
 }
@@ -119,6 +165,26 @@ void Tableau<double>::Refactor()
 void Tableau<double>::SetRefactor(int n)
 {
   B.SetRefactor(n);
+  m_refactor = n;
+}
+
+void Tableau<double>::SetDense(bool p_dense)
+{
+  if (p_dense == m_dense)  return;
+  m_dense = p_dense;
+  if (m_dense) {
+    m_rows = MaxRow() - MinRow() + 1;
+    m_width = m_rows + (MaxCol() - MinCol() + 1) + 1;
+    m_tab.resize(m_rows * m_width);
+    m_scratch.resize(m_rows);
+    DenseFactor();
+  }
+  else {
+    m_tab.clear();
+    m_scratch.clear();
+    B.refactor();
+  }
+  Solve(*b, solution);
 }
 
 void Tableau<double>::SetConst(const Vector<double> &bnew)
@@ -127,26 +193,68 @@ void Tableau<double>::SetConst(const Vector<double> &bnew)
     throw DimensionException();
   b=&bnew;
   Solve(*b, solution);
+  if (m_dense) {
+    for (int i = 0; i < m_rows; i++) {
+      m_tab[i * m_width + m_width - 1] = solution[MinRow() + i];
+    }
+  }
 }
 
 //** this function is not currently used.  Drop it?
 void Tableau<double>::SetBasis(const Basis &in)
 {
   basis= in;
-  B.refactor();
+  if (m_dense) {
+    DenseFactor();
+  }
+  else {
+    B.refactor();
+  }
   Solve(*b, solution);
 }
 
 void Tableau<double>::Solve(const Vector<double> &b, Vector<double> &x)
 {
-  B.solve(b,x);
+  if (!m_dense) {
+    B.solve(b,x);
+    return;
+  }
+  // The slack columns of the tableau are the basis inverse.
+  // b is copied first since it may be the same vector as x.
+  for (int k = 0; k < m_rows; k++) {
+    m_scratch[k] = b[MinRow() + k];
+  }
+  for (int i = 0; i < m_rows; i++) {
+    const double *row = &m_tab[i * m_width];
+    double sum = 0.0;
+    for (int k = 0; k < m_rows; k++) {
+      sum += row[k] * m_scratch[k];
+    }
+    x[MinRow() + i] = sum;
+  }
 }
 
 void Tableau<double>::SolveT(const Vector<double> &c, Vector<double> &y)
 {
-  B.solveT(c,y);
-  //** gout << "\nTableau<double>::SolveT(), y: " << y;
-  //   gout << "\nc: " << c;
+  if (!m_dense) {
+    B.solveT(c,y);
+    //** gout << "\nTableau<double>::SolveT(), y: " << y;
+    //   gout << "\nc: " << c;
+    return;
+  }
+  for (int i = 0; i < m_rows; i++) {
+    m_scratch[i] = c[MinRow() + i];
+  }
+  y = 0.0;
+  double *out = &y[MinRow()];
+  for (int i = 0; i < m_rows; i++) {
+    const double f = m_scratch[i];
+    if (f == 0.0)  continue;
+    const double *row = &m_tab[i * m_width];
+    for (int k = 0; k < m_rows; k++) {
+      out[k] += f * row[k];
+    }
+  }
 }
 
 bool Tableau<double>::IsFeasible()
@@ -171,6 +279,106 @@ bool Tableau<double>::IsLexMin()
   return 1;
 }
 
+//
+// dense tableau functions
+//
+
+// Offset of the column for label in each row of the dense tableau
+int Tableau<double>::DenseColumn(int label) const
+{
+  return (label < 0) ? (-label - MinRow()) : (m_rows + label - MinCol());
+}
+
+// Gauss-Jordan elimination on row 'row', column 'col' (both zero-based).
+// This is the rank-one update  T -= (T e_col - e_row) (e_row' T) / T(row,col),
+// applied in place one contiguous row at a time so the inner loop
+// vectorizes.
+void Tableau<double>::DensePivot(int row, int col)
+{
+  double *__restrict__ prow = &m_tab[row * m_width];
+  const double piv = prow[col];
+  if (piv == 0.0)  throw BadPivot();
+  const int width = m_width;
+  for (int j = 0; j < width; j++) {
+    prow[j] /= piv;
+  }
+  prow[col] = 1.0;
+
+  for (int i = 0; i < m_rows; i++) {
+    if (i == row)  continue;
+    double *__restrict__ trow = &m_tab[i * m_width];
+    const double f = trow[col];
+    if (f == 0.0)  continue;
+#if defined(_OPENMP) && _OPENMP >= 201307
+#pragma omp simd
+#endif
+    for (int j = 0; j < width; j++) {
+      trow[j] -= f * prow[j];
+    }
+    trow[col] = 0.0;
+  }
+}
+
+// Rebuilds the dense tableau for the current basis from the original
+// data, so rounding errors from successive pivots do not accumulate.
+// Basis columns are eliminated with partial pivoting, structural ones
+// first, and the rows are then put back in basis order.
+void Tableau<double>::DenseFactor()
+{
+  std::fill(m_tab.begin(), m_tab.end(), 0.0);
+  for (int i = 0; i < m_rows; i++) {
+    double *row = &m_tab[i * m_width];
+    row[i] = 1.0;
+    for (int j = MinCol(); j <= MaxCol(); j++) {
+      if (IsArtifColumn(j)) {
+	if (artificial[j] == MinRow() + i) {
+	  row[m_rows + j - MinCol()] = 1.0;
+	}
+      }
+      else {
+	row[m_rows + j - MinCol()] = (*A)(MinRow() + i, j);
+      }
+    }
+    row[m_width - 1] = (*b)[MinRow() + i];
+  }
+
+  std::vector<int> rowOf(m_rows, -1), posOf(m_rows, -1);
+  for (int pass = 0; pass < 2; pass++) {
+    for (int k = 0; k < m_rows; k++) {
+      int label = basis.Label(MinRow() + k);
+      if ((pass == 0) == (label < 0))  continue;
+      int col = DenseColumn(label);
+      int best = -1;
+      double bestval = 0.0;
+      for (int i = 0; i < m_rows; i++) {
+	if (posOf[i] < 0 && std::fabs(m_tab[i * m_width + col]) > bestval) {
+	  best = i;
+	  bestval = std::fabs(m_tab[i * m_width + col]);
+	}
+      }
+      if (best < 0)  throw BadPivot();
+      DensePivot(best, col);
+      rowOf[k] = best;
+      posOf[best] = k;
+    }
+  }
+
+  // Row rowOf[k] now belongs to basis position k; swap rows into place
+  for (int k = 0; k < m_rows; k++) {
+    int i = rowOf[k];
+    if (i == k)  continue;
+    std::swap_ranges(m_tab.begin() + k * m_width,
+		     m_tab.begin() + (k + 1) * m_width,
+		     m_tab.begin() + i * m_width);
+    int other = posOf[k];
+    rowOf[other] = i;
+    posOf[i] = other;
+    rowOf[k] = k;
+    posOf[k] = k;
+  }
+  m_sinceRefactor = 0;
+}
+
 
 // ---------------------------------------------------------------------------
 //                   Tableau<gbtRational> method definitions
@@ -194,18 +402,95 @@ Integer find_lcd(const Vector<Rational> &vec)
   return lcd;
 }
 
+// Checked machine-word arithmetic for the fraction-free pivot.  These
+// return true if the result does not fit in a long.
+
+static inline bool MulOverflow(long a, long b, long &r)
+{
+#if defined(__GNUC__) && (__GNUC__ >= 5 || defined(__clang__))
+  return __builtin_mul_overflow(a, b, &r);
+#else
+  if (a == 0 || b == 0) { r = 0; return false; }
+  if ((a == -1 && b == LONG_MIN) || (b == -1 && a == LONG_MIN)) return true;
+  if (a > 0 ? (b > 0 ? a > LONG_MAX / b : b < LONG_MIN / a)
+            : (b > 0 ? a < LONG_MIN / b : -a > LONG_MAX / -b)) return true;
+  r = a * b;
+  return false;
+#endif
+}
+
+static inline bool SubOverflow(long a, long b, long &r)
+{
+#if defined(__GNUC__) && (__GNUC__ >= 5 || defined(__clang__))
+  return __builtin_sub_overflow(a, b, &r);
+#else
+  if ((b > 0 && a < LONG_MIN + b) || (b < 0 && a > LONG_MAX + b)) return true;
+  r = a - b;
+  return false;
+#endif
+}
+
+// Computes (p*a - r*c)/d, which is exact in a fraction-free pivot.
+// Where the compiler has a 128-bit type, the products are retried in
+// it before giving up, since the quotient is often much smaller than
+// they are.
+static inline bool PivotOverflow(long p, long a, long r, long c, long d,
+				 long &out)
+{
+  long x, y, z;
+  if (!MulOverflow(p, a, x) && !MulOverflow(r, c, y) && 
+      !SubOverflow(x, y, z) && !(d == -1 && z == LONG_MIN)) {
+    out = z / d;
+    return false;
+  }
+#ifdef __SIZEOF_INT128__
+  __int128 q = ((__int128) p * a - (__int128) r * c) / d;
+  if (q >= LONG_MIN && q <= LONG_MAX) {
+    out = (long) q;
+    return false;
+  }
+#endif  // __SIZEOF_INT128__
+  return true;
+}
+
+void Tableau<Rational>::InitEntries(void)
+{
+  m_cols = MaxCol() - MinCol() + 1;
+  int size = (MaxRow() - MinRow() + 1) * (m_cols + 1);
+  m_small.assign(size, 0);
+  m_isBig.assign(size, 0);
+  m_big.clear();
+}
+
+void Tableau<Rational>::SetEntry(int index, const Integer &x)
+{
+  if (x.fits_in_long()) {
+    // A demoted entry keeps its Integer, whose storage is reused if
+    // the entry is promoted again
+    m_small[index] = x.as_long();
+    m_isBig[index] = 0;
+  }
+  else {
+    if (m_big.empty()) {
+      m_big.resize(m_small.size());
+    }
+    m_big[index] = x;
+    m_isBig[index] = 1;
+  }
+}
+
 // Constructors and Destructor
  
 Tableau<Rational>::Tableau(const Matrix<Rational> &A, 
 			    const Vector<Rational> &b) 
   : TableauInterface<Rational>(A,b), 
-    Tabdat(A.MinRow(),A.MaxRow(),A.MinCol(),A.MaxCol()),
-    Coeff(b.First(),b.Last()), denom(1), tmpcol(b.First(),b.Last()), 
+    denom(1), tmpcol(b.First(),b.Last()), 
     nonbasic(A.MinCol(),A.MaxCol())
 {
   int j;
   for(j=MinCol();j<=MaxCol();j++) 
     nonbasic[j] = j;
+  InitEntries();
   
   totdenom = lcm(find_lcd(A),find_lcd(b));
   if(totdenom<=0) throw BadDenom();
@@ -213,29 +498,29 @@ Tableau<Rational>::Tableau(const Matrix<Rational> &A,
   for (int i = b.First();i<=b.Last();i++) {
     Rational x = b[i]*(Rational)totdenom;
     if(x.denominator() != 1) throw BadDenom();
-    Coeff[i] = x.numerator();
+    SetEntry(CoeffIndex(i), x.numerator());
   }
   for (int i = MinRow();i<=MaxRow();i++) 
     for (int j = MinCol();j<=MaxCol();j++) {
       Rational x = A(i,j)*(Rational)totdenom;
       if(x.denominator() != 1) throw BadDenom();
-      Tabdat(i,j) = x.numerator();
+      SetEntry(Index(i,j), x.numerator());
     }
   for (int i = b.First();i<=b.Last();i++) 
-    solution[i] = (Rational)Coeff[i];
+    solution[i] = (Rational)Entry(CoeffIndex(i));
 }
 
 Tableau<Rational>::Tableau(const Matrix<Rational> &A, 
 			    const Array<int> &art, 
 			    const Vector<Rational> &b) 
   : TableauInterface<Rational>(A,art,b), 
-    Tabdat(A.MinRow(),A.MaxRow(),A.MinCol(),A.MaxCol()+art.Length()),
-    Coeff(b.First(),b.Last()), denom(1), tmpcol(b.First(),b.Last()), 
+    denom(1), tmpcol(b.First(),b.Last()), 
     nonbasic(A.MinCol(),A.MaxCol()+art.Length())
 {
   int j;
   for(j=MinCol();j<=MaxCol();j++) 
     nonbasic[j] = j;
+  InitEntries();
   
   totdenom = lcm(find_lcd(A),find_lcd(b));
   if(totdenom<=0) throw BadDenom();
@@ -243,24 +528,25 @@ Tableau<Rational>::Tableau(const Matrix<Rational> &A,
   for (int i = b.First();i<=b.Last();i++) {
     Rational x = b[i]*(Rational)totdenom;
     if(x.denominator() != 1) throw BadDenom();
-    Coeff[i] = x.numerator();
+    SetEntry(CoeffIndex(i), x.numerator());
   }
   for (int i = MinRow();i<=MaxRow();i++) {
     for (int j = MinCol();j<=A.MaxCol();j++) {
       Rational x = A(i,j)*(Rational)totdenom;
       if(x.denominator() != 1) throw BadDenom();
-      Tabdat(i,j) = x.numerator();
+      SetEntry(Index(i,j), x.numerator());
     }
-    for (int j = A.MaxCol()+1;j<=MaxCol();j++)
-      Tabdat(artificial[j],j) = totdenom;
   }
+  for (int j = A.MaxCol()+1;j<=MaxCol();j++)
+    SetEntry(Index(artificial[j],j), totdenom);
   for (int i = b.First();i<=b.Last();i++) 
-    solution[i] = (Rational)Coeff[i];
+    solution[i] = (Rational)Entry(CoeffIndex(i));
 }
 
 
 Tableau<Rational>::Tableau(const Tableau<Rational> &orig) 
-  : TableauInterface<Rational>(orig), Tabdat(orig.Tabdat), Coeff(orig.Coeff), 
+  : TableauInterface<Rational>(orig), m_cols(orig.m_cols),
+    m_small(orig.m_small), m_isBig(orig.m_isBig), m_big(orig.m_big),
     totdenom(orig.totdenom), denom(orig.denom), 
     tmpcol(orig.tmpcol), nonbasic(orig.nonbasic)
 { }
@@ -272,8 +558,10 @@ Tableau<Rational>& Tableau<Rational>::operator=(const Tableau<Rational> &orig)
 {
   TableauInterface<Rational>::operator=(orig);
   if(this!= &orig) {
-    Tabdat = orig.Tabdat;
-    Coeff = orig.Coeff;
+    m_cols = orig.m_cols;
+    m_small = orig.m_small;
+    m_isBig = orig.m_isBig;
+    m_big = orig.m_big;
     totdenom = orig.totdenom;
     denom = orig.denom;
     tmpcol = orig.tmpcol;
@@ -292,15 +580,45 @@ int Tableau<Rational>::remap(int col_index) const
   return i;
 }
 
-Matrix<Rational> Tableau<Rational>::GetInverse()
+// Computes out = V * v, where V = |denom| * M inverse.  The column of V
+// for a basic slack is a unit column scaled by |denom|; the others are
+// the slack columns of the tableau.  V is integral, so this is done
+// entirely in Integers.
+
+void Tableau<Rational>::MultiplyInverse(const Vector<Integer> &v,
+					Vector<Integer> &out) const
+{
+  Integer absdenom = abs(denom), t, te;
+  int s = sign(denom) * sign(totdenom);
+  out = Integer(0);
+  for (int j = MinRow(); j <= MaxRow(); j++) {
+    if (sign(v[j]) == 0) continue;
+    if (Member(-j)) {
+      mul(absdenom, v[j], t);
+      add(out[Find(-j)], t, out[Find(-j)]);
+    }
+    else {
+      int col = remap(-j);
+      for (int i = MinRow(); i <= MaxRow(); i++) {
+	mul(EntryRef(Index(i,col), te), v[j], t);
+	if (s < 0) sub(out[i], t, out[i]);
+	else add(out[i], t, out[i]);
+      }
+    }
+  }
+}
+
+// Returns the least common denominator of p_vector, and its numerators
+// over it in p_numer
+
+static Integer ScaleToIntegers(const Vector<Rational> &p_vector,
+			       Vector<Integer> &p_numer)
 {
-  Vector<Rational> mytmpcol(tmpcol.First(),tmpcol.Last());
-  Matrix<Rational> inv(MinRow(),MaxRow(),MinRow(),MaxRow());
-  for(int i=inv.MinCol();i<=inv.MaxCol();i++){
-    MySolveColumn(-i,mytmpcol);
-    inv.SetColumn(i,mytmpcol);
+  Integer lcd = find_lcd(p_vector);
+  for (int i = p_vector.First(); i <= p_vector.Last(); i++) {
+    p_numer[i] = p_vector[i].numerator() * (lcd / p_vector[i].denominator());
   }
-  return inv;
+  return lcd;
 }
 
 
@@ -308,11 +626,10 @@ Matrix<Rational> Tableau<Rational>::GetInverse()
 
 bool Tableau<Rational>::CanPivot(int outlabel, int col) const
 {
-  const_cast<Tableau<Rational> *>(this)->MySolveColumn(col,tmpcol);
-  Rational val = tmpcol[basis.Find(outlabel)];
-  if(val == (Rational)0) return 0;
-  //   if(val <=eps2 && val >= -eps2) return 0;
-  return 1;  
+  int row = basis.Find(outlabel);
+  if (Member(col)) return (Find(col) == row);
+  int k = Index(row, remap(col));
+  return (m_isBig[k] || m_small[k] != 0);
 }
 
 void Tableau<Rational>::Pivot(int outrow,int in_col)
@@ -354,36 +671,82 @@ void Tableau<Rational>::Pivot(int outrow,int in_col)
   // 4: d=Ci*j* (done last)
 
   // Step 3
+  //
+  // The coefficients are the last column of each row, so they are
+  // updated along with the rest of the row.  Each entry is first tried
+  // in machine arithmetic; if that overflows, or if any operand is
+  // already an Integer, it is computed with Integers instead, using
+  // scratch Integers to avoid allocating for every entry.
+
+  int width = m_cols + 1;
+  int pc = col - MinCol();
+  int kp = (row - MinRow()) * width;
+  bool smallDenom = denom.fits_in_long();
+  long d = denom.as_long();
+  long p = m_small[kp + pc];
+  // Promoting an entry may allocate m_big, so the pivot and column
+  // entries are copied rather than referenced
+  Integer P = Entry(kp + pc), C, ta, tr, t1, t2;
   
-  for(i=Tabdat.MinRow();i<=Tabdat.MaxRow();++i){
+  for(i=MinRow();i<=MaxRow();++i){
     if(i!=row){
-      for(j=Tabdat.MinCol();j<=Tabdat.MaxCol();++j){
-	if(j!=col){
-	  Tabdat(i,j) = (Tabdat(row,col)*Tabdat(i,j)-Tabdat(row,j)*Tabdat(i,col))/denom;
+      int k = (i - MinRow()) * width;
+      long *trow = &m_small[k], *prow = &m_small[kp];
+      const char *tbig = &m_isBig[k], *pbig = &m_isBig[kp];
+      long c = trow[pc];
+      bool fast = smallDenom && !pbig[pc] && !tbig[pc];
+      bool haveC = false;
+      for(j=0;j<width;++j){
+	if(j!=pc){
+	  long x;
+	  if (fast && !tbig[j] && !pbig[j] &&
+	      !PivotOverflow(p, trow[j], prow[j], c, d, x)) {
+	    trow[j] = x;
+	  }
+	  else {
+	    if (!haveC) {
+	      C = Entry(k + pc);
+	      haveC = true;
+	    }
+	    mul(P, EntryRef(k + j, ta), t1);
+	    mul(EntryRef(kp + j, tr), C, t2);
+	    sub(t1, t2, t1);
+	    div(t1, denom, t2);
+	    SetEntry(k + j, t2);
+	  }
 	}
       }
-      Coeff[i] = (Tabdat(row,col)*Coeff[i]-Coeff[row]*Tabdat(i,col))/denom;
     }
   }
   // Step 2
   // Note: here we are moving the old basis column into column 'col'
-  for(i=Tabdat.MinRow();i<=Tabdat.MaxRow();++i){
-    if(i!=row)
-      Tabdat(i,col)=-Tabdat(i,col);
+  for(i=MinRow();i<=MaxRow();++i){
+    if(i!=row) {
+      int k = Index(i,col);
+      if (m_isBig[k] || m_small[k] == LONG_MIN) {
+	SetEntry(k, -Entry(k));
+      }
+      else {
+	m_small[k] = -m_small[k];
+      }
+    }
   }
   // Step 4
   Integer old_denom = denom;
-  denom=Tabdat(row,col);
-  Tabdat(row,col)=old_denom;
+  denom=Entry(Index(row,col));
+  SetEntry(Index(row,col), old_denom);
   // BigDump(gout);
   npivots++;
 
   basis.Pivot(outrow,in_col);
   nonbasic[col] = outlabel;
   
-  for (i = solution.First();i<=solution.Last();i++) 
+  int s = sign(denom) * sign(totdenom);
+  for (i = solution.First();i<=solution.Last();i++) {
     //** solution[i] = (Rational)(Coeff[i])/(Rational)(denom*totdenom);
-    solution[i] = Rational(Coeff[i]*sign(denom*totdenom));
+    solution[i] = Rational(Entry(CoeffIndex(i)));
+    if (s < 0) solution[i] = -solution[i];
+  }
 
   //gout << "Bottom \n" << Tabdat << '\n';
   // BigDump(gout);
@@ -396,35 +759,30 @@ void Tableau<Rational>::Pivot(int outrow,int in_col)
 
 void Tableau<Rational>::SolveColumn(int in_col, Vector<Rational> &out)
 {
-  Vector<Integer> tempcol(tmpcol.First(),tmpcol.Last());
   if(Member(in_col)) {
     out = (Rational)0;
-    out[Find(in_col)] = Rational(abs(denom));
+    out[Find(in_col)] = (Rational)1;
+    return;
   }
-  else {
-    int col = remap(in_col);
-    Tabdat.GetColumn(col,tempcol);
-    for(int i=tempcol.First();i<=tempcol.Last();i++)
-      out[i] = (Rational)(tempcol[i]) * (Rational)(sign(denom*totdenom));
-  }
-  out=out/(Rational)abs(denom);
-  if(in_col < 0) out*=totdenom;
-  for(int i=out.First();i<=out.Last();i++) 
-    if(Label(i)<0) out[i]=(Rational)out[i]/(Rational)totdenom;
-}
 
-void Tableau<Rational>::MySolveColumn(int in_col, Vector<Rational> &out)
-{
-  Vector<Integer> tempcol(tmpcol.First(),tmpcol.Last());
-  if(Member(in_col)) {
-    out = (Rational)0;
-    out[Find(in_col)] = Rational(abs(denom));
-  }
-  else {
-    int col = remap(in_col);
-    Tabdat.GetColumn(col,tempcol);
-    for(int i=tempcol.First();i<=tempcol.Last();i++)
-      out[i] = (Rational)(tempcol[i]) * (Rational)(sign(denom*totdenom));
+  // Each entry is the tableau entry over |denom|; slack columns are
+  // scaled up by totdenom, and slack rows down by it.  Building each
+  // entry as a single fraction normalizes it only once.
+  int col = remap(in_col);
+  int s = sign(denom) * sign(totdenom);
+  Integer absdenom = abs(denom), num, den;
+  for(int i=out.First();i<=out.Last();i++) {
+    num = Entry(Index(i,col));
+    if (s < 0) num = -num;
+    if ((in_col < 0) == (Label(i) < 0)) {
+      out[i] = Rational(num, absdenom);
+    }
+    else if (in_col < 0) {
+      out[i] = Rational(num * totdenom, absdenom);
+    }
+    else {
+      out[i] = Rational(num, absdenom * totdenom);
+    }
   }
 }
 
@@ -445,32 +803,34 @@ void Tableau<Rational>::Refactor()
   if(totdenom<=0) throw BadDenom();
   // gout << "\ndenom: " << denom << " totdenom: " << totdenom;
 
+  // The new tableau is V times the original columns, where V is the
+  // scaled basis inverse.  V is read from the current entries, so the
+  // new columns are all computed before any is stored.
   int i,j;
-  Matrix<Rational> inv(GetInverse());
-  Matrix<Rational> Tabnew(Tabdat.MinRow(),Tabdat.MaxRow(),Tabdat.MinCol(),Tabdat.MaxCol());
-  for(i=nonbasic.First();i<=nonbasic.Last();i++) {
-    GetColumn(nonbasic[i],mytmpcol);
-    //    if(nonbasic[i]>=0) mytmpcol*=Rational(totdenom);
-    Tabnew.SetColumn(i,inv * mytmpcol * (Rational)sign(denom*totdenom));
-    //gout << "\nMyTmpCol \n" << mytmpcol;
-  }
-
-  //gout << "\nInv: \n" << inv;
-  //gout << "\nTabdat:\n" << Tabdat;
-  //gout << "\nTabnew:\n" << Tabnew;
-
-  Vector<Rational> Coeffnew(Coeff.First(),Coeff.Last());
-  Coeffnew = inv * (*b) * totdenom * (Rational)sign(denom*totdenom);
-
-  //gout << "\nCoeff:\n" << Coeff;
-  //gout << "\nCoeffew:\n" << Coeffnew;
-
-  for(i=Tabdat.MinRow();i<=Tabdat.MaxRow();i++) {
-    if(Coeffnew[i].denominator() != 1) throw BadDenom();
-    Coeff[i] = Coeffnew[i].numerator();
-    for(j=Tabdat.MinCol();j<=Tabdat.MaxCol();j++) {
-      if(Tabnew(i,j).denominator() != 1) throw BadDenom();
-      Tabdat(i,j) = Tabnew(i,j).numerator();
+  int s = sign(denom) * sign(totdenom);
+  Matrix<Integer> Tabnew(MinRow(),MaxRow(),MinCol(),MaxCol()+1);
+  Vector<Integer> numer(MinRow(),MaxRow()), prod(MinRow(),MaxRow());
+  for(i=nonbasic.First();i<=nonbasic.Last()+1;i++) {
+    if (i <= nonbasic.Last()) {
+      GetColumn(nonbasic[i],mytmpcol);
+    }
+    else {
+      mytmpcol = *b * (Rational)totdenom;
+    }
+    Integer lcd = ScaleToIntegers(mytmpcol, numer);
+    MultiplyInverse(numer, prod);
+    for (j = MinRow(); j <= MaxRow(); j++) {
+      Integer q, r;
+      divide(prod[j], lcd, q, r);
+      if (sign(r) != 0) throw BadDenom();
+      Tabnew(j,i) = (s < 0) ? -q : q;
+    }
+  }
+
+  for(i=MinRow();i<=MaxRow();i++) {
+    SetEntry(CoeffIndex(i), Tabnew(i,MaxCol()+1));
+    for(j=MinCol();j<=MaxCol();j++) {
+      SetEntry(Index(i,j), Tabnew(i,j));
     }
   }
   //BigDump(gout);
@@ -498,15 +858,40 @@ void Tableau<Rational>::SetBasis(const Basis &in)
  // solve M x = b
 void Tableau<Rational>::Solve(const Vector<Rational> &b, Vector<Rational> &x)
 {
-  // Here, we do x = V * b, where V = M inverse
-  x = (GetInverse() * b )/(Rational)abs(denom);
+  // Here, we do x = V * b / |denom|, where V = |denom| * M inverse,
+  // over the common denominator of b
+  Vector<Integer> numer(MinRow(),MaxRow()), prod(MinRow(),MaxRow());
+  Integer den = ScaleToIntegers(b, numer) * abs(denom);
+  MultiplyInverse(numer, prod);
+  for (int i = x.First(); i <= x.Last(); i++) {
+    x[i] = Rational(prod[i], den);
+  }
 }
 
  // solve y M = c
 void Tableau<Rational>::SolveT(const Vector<Rational> &c, Vector<Rational> &y)
 {
-  // Here we do y = c * V, where V = M inverse
-  y = (c * GetInverse()) /(Rational)abs(denom);
+  // Here we do y = c * V / |denom|, where V = |denom| * M inverse.
+  // A basic slack contributes a unit column of V, so picks out an
+  // entry of c; the other columns of V are read from the tableau.
+  Vector<Integer> numer(MinRow(),MaxRow());
+  Integer den = ScaleToIntegers(c, numer) * abs(denom);
+  int s = sign(denom) * sign(totdenom);
+  Integer sum, t, te;
+  for (int j = y.First(); j <= y.Last(); j++) {
+    if (Member(-j)) {
+      y[j] = c[Find(-j)];
+      continue;
+    }
+    int col = remap(-j);
+    sum = Integer(0);
+    for (int i = MinRow(); i <= MaxRow(); i++) {
+      if (sign(numer[i]) == 0) continue;
+      mul(EntryRef(Index(i,col), te), numer[i], t);
+      add(sum, t, sum);
+    }
+    y[j] = Rational((s < 0) ? -sum : sum, den);
+  }
 }
 
 bool Tableau<Rational>::IsFeasible()
@@ -531,10 +916,14 @@ bool Tableau<Rational>::IsLexMin()
 
 void Tableau<Rational>::BasisVector(Vector<Rational> &out) const
 {
-  out = solution;
-  out= out/(Rational)abs(denom) ;
+  // The solution is integral; each entry is divided by |denom|, and
+  // slack entries by totdenom as well
+  Integer absdenom = abs(denom);
+  Integer slackdenom = absdenom * totdenom;
   for(int i=out.First();i<=out.Last();i++) 
-    if(Label(i)<0) out[i]=out[i]/(Rational)totdenom;
+    out[i] = Rational(solution[i].numerator(), 
+		      solution[i].denominator() *
+		      ((Label(i) < 0) ? slackdenom : absdenom));
 }
 
 Integer Tableau<Rational>::TotDenom() const
@@ -0,0 +1,88 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2016, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: library/src/multirun.h
+// Utilities for solvers which combine the equilibria of several runs
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#ifndef LIBGAMBIT_MULTIRUN_H
+#define LIBGAMBIT_MULTIRUN_H
+
+#include <cmath>
+#ifdef _OPENMP
+#include <omp.h>
+#else
+#include <sys/time.h>
+#endif  // _OPENMP
+
+#include "gambit/gambit.h"
+
+namespace Gambit {
+namespace Nash {
+
+/// Equilibria found by different runs closer than this in every
+/// probability are by default taken to be the same
+const double EQUILIBRIUM_TOLERANCE = 1e-6;
+
+/// Returns the elapsed (not processor) time in seconds since some
+/// fixed point in the past
+inline double WallClock(void)
+{
+#ifdef _OPENMP
+  return omp_get_wtime();
+#else
+  struct timeval now;
+  gettimeofday(&now, 0);
+  return (double) now.tv_sec + (double) now.tv_usec / 1000000.0;
+#endif  // _OPENMP
+}
+
+/// The number of probabilities in a profile
+template <class T>
+inline int ProfileLength(const MixedStrategyProfile<T> &p_profile)
+{ return p_profile.MixedProfileLength(); }
+
+template <class T>
+inline int ProfileLength(const MixedBehaviorProfile<T> &p_profile)
+{ return p_profile.Length(); }
+
+/// Returns true if p_profile differs from each of the equilibria in
+/// p_found by more than p_tolerance in some probability.  Solvers which
+/// stop short of the exact equilibrium pass a tolerance suited to their
+/// accuracy.
+template <class Profile>
+bool IsNewEquilibrium(const List<Profile> &p_found, const Profile &p_profile,
+		      double p_tolerance = EQUILIBRIUM_TOLERANCE)
+{
+  for (size_t i = 1; i <= p_found.size(); i++) {
+    const Profile &q = p_found[i];
+    int k = 1;
+    for (; k <= ProfileLength(q) &&
+	   std::fabs((double) (q[k] - p_profile[k])) <= p_tolerance;
+	 k++);
+    if (k > ProfileLength(q)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // end namespace Gambit::Nash
+}  // end namespace Gambit
+
+#endif  // LIBGAMBIT_MULTIRUN_H
@@ -20,7 +20,13 @@
 // Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
 //
 
+#include <algorithm>
+#include <exception>
+#include <map>
+#include <vector>
+
 #include "gambit/nash.h"
+#include "gambit/gametree.h"
 
 namespace Gambit {
 
@@ -219,8 +225,9 @@ BehavViaStrategySolver<T>::Solve(const BehaviorSupportProfile &p_support) const
 
 template <class T>
 SubgameBehavSolver<T>::SubgameBehavSolver(shared_ptr<BehavSolver<T> > p_solver,
-						  shared_ptr<StrategyProfileRenderer<T> > p_onEquilibrium /* = 0 */)
-  : BehavSolver<T>(p_onEquilibrium), m_solver(p_solver)
+					  shared_ptr<StrategyProfileRenderer<T> > p_onEquilibrium /* = 0 */,
+					  int p_threads /* = 1 */)
+  : BehavSolver<T>(p_onEquilibrium), m_solver(p_solver), m_threads(p_threads)
 { }
 
 // A nested anonymous namespace to privatize these functions 
@@ -242,208 +249,408 @@ void ChildSubgames(const GameNode &p_node, List<GameNode> &p_list)
   }
 }
 
-} // end nested anonymous namespace
+///
+/// A subgame of the game being solved, together with a copy of the
+/// part of it which lies outside its own proper subgames.  In the copy,
+/// the roots of the proper subgames are terminal nodes, whose payoffs
+/// are set to the values of the equilibria chosen in those subgames.
+///
+template <class T> class Subgame {
+public:
+  /// The root of the subgame in the game being solved
+  GameNode m_root;
+  /// Distance from the root of the game, counted in subgames
+  int m_depth;
+  /// Indices of the immediate proper subgames
+  Array<int> m_children;
+  /// The payoffs of the outcome at the root of the subgame
+  Array<T> m_rootPayoffs;
+
+  /// The copy of the subgame, which has no outcome at its root
+  Game m_game;
+  /// The outcomes at the roots of the proper subgames in the copy
+  Array<GameOutcome> m_values;
+  /// For each action in the copy, its index in a profile on the game
+  Array<int> m_actionIndex;
+  /// Describes the copy, up to the values of the proper subgames;
+  /// copies with the same description are the same game
+  std::string m_key;
+};
+
+///
+/// The equilibria found in a subgame, each listed with the payoffs it
+/// gives at the root of the subgame.  The profiles are on the game being
+/// solved, with all probabilities outside the subgame set to zero.
+///
+template <class T> class SubgameSolutions {
+public:
+  bool m_failed;
+  List<DVector<T> > m_profiles;
+  List<Vector<T> > m_values;
+
+  SubgameSolutions(void) : m_failed(false) { }
+};
+
+///
+/// The equilibria computed on a copy of a subgame, in the layout of
+/// the copy, with their payoffs.  These are shared between threads, so
+/// are held in containers which are not modified when read.
+///
+template <class T> class SubgameEquilibria {
+public:
+  std::vector<Vector<T> > m_profiles;
+  std::vector<Vector<T> > m_payoffs;
+};
 
 //
-// Some general notes on the strategy for solving by subgames:
+// Copies the node p_src of the game being solved to the terminal node
+// p_dest of the copy of its subgame, then its successors, stopping at
+// the roots of the proper subgames p_proper.  Information sets are
+// numbered in the order they are first copied; p_infosets maps those
+// of the game to these numbers, and p_copies and p_originals list the
+// copies and the originals in that order.
 //
-// * We work with a *copy* of the original game, which is destroyed
-//   as we go.
-// * Before solving, information set labels on the copy game are
-//   set to unique IDs.  These are used to match up information
-//   sets in the subgames (which are themselves copies) to the
-//   original game.
-// * We only carry around DVectors instead of full MixedBehaviorProfiles,
-//   because MixedBehaviorProfiles allocate space several times the
-//   size of the tree to carry around useful quantities.  These
-//   quantities are irrelevant for this calculation, so we only
-//   store the probabilities, and convert to MixedBehaviorProfiles
-//   at the end of the computation
+template <class T>
+void CopySubgameNode(const GameNode &p_src, const GameNode &p_dest,
+		     const List<GameNode> &p_proper,
+		     std::map<GameInfosetRep *, int> &p_infosets,
+		     Array<GameInfoset> &p_copies,
+		     Array<GameInfoset> &p_originals,
+		     Subgame<T> &p_subgame, std::ostringstream &p_key)
+{
+  Game game = p_dest->GetGame();
+
+  int next = p_subgame.m_values.Length() + 1;
+  if (next <= p_proper.Length() && p_src == p_proper[next]) {
+    GameOutcome outcome = game->NewOutcome();
+    p_dest->SetOutcome(outcome);
+    p_subgame.m_values.Append(outcome);
+    p_key << "v;";
+    return;
+  }
+
+  if (p_src->NumChildren() > 0) {
+    GameInfoset infoset = p_src->GetInfoset();
+    if (p_infosets.count(infoset.operator->())) {
+      int index = p_infosets[infoset.operator->()];
+      p_dest->AppendMove(p_copies[index]);
+      p_key << "m" << index << ";";
+    }
+    else {
+      GamePlayer player = (infoset->IsChanceInfoset()) ? game->GetChance() :
+	game->GetPlayer(infoset->GetPlayer()->GetNumber());
+      GameInfoset copy = p_dest->AppendMove(player, infoset->NumActions());
+      p_key << "i" << player->GetNumber() << "," << infoset->NumActions();
+      if (infoset->IsChanceInfoset()) {
+	for (int act = 1; act <= infoset->NumActions(); act++) {
+	  std::string prob = infoset->GetActionProb(act, "");
+	  copy->SetActionProb(act, prob);
+	  p_key << "," << prob;
+	}
+      }
+      p_key << ";";
+      p_copies.Append(copy);
+      p_originals.Append(infoset);
+      p_infosets[infoset.operator->()] = p_copies.Length();
+    }
+  }
+  else {
+    p_key << "t;";
+  }
+
+  GameOutcome outcome = p_src->GetOutcome();
+  if (outcome && p_src != p_subgame.m_root) {
+    GameOutcome copy = game->NewOutcome();
+    p_key << "o";
+    for (int pl = 1; pl <= game->NumPlayers(); pl++) {
+      std::string payoff = outcome->GetPayoff<std::string>(pl);
+      copy->SetPayoff(pl, payoff);
+      p_key << "," << payoff;
+    }
+    p_key << ";";
+    p_dest->SetOutcome(copy);
+  }
+
+  for (int i = 1; i <= p_src->NumChildren(); i++) {
+    CopySubgameNode(p_src->GetChild(i), p_dest->GetChild(i), p_proper,
+		    p_infosets, p_copies, p_originals, p_subgame, p_key);
+  }
+}
+
 //
+// Builds the copy of the subgame, given the roots of its proper subgames.
+// Profiles on the game being solved are laid out as p_offsets, which
+// gives for each information set the index of its first action less one.
+//
+template <class T>
+void CopySubgame(Subgame<T> &p_subgame, const List<GameNode> &p_proper,
+		 const Array<Array<int> > &p_offsets)
+{
+  Game efg = p_subgame.m_root->GetGame();
+  p_subgame.m_game = NewTree();
+  GameTreeRep &copy = dynamic_cast<GameTreeRep &>(*p_subgame.m_game);
+  copy.SetCanonicalization(false);
+  for (int pl = 1; pl <= efg->NumPlayers(); pl++) {
+    copy.NewPlayer();
+  }
+
+  std::map<GameInfosetRep *, int> infosets;
+  Array<GameInfoset> copies, originals;
+  std::ostringstream key;
+  CopySubgameNode(p_subgame.m_root, copy.GetRoot(), p_proper,
+		  infosets, copies, originals, p_subgame, key);
+  copy.SetCanonicalization(true);
+  p_subgame.m_key = key.str();
+
+  std::map<GameInfosetRep *, GameInfoset> original;
+  for (int i = 1; i <= copies.Length(); i++) {
+    original[copies[i].operator->()] = originals[i];
+  }
+  for (int pl = 1; pl <= copy.NumPlayers(); pl++) {
+    GamePlayer player = copy.GetPlayer(pl);
+    for (int iset = 1; iset <= player->NumInfosets(); iset++) {
+      GameInfoset infoset = original[player->GetInfoset(iset).operator->()];
+      int offset = p_offsets[pl][infoset->GetNumber()];
+      for (int act = 1; act <= infoset->NumActions(); act++) {
+	p_subgame.m_actionIndex.Append(offset + act);
+      }
+    }
+  }
+
+  p_subgame.m_rootPayoffs = Array<T>(efg->NumPlayers());
+  GameOutcome outcome = p_subgame.m_root->GetOutcome();
+  for (int pl = 1; pl <= efg->NumPlayers(); pl++) {
+    p_subgame.m_rootPayoffs[pl] = (outcome) ? outcome->GetPayoff<T>(pl) : T(0);
+  }
+}
 
+//
+// Solves a subgame, given the solutions of its proper subgames.  Every
+// combination of the equilibria of the proper subgames is a scenario,
+// for which the copy is solved with the values of those equilibria in
+// place of the proper subgames.  Copies which are the same game are
+// solved only once; p_equilibria holds the equilibria so far computed,
+// by the description of the game.
+//
 template <class T>
-void SubgameBehavSolver<T>::SolveSubgames(const BehaviorSupportProfile &p_support,
-					      const DVector<T> &p_templateSolution,
-					      GameNode n,
-					      List<DVector<T> > &solns,
-					      List<GameOutcome> &values) const
+void SolveSubgame(const BehavSolver<T> &p_solver,
+		  Subgame<T> &p_subgame,
+		  const std::vector<SubgameSolutions<T> > &p_solutions,
+		  const DVector<T> &p_templateSolution,
+		  std::map<std::string, SubgameEquilibria<T> > &p_equilibria,
+		  SubgameSolutions<T> &p_result)
 {
-  Game efg = p_support.GetGame();
-  
   List<DVector<T> > thissolns;
   thissolns.Append(p_templateSolution);
   ((Vector<T> &) thissolns[1]).operator=(T(0));
-  
-  List<GameNode> subroots;
-  for (int i = 1; i <= n->NumChildren(); i++) {
-    ChildSubgames(n->GetChild(i), subroots);
-  }
-  
-  List<Array<GameOutcome> > subrootvalues;
-  subrootvalues.Append(Array<GameOutcome>(subroots.Length()));
-  
-  for (int i = 1; i <= subroots.Length(); i++)  {
-    //printf("Looking at subgame %d of %d\n", i, subroots.Length());
-    List<DVector<T> > subsolns;
-    List<GameOutcome> subvalues;
-    
-    SolveSubgames(p_support, p_templateSolution,
-		  subroots[i], subsolns, subvalues);
-    
-    if (subsolns.Length() == 0)  {
-      solns = List<DVector<T> >();
+  // For each scenario, the equilibrium chosen in each proper subgame
+  List<Array<int> > choices;
+  choices.Append(Array<int>(p_subgame.m_children.Length()));
+
+  for (int i = 1; i <= p_subgame.m_children.Length(); i++) {
+    const SubgameSolutions<T> &sub = p_solutions[p_subgame.m_children[i]];
+    if (sub.m_failed) {
+      p_result.m_failed = true;
       return;
     }
 
-    //printf("Found %d subsolutions for subgame %d of %d\n", 
-    //subsolns.Length(), i, subroots.Length());
-    
     List<DVector<T> > newsolns;
-    List<Array<GameOutcome> > newsubrootvalues;
-    
-    //printf("Merging with %d existing solutions\n", thissolns.Length());
+    List<Array<int> > newchoices;
     for (int soln = 1; soln <= thissolns.Length(); soln++) {
-      for (int subsoln = 1; subsoln <= subsolns.Length(); subsoln++) {
-	//printf("Merging existing %d with new %d\n", soln, subsoln);
+      for (int subsoln = 1; subsoln <= sub.m_profiles.Length(); subsoln++) {
 	DVector<T> bp(thissolns[soln]);
-	DVector<T> tmp(subsolns[subsoln]);
+	const DVector<T> &tmp = sub.m_profiles[subsoln];
 	for (int j = 1; j <= bp.Length(); j++) {
 	  bp[j] += tmp[j];
 	}
 	newsolns.Append(bp);
-	
-	newsubrootvalues.Append(subrootvalues[soln]);
-	newsubrootvalues[newsubrootvalues.Length()][i] = subvalues[subsoln];
+	newchoices.Append(choices[soln]);
+	newchoices[newchoices.Length()][i] = subsoln;
       }
     }
-    
     thissolns = newsolns;
-    subrootvalues = newsubrootvalues;
-    //printf("Finished solving subgame %d\n", i);
+    choices = newchoices;
   }
-  
-  for (int soln = 1; soln <= thissolns.Length(); soln++)   {
-    //printf("Analyzing scenario %d of %d\n", soln, thissolns.Length());
-    for (int i = 1; i <= subroots.Length(); i++) {
-      subroots[i]->SetOutcome(subrootvalues[soln][i]);
+
+  Game subgame = p_subgame.m_game;
+  for (int soln = 1; soln <= thissolns.Length(); soln++) {
+    std::string key = p_subgame.m_key;
+    for (int i = 1; i <= p_subgame.m_children.Length(); i++) {
+      const Vector<T> &value = 
+	p_solutions[p_subgame.m_children[i]].m_values[choices[soln][i]];
+      for (int pl = 1; pl <= subgame->NumPlayers(); pl++) {
+	std::string payoff = lexical_cast<std::string>(value[pl]);
+	p_subgame.m_values[i]->SetPayoff(pl, payoff);
+	key += "," + payoff;
+      }
     }
-    
-    Game subgame = n->CopySubgame();
-    // this prevents double-counting of outcomes at roots of subgames
-    // by convention, we will just put the payoffs in the parent subgame
-    subgame->GetRoot()->SetOutcome(0);
-
-    BehaviorSupportProfile subsupport(subgame);
-    // Here, we build the support for the subgame
-    /*
-    for (int pl = 1; pl <= subgame->NumPlayers(); pl++)  {
-      GamePlayer subplayer = subgame->GetPlayer(pl);
-      GamePlayer player = p_support.GetGame()->GetPlayer(pl);
-
-      for (int iset = 1; iset <= subplayer->NumInfosets(); iset++) {
-	GameInfoset subinfoset = subplayer->GetInfoset(iset);
-
-	for (int j = 1; j <= player->NumInfosets(); j++) {
-	  GameInfoset infoset = player->GetInfoset(j);
-	  if (subinfoset->GetLabel() == infoset->GetLabel()) {
-	    for (int act = 1; act <= infoset->NumActions(); act++)  {
-	      if (!p_support.Contains(infoset->GetAction(act))) {
-		subsupport.RemoveAction(subinfoset->GetAction(act));
-	      }
-	    }
-	    break;
-	  }
+
+    const SubgameEquilibria<T> *eqa = 0;
+#pragma omp critical(subgame_equilibria)
+    if (p_equilibria.count(key)) {
+      eqa = &p_equilibria[key];
+    }
+
+    if (!eqa) {
+      BehaviorSupportProfile subsupport(subgame);
+      List<MixedBehaviorProfile<T> > sol = p_solver.Solve(subsupport);
+      SubgameEquilibria<T> computed;
+      for (int solno = 1; solno <= sol.Length(); solno++) {
+	Vector<T> profile(sol[solno].Length());
+	for (int j = 1; j <= profile.Length(); j++) {
+	  profile[j] = sol[solno][j];
 	}
+	computed.m_profiles.push_back(profile);
+	Vector<T> payoffs(subgame->NumPlayers());
+	for (int pl = 1; pl <= subgame->NumPlayers(); pl++) {
+	  payoffs[pl] = sol[solno].GetPayoff(pl);
+	}
+	computed.m_payoffs.push_back(payoffs);
+      }
+#pragma omp critical(subgame_equilibria)
+      {
+	if (!p_equilibria.count(key)) {
+	  p_equilibria[key] = computed;
+	}
+	eqa = &p_equilibria[key];
       }
     }
-    */
 
-    List<MixedBehaviorProfile<T> > sol = m_solver->Solve(subsupport);
-    
-    if (sol.Length() == 0)  {
-      solns = List<DVector<T> >();
-      //printf("No solutions found\n");
+    if (eqa->m_profiles.empty()) {
+      p_result.m_failed = true;
       return;
     }
-    
+
     // Put behavior profile in "total" solution here...
-    for (int solno = 1; solno <= sol.Length(); solno++)  {
-      solns.Append(thissolns[soln]);
-      
-      for (int pl = 1; pl <= subgame->NumPlayers(); pl++)  {
-	GamePlayer subplayer = subgame->GetPlayer(pl);
-	GamePlayer player = p_support.GetGame()->GetPlayer(pl);
-
-	for (int iset = 1; iset <= subplayer->NumInfosets(); iset++) {
-	  GameInfoset subinfoset = subplayer->GetInfoset(iset);
-
-	  for (int j = 1; j <= player->NumInfosets(); j++) {
-	    if (subinfoset->GetLabel() == player->GetInfoset(j)->GetLabel()) {
-	      int id = atoi(subinfoset->GetLabel().c_str());
-	      for (int act = 1; act <= subsupport.NumActions(pl, iset); act++) {
-		int actno = subsupport.GetAction(pl, iset, act)->GetNumber();
-		solns[solns.Length()](pl, id, actno) = sol[solno](pl, iset, act);	  
-	      }
-	      break;
-	    }
-	  }
-	}
-      }
-      
-      Vector<T> subval(subgame->NumPlayers());
-      GameOutcome outcome = n->GetOutcome();
-      for (int pl = 1; pl <= subgame->NumPlayers(); pl++)  {
-	subval[pl] = sol[solno].GetPayoff(pl);
-	if (outcome) {
-	  subval[pl] += outcome->GetPayoff<T>(pl);
-        }
+    for (size_t solno = 0; solno < eqa->m_profiles.size(); solno++) {
+      p_result.m_profiles.Append(thissolns[soln]);
+      DVector<T> &profile = p_result.m_profiles[p_result.m_profiles.Length()];
+      const Vector<T> &sol = eqa->m_profiles[solno];
+      for (int j = 1; j <= sol.Length(); j++) {
+	profile[p_subgame.m_actionIndex[j]] = sol[j];
       }
 
-      GameOutcome ov = efg->NewOutcome();
-      for (int pl = 1; pl <= efg->NumPlayers(); pl++) {
-	ov->SetPayoff(pl, lexical_cast<std::string>(subval[pl]));
+      Vector<T> subval(eqa->m_payoffs[solno]);
+      for (int pl = 1; pl <= subval.Length(); pl++) {
+	subval[pl] += p_subgame.m_rootPayoffs[pl];
       }
- 
-      values.Append(ov);
+      p_result.m_values.Append(subval);
     }
-    //printf("Finished with scenario %d of %d; total solutions so far = %d\n",
-    //soln, thissolns.Length(), solns.Length());
   }
-
-  n->DeleteTree();
 }
 
+} // end nested anonymous namespace
+
+//
+// Some general notes on the strategy for solving by subgames:
+//
+// * The game being solved is only read.  Each subgame is copied once,
+//   without its own proper subgames, which are replaced in the copy
+//   by terminal nodes; the payoffs at these nodes are set to the values
+//   of the equilibria of the proper subgames, in turn, and the copy
+//   solved for each.
+// * Subgames are solved deepest first.  The subgames at the same depth
+//   do not depend on each other, and are solved concurrently.
+// * Information sets in the copies are matched to those in the game
+//   as the copies are made, and each action of a copy is mapped
+//   to its place in a profile on the game.
+// * We only carry around DVectors instead of full MixedBehaviorProfiles,
+//   because MixedBehaviorProfiles allocate space several times the
+//   size of the tree to carry around useful quantities.  These
+//   quantities are irrelevant for this calculation, so we only
+//   store the probabilities, and convert to MixedBehaviorProfiles
+//   at the end of the computation
+//
+
 template <class T>
 List<MixedBehaviorProfile<T> > 
 SubgameBehavSolver<T>::Solve(const BehaviorSupportProfile &p_support) const
 {
-  Game efg = p_support.GetGame()->GetRoot()->CopySubgame();
+  Game efg = p_support.GetGame();
 
-  for (int pl = 1; pl <= efg->NumPlayers(); pl++) {
-    for (int iset = 1; iset <= efg->GetPlayer(pl)->NumInfosets(); iset++) {
-      efg->GetPlayer(pl)->GetInfoset(iset)->SetLabel(lexical_cast<std::string>(iset));
+  Array<Array<int> > offsets(efg->NumPlayers());
+  for (int pl = 1, offset = 0; pl <= efg->NumPlayers(); pl++) {
+    GamePlayer player = efg->GetPlayer(pl);
+    offsets[pl] = Array<int>(player->NumInfosets());
+    for (int iset = 1; iset <= player->NumInfosets(); iset++) {
+      offsets[pl][iset] = offset;
+      offset += player->GetInfoset(iset)->NumActions();
+    }
+  }
+
+  // The subgames are listed in preorder, and the game is only read
+  // after this, so that the subgames can be solved concurrently
+  std::vector<Subgame<T> > subgames(1);
+  subgames[0].m_root = efg->GetRoot();
+  subgames[0].m_depth = 0;
+  int maxDepth = 0;
+  for (size_t index = 0; index < subgames.size(); index++) {
+    List<GameNode> proper;
+    GameNode root = subgames[index].m_root;
+    for (int i = 1; i <= root->NumChildren(); i++) {
+      ChildSubgames(root->GetChild(i), proper);
     }
+    for (int i = 1; i <= proper.Length(); i++) {
+      subgames[index].m_children.Append(subgames.size());
+      subgames.push_back(Subgame<T>());
+      subgames.back().m_root = proper[i];
+      subgames.back().m_depth = subgames[index].m_depth + 1;
+      maxDepth = std::max(maxDepth, subgames.back().m_depth);
+    }
+    CopySubgame(subgames[index], proper, offsets);
   }
 
-  BehaviorSupportProfile support(efg);
+  DVector<T> templateSolution(p_support.NumActions());
+  std::vector<SubgameSolutions<T> > results(subgames.size());
+  std::map<std::string, SubgameEquilibria<T> > equilibria;
+  for (int depth = maxDepth; depth >= 0; depth--) {
+    std::vector<int> level;
+    for (size_t index = 0; index < subgames.size(); index++) {
+      if (subgames[index].m_depth == depth) {
+	level.push_back(index);
+      }
+    }
 
-  for (int pl = 1; pl <= efg->NumPlayers(); pl++)  {
-    GamePlayer player = p_support.GetGame()->GetPlayer(pl);
-    for (int iset = 1; iset <= player->NumInfosets(); iset++)  {
-      GameInfoset infoset = player->GetInfoset(iset);
-      for (int act = 1; act <= infoset->NumActions(); act++) {
-	if (!p_support.Contains(infoset->GetAction(act))) {
-	  support.RemoveAction(efg->GetPlayer(pl)->GetInfoset(iset)->GetAction(act));
+    if (m_threads <= 1) {
+      for (size_t i = 0; i < level.size(); i++) {
+	SolveSubgame(*m_solver, subgames[level[i]], results,
+		     templateSolution, equilibria, results[level[i]]);
+      }
+    }
+    else {
+      // Exceptions cannot leave the parallel region, so the first one
+      // raised is kept, and thrown again once all the subgames have
+      // been attempted
+      std::exception_ptr error;
+#pragma omp parallel for schedule(dynamic) num_threads(m_threads)
+      for (int i = 0; i < (int) level.size(); i++) {
+	try {
+	  SolveSubgame(*m_solver, subgames[level[i]], results,
+		       templateSolution, equilibria, results[level[i]]);
+	}
+	catch (...) {
+#pragma omp critical(subgame_errors)
+	  {
+	    if (!error) {
+	      error = std::current_exception();
+	    }
+	  }
+	  results[level[i]].m_failed = true;
 	}
       }
+      if (error) {
+	std::rethrow_exception(error);
+      }
     }
-  }
 
-  List<DVector<T> > vectors;
-  List<GameOutcome> values;
-  SolveSubgames(support, DVector<T>(support.NumActions()),
-		efg->GetRoot(), vectors, values);
+    for (size_t i = 0; i < level.size(); i++) {
+      if (results[level[i]].m_failed) {
+	return List<MixedBehaviorProfile<T> >();
+      }
+    }
+  }
 
+  const List<DVector<T> > &vectors = results[0].m_profiles;
   List<MixedBehaviorProfile<T> > solutions;
   for (int i = 1; i <= vectors.Length(); i++) {
     solutions.Append(MixedBehaviorProfile<T>(p_support));
@@ -0,0 +1,249 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2016, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: src/libgambit/number.cc
+// Implementation of class for storing numerical data in a game
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#include <algorithm>
+#include <climits>
+#include <cctype>
+
+#include "gambit/gambit.h"
+
+namespace Gambit {
+
+namespace {
+
+/// The largest numerator held inline.  This is kept below 2^53 so that
+/// numerator, quotient and remainder are exact as doubles, and the
+/// double value agrees with the one computed from the Rational.
+const unsigned long MAX_NUMERATOR = 
+  (unsigned long) LONG_MAX >> ((sizeof(long) > 4) ? 10 : 0);
+
+unsigned long GCD(unsigned long a, unsigned long b)
+{
+  while (b != 0) {
+    unsigned long r = a % b;
+    a = b;
+    b = r;
+  }
+  return a;
+}
+
+} // end anonymous namespace
+
+//------------------------------------------------------------------------
+//                    Number: Private member functions
+//------------------------------------------------------------------------
+
+//
+// Accepts integers, decimals and fractions written in the form in which
+// they would be written back, that is, an optional minus sign, no
+// superfluous leading zeros, and at least one digit after a decimal point.
+// Anything else is left to lexical_cast<Rational>().
+//
+bool Number::ParseSmall(const std::string &p_text)
+{
+  const char *c = p_text.c_str(), *end = c + p_text.length();
+
+  bool negative = false;
+  if (c < end && *c == '-') {
+    negative = true;
+    c++;
+  }
+  if (c == end || !isdigit(*c) || 
+      (*c == '0' && c + 1 < end && isdigit(c[1]))) {
+    return false;
+  }
+
+  unsigned long num = 0, den = 1;
+  int places = 0;
+  unsigned char kind = NUMBER_DECIMAL;
+  for (; c < end && isdigit(*c); c++) {
+    if (num > (MAX_NUMERATOR - (*c - '0')) / 10) return false;
+    num = 10 * num + (*c - '0');
+  }
+  
+  if (c < end && *c == '.') {
+    if (++c == end || !isdigit(*c)) return false;
+    for (; c < end && isdigit(*c); c++) {
+      if (num > (MAX_NUMERATOR - (*c - '0')) / 10 || den > UINT_MAX / 10) {
+	return false;
+      }
+      num = 10 * num + (*c - '0');
+      den *= 10;
+      places++;
+    }
+  }
+  else if (c < end && *c == '/') {
+    if (++c == end || !isdigit(*c) || *c == '0') return false;
+    den = 0;
+    for (; c < end && isdigit(*c); c++) {
+      if (den > (UINT_MAX - (*c - '0')) / 10) return false;
+      den = 10 * den + (*c - '0');
+    }
+    kind = NUMBER_FRACTION;
+  }
+
+  if (c != end || (negative && num == 0)) return false;
+
+  m_num = (negative) ? -(long) num : (long) num;
+  m_den = (unsigned int) den;
+  m_kind = kind;
+  m_places = (unsigned char) places;
+  return true;
+}
+
+//
+// Computes the value in the same way as Rational::operator double(),
+// so that the result does not depend on which representation is held.
+//
+void Number::ComputeDouble(void)
+{
+  unsigned long num = (m_num < 0) ? -(unsigned long) m_num : m_num;
+  unsigned long den = m_den;
+  unsigned long g = GCD(num, den);
+  num /= g;
+  den /= g;
+
+  double value = (double) (num / den);
+  if (num % den != 0) {
+    value += (double) (num % den) / (double) den;
+  }
+  m_double = (m_num < 0) ? -value : value;
+}
+
+Number::Extended *Number::GetExtended(void) const
+{
+  if (!m_extended) {
+    m_extended = new Extended;
+  }
+  return m_extended;
+}
+
+//------------------------------------------------------------------------
+//                    Number: Lifecycle and assignment
+//------------------------------------------------------------------------
+
+Number::Number(const std::string &p_text)
+  : m_double(0.0), m_num(0), m_den(1), m_kind(NUMBER_GENERAL), m_places(0),
+    m_extended(0)
+{
+  if (ParseSmall(p_text)) {
+    ComputeDouble();
+    return;
+  }
+
+  // lexical_cast<Rational>() throws a ValueException if the conversion 
+  // of the text fails
+  Rational value = lexical_cast<Rational>(p_text);
+  m_extended = new Extended;
+  m_extended->m_text = p_text;
+  m_extended->m_rational = value;
+  m_extended->m_hasText = m_extended->m_hasRational = true;
+  m_double = (double) value;
+}
+
+Number::Number(const Number &p_number)
+  : m_double(p_number.m_double), m_num(p_number.m_num), 
+    m_den(p_number.m_den), m_kind(p_number.m_kind), 
+    m_places(p_number.m_places), m_extended(0)
+{
+  if (m_kind == NUMBER_GENERAL) {
+    m_extended = new Extended(*p_number.m_extended);
+  }
+}
+
+Number &Number::operator=(const Number &p_number)
+{
+  if (this != &p_number) {
+    Extended *extended = 0;
+    if (p_number.m_kind == NUMBER_GENERAL) {
+      extended = new Extended(*p_number.m_extended);
+    }
+    delete m_extended;
+    m_extended = extended;
+    m_double = p_number.m_double;
+    m_num = p_number.m_num;
+    m_den = p_number.m_den;
+    m_kind = p_number.m_kind;
+    m_places = p_number.m_places;
+  }
+  return *this;
+}
+
+Number &Number::operator=(const std::string &p_text)
+{
+  // Construct first, so that this number is unchanged if the text
+  // is not a valid number
+  Number number(p_text);
+  std::swap(m_double, number.m_double);
+  std::swap(m_num, number.m_num);
+  std::swap(m_den, number.m_den);
+  std::swap(m_kind, number.m_kind);
+  std::swap(m_places, number.m_places);
+  std::swap(m_extended, number.m_extended);
+  return *this;
+}
+
+//------------------------------------------------------------------------
+//                       Number: Conversions
+//------------------------------------------------------------------------
+
+void Number::BuildExtended(void) const
+{
+  (void) static_cast<const Rational &>(*this);
+  (void) static_cast<const std::string &>(*this);
+}
+
+Number::operator const Rational &(void) const
+{
+  Extended *extended = GetExtended();
+  if (!extended->m_hasRational) {
+    extended->m_rational = Rational(m_num, (long) m_den);
+    extended->m_hasRational = true;
+  }
+  return extended->m_rational;
+}
+
+Number::operator const std::string &(void) const
+{
+  Extended *extended = GetExtended();
+  if (!extended->m_hasText) {
+    unsigned long num = (m_num < 0) ? -(unsigned long) m_num : m_num;
+    std::ostringstream s;
+    s << num;
+    std::string digits = s.str();
+    if (m_kind == NUMBER_FRACTION) {
+      s << '/' << m_den;
+      digits = s.str();
+    }
+    else if (m_places > 0) {
+      if (digits.length() <= m_places) {
+	digits.insert(0, m_places + 1 - digits.length(), '0');
+      }
+      digits.insert(digits.length() - m_places, 1, '.');
+    }
+    extended->m_text = (m_num < 0) ? "-" + digits : digits;
+    extended->m_hasText = true;
+  }
+  return extended->m_text;
+}
+
+}  // end namespace Gambit
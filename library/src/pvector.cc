@@ -24,6 +24,8 @@
 #include "gambit/pvector.imp"
 
 template class Gambit::PVector<int>;
+template class Gambit::PVector<long>;
+template class Gambit::PVector<Gambit::Integer>;
 template class Gambit::PVector<double>;
 template class Gambit::PVector<Gambit::Rational>;
 
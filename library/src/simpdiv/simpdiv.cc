@@ -20,58 +20,227 @@
 // Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
 //
 
+#include <cmath>
+#include <cfloat>
+#include <climits>
+#include <algorithm>
+#include <vector>
+
 #include "gambit/gambit.h"
 #include "gambit/nash/simpdiv.h"
+#include "../multirun.h"
 
 namespace Gambit {
 namespace Nash {
 
 //-------------------------------------------------------------------------
-//          NashSimpdivStrategySolver: Private member functions
+//               NashSimpdivStrategySolver::RunControl
+//-------------------------------------------------------------------------
+
+bool NashSimpdivStrategySolver::RunControl::Stop(void)
+{
+  if (!m_stopped && m_cancel) {
+    int cancel;
+#pragma omp atomic read
+    cancel = *m_cancel;
+    m_stopped = (cancel != 0);
+  }
+  if (!m_stopped && m_deadline > 0.0) {
+    m_stopped = (WallClock() >= m_deadline);
+  }
+  return m_stopped;
+}
+
+//-------------------------------------------------------------------------
+//                 NashSimpdivStrategySolver::State
 //-------------------------------------------------------------------------
 
-inline GameStrategy GetStrategy(const Game &game, int pl, int st)
+inline double ToDouble(long n)  { return (double) n; }
+inline double ToDouble(const Integer &n)  { return n.as_double(); }
+
+inline void FromInteger(const Integer &n, long &x)  { x = n.as_long(); }
+inline void FromInteger(const Integer &n, Integer &x)  { x = n; }
+
+NashSimpdivStrategySolver::State::State(const Game &p_game, const Integer &p_D,
+					bool p_useDouble)
+  : t(0), ibar(1), D(p_D), bestz(1.0e30), 
+    useDouble(p_useDouble), bestzExact(true), bestzApprox(1.0e30),
+    exactLabels(0),
+    exact(p_game->NewMixedStrategyProfile(Rational(0))),
+    approx(p_game->NewMixedStrategyProfile(0.0))
+{
+  // Floating-point comparisons closer than this are not trusted to
+  // give the same outcome as the exact ones.  The bound grows with the
+  // number of terms summed when computing a strategy value, which is
+  // counted in double as it need not fit in a long for a tree.
+  double scale = std::max(1.0,
+			  std::max(fabs((double) p_game->GetMaxPayoff()),
+				   fabs((double) p_game->GetMinPayoff())));
+  double terms = 1.0;
+  for (int pl = 1; pl <= p_game->NumPlayers(); pl++) {
+    terms *= (double) p_game->GetPlayer(pl)->NumStrategies();
+  }
+  tol = scale * std::max(1.0e-9, 16.0 * DBL_EPSILON * terms);
+}
+
+template <class T> Rational
+NashSimpdivStrategySolver::State::getlabelExact(const PVector<T> &yy,
+						Array<int> &ylabel)
+{
+  for (int i = 1; i <= yy.Length(); i++) {
+    exact[i] = Rational(Integer(yy[i]), D);
+  }
+
+  Rational maxz = -1000000;
+  ylabel[1] = 1;
+  ylabel[2] = 1;
+  
+  for (int i = 1; i <= exact.GetGame()->NumPlayers(); i++) {
+    GamePlayer player = exact.GetGame()->Players()[i];
+    Rational payoff = 0;
+    Rational maxval = -1000000;
+    int jj = 0;
+    Vector<Rational> values = exact.GetStrategyValues(player);
+    for (size_t j = 1; j <= player->Strategies().size(); j++) {
+      const Rational &pay = values[j];
+      payoff += exact[player->Strategies()[j]] * pay;
+      if (pay > maxval) {
+	maxval = pay;
+	jj = j;
+      }
+    }
+    if (maxval - payoff > maxz) {
+      maxz = maxval - payoff;
+      ylabel[1] = i;
+      ylabel[2] = jj;
+    }
+  }
+  return maxz;
+}
+
+///
+/// Computes the label of yy in floating point, following the same
+/// comparisons as getlabelExact().  Returns false, leaving the label
+/// undetermined, if any of those comparisons is within rounding error.
+///
+template <class T> bool
+NashSimpdivStrategySolver::State::getlabelApprox(const PVector<T> &yy,
+						 Array<int> &ylabel,
+						 double &maxz)
+{
+  double denom = ToDouble(D);
+  for (int i = 1; i <= yy.Length(); i++) {
+    approx[i] = ToDouble(yy[i]) / denom;
+  }
+
+  maxz = -1000000.0;
+  ylabel[1] = 1;
+  ylabel[2] = 1;
+  
+  for (int i = 1; i <= approx.GetGame()->NumPlayers(); i++) {
+    GamePlayer player = approx.GetGame()->Players()[i];
+    double payoff = 0.0;
+    double maxval = -1000000.0;
+    int jj = 0;
+    Vector<double> values = approx.GetStrategyValues(player);
+    for (size_t j = 1; j <= player->Strategies().size(); j++) {
+      double pay = values[j];
+      payoff += approx[player->Strategies()[j]] * pay;
+      if (fabs(pay - maxval) <= tol) {
+	return false;
+      }
+      if (pay > maxval) {
+	maxval = pay;
+	jj = j;
+      }
+    }
+    if (fabs(maxval - payoff - maxz) <= tol) {
+      return false;
+    }
+    if (maxval - payoff > maxz) {
+      maxz = maxval - payoff;
+      ylabel[1] = i;
+      ylabel[2] = jj;
+    }
+  }
+  return true;
+}
+
+template <class T> void
+NashSimpdivStrategySolver::State::getlabel(const PVector<T> &yy,
+					   Array<int> &ylabel,
+					   PVector<T> &besty)
 {
-  return game->Players()[pl]->Strategies()[st];
+  if (useDouble) {
+    double maxz;
+    if (getlabelApprox(yy, ylabel, maxz) && fabs(maxz - bestzApprox) > tol) {
+      if (maxz < bestzApprox) {
+	bestzApprox = maxz;
+	bestzExact = false;
+	besty = yy;
+      }
+      return;
+    }
+  }
+
+  Rational maxz = getlabelExact(yy, ylabel);
+  exactLabels++;
+  if (!bestzExact) {
+    Array<int> bestlabel(2);
+    bestz = getlabelExact(besty, bestlabel);
+    bestzExact = true;
+  }
+  if (maxz < bestz) {
+    bestz = maxz;
+    bestzApprox = (double) maxz;
+    besty = yy;
+  }
 }
 
-Rational 
-NashSimpdivStrategySolver::Simplex(MixedStrategyProfile<Rational> &y,
-				   const Rational &d) const
+//-------------------------------------------------------------------------
+//          NashSimpdivStrategySolver: Private member functions
+//-------------------------------------------------------------------------
+
+template <class T> Rational 
+NashSimpdivStrategySolver::Simplex(MixedStrategyProfile<Rational> &p_y,
+				   const Integer &D, RunControl &p_run) const
 {
-  Game game = y.GetGame();
-  State state;
-  state.d = d;
+  NashSimpdivRunSummary &summary = p_run.m_summary;
+  Game game = p_y.GetGame();
+  State state(game, D, m_fastLabels);
   Array<int> nstrats(game->NumStrategies());
   Array<int> ylabel(2);
-  RectArray<int> labels(y.MixedProfileLength(), 2), pi(y.MixedProfileLength(), 2);
-  PVector<int> U(nstrats), TT(nstrats);
-  PVector<Rational> ab(nstrats), besty(nstrats), v(nstrats);
+  RectArray<int> labels(p_y.MixedProfileLength(), 2), pi(p_y.MixedProfileLength(), 2);
+  PVector<int> U(nstrats), TT(nstrats), ab(nstrats);
+  PVector<T> y(nstrats), besty(nstrats), v(nstrats);
+  T leash(m_leashLength);
   for (int i = 1; i <= v.Length(); i++) {
-    v[i] = y[i];
+    FromInteger((p_y[i] * Rational(D)).numerator(), v[i]);
   }
-  besty = static_cast<Vector<Rational> &>(y);
+  besty = v;
   int i = 0;
   int j, k, h, jj, hh,ii, kk,tot;
-  Rational maxz;
 
 // Label step0 not currently used, hence commented
 // step0:
   TT = 0;
   U = 0;
-  ab = Rational(0);
+  ab = 0;
   for (j = 1; j <= game->NumPlayers(); j++)  {
-    GamePlayer player = game->Players()[j];
     for (h = 1; h <= nstrats[j]; h++)  {
-      if (v(j,h) == Rational(0)) {
+      if (v(j,h) == T(0)) {
 	U(j,h) = 1;
       }
-      y[player->Strategies()[h]] = v(j,h);
+      y(j,h) = v(j,h);
     }
   }
 
  step1:
-  maxz = state.getlabel(y, ylabel, besty);
+  if (p_run.Stop()) {
+    goto end;
+  }
+  state.getlabel(y, ylabel, besty);
+  summary.m_labels++;
   j = ylabel[1];
   h = ylabel[2];
   labels(state.ibar,1) = j;
@@ -123,6 +292,7 @@ NashSimpdivStrategySolver::Simplex(MixedStrategyProfile<Rational> &y,
   }
   
  step2:
+  summary.m_pivots++;
   getY(state, y, v, U, TT, ab, pi, i);
   pi.RotateDown(i, state.t+1);
   pi(i,1) = j;
@@ -136,6 +306,7 @@ NashSimpdivStrategySolver::Simplex(MixedStrategyProfile<Rational> &y,
   goto step1;
   
  step3:
+  summary.m_pivots++;
   ii = (i == state.t+1) ? state.t : i;
   j = pi(ii,1);
   h = pi(ii,2);
@@ -156,9 +327,7 @@ NashSimpdivStrategySolver::Simplex(MixedStrategyProfile<Rational> &y,
   getY(state, y, v, U, TT, ab, pi, ii);
   
   /* case3a */
-  if (i==1 && 
-      (y[GetStrategy(game, j, k)]<=Rational(0) || 
-       (v(j,k)-y[GetStrategy(game, j, k)]) >= Rational(m_leashLength)*state.d)) {
+  if (i==1 && (y(j,k) <= T(0) || v(j,k) - y(j,k) >= leash)) {
     for (hh = 1, tot = 0; hh <= nstrats[j]; hh++) {
       if (TT(j,hh)==1 || U(j,hh)==1)  {
 	tot++;
@@ -177,19 +346,17 @@ NashSimpdivStrategySolver::Simplex(MixedStrategyProfile<Rational> &y,
   }
   /* case3b */
   else if (i>=2 && i<=state.t &&
-	   (y[GetStrategy(game, j, k)] <= Rational(0) || 
-	    (v(j,k)-y[GetStrategy(game, j, k)]) >= Rational(m_leashLength)*state.d)) {
+	   (y(j,k) <= T(0) || v(j,k) - y(j,k) >= leash)) {
     goto step4;
   }
   /* case3c */
-  else if (i==state.t+1 && ab(j,kk) == Rational(0)) {
-    if (y[GetStrategy(game, j, h)] <= Rational(0) || 
-	(v(j,h)-y[GetStrategy(game, j, h)]) >= Rational(m_leashLength)*state.d) {
+  else if (i==state.t+1 && ab(j,kk) == 0) {
+    if (y(j,h) <= T(0) || v(j,h) - y(j,h) >= leash) {
       goto step4;
     }
     else {
       k=0;
-      while (ab(j,kk) == Rational(0) && k==0) {
+      while (ab(j,kk) == 0 && k==0) {
 	if(kk==h)k=1;
 	kk++;
 	if (kk > nstrats[j]) {
@@ -219,20 +386,20 @@ NashSimpdivStrategySolver::Simplex(MixedStrategyProfile<Rational> &y,
       j = pi(state.t,1);
       h = pi(state.t,2);
       hh = get_b(j,h,nstrats[j],U);
-      y[GetStrategy(game, j, h)] -= state.d;
-      y[GetStrategy(game, j, hh)] += state.d;
+      y(j,h) -= T(1);
+      y(j,hh) += T(1);
     }
     update(state, pi, labels, ab, U, j, i);
   }
   goto step1;
 
  step4:
+  summary.m_pivots++;
   getY(state, y, v, U, TT, ab, pi, 1);
   j = pi(i-1,1);
   h = pi(i-1,2);
   TT(j,h) = 0;
-  if (y[GetStrategy(game, j, h)] <= Rational(0) || 
-      (v(j,h)-y[GetStrategy(game, j, h)]) >= Rational(m_leashLength)*state.d) {
+  if (y(j,h) <= T(0) || v(j,h) - y(j,h) >= leash) {
     U(j,h) = 1;
   }
   labels.RotateUp(i,state.t+1);
@@ -246,6 +413,7 @@ NashSimpdivStrategySolver::Simplex(MixedStrategyProfile<Rational> &y,
   goto step3;
 
  step5:
+  summary.m_pivots++;
   k=kk;
   labels.RotateDown(1,state.t+1);
   state.ibar=1;
@@ -254,8 +422,8 @@ NashSimpdivStrategySolver::Simplex(MixedStrategyProfile<Rational> &y,
   jj=pi(1,1);
   hh=pi(1,2);
   kk=get_b(jj,hh,nstrats[jj],U);
-  y[GetStrategy(game, jj, hh)] -= state.d;
-  y[GetStrategy(game, jj, kk)] += state.d;
+  y(jj,hh) -= T(1);
+  y(jj,kk) += T(1);
   
   k = get_c(j,h,nstrats[j],U);
   kk=1;
@@ -263,7 +431,7 @@ NashSimpdivStrategySolver::Simplex(MixedStrategyProfile<Rational> &y,
     if (k == h) {
       kk = 0;
     }
-    ab(j,k) -= Rational(1);
+    ab(j,k) -= 1;
     k++;
     if (k > nstrats[j]) {
       k = 1;
@@ -272,19 +440,21 @@ NashSimpdivStrategySolver::Simplex(MixedStrategyProfile<Rational> &y,
   goto step1;
 
  end:
-  maxz=state.bestz;
-  for (i = 1; i <= game->NumPlayers(); i++) {
-    for (j = 1; j <= nstrats[i]; j++) {
-      y[GetStrategy(game, i, j)] = besty(i,j);
-    }
+  summary.m_exactLabels += state.exactLabels;
+  if (!state.bestzExact) {
+    // Certify the best point found with an exact evaluation
+    state.bestz = state.getlabelExact(besty, ylabel);
   }
-  return maxz;
+  for (i = 1; i <= besty.Length(); i++) {
+    p_y[i] = Rational(Integer(besty[i]), D);
+  }
+  return state.bestz;
 }
 
 void NashSimpdivStrategySolver::update(State &state,
 				       RectArray<int> &pi,
 				       RectArray<int> &labels,
-				       PVector<Rational> &ab,
+				       PVector<int> &ab,
 				       const PVector<int> &U,
 				       int j, int i) const
 {
@@ -304,7 +474,7 @@ void NashSimpdivStrategySolver::update(State &state,
       k=get_c(jj,hh,ab.Lengths()[jj],U);
       while(f) {
 	if(k==hh)f=0;
-	ab(j,k) += Rational(1);
+	ab(j,k) += 1;
 	k++;
 	if(k>ab.Lengths()[jj])k=1;
       }
@@ -320,7 +490,7 @@ void NashSimpdivStrategySolver::update(State &state,
       k=get_c(jj,hh,ab.Lengths()[jj],U);
       while(f) {
 	if(k==hh)f=0;
-	ab(j,k) -= Rational(1);
+	ab(j,k) -= 1;
 	k++;
 	if(k>ab.Lengths()[jj])k=1;
       }
@@ -329,23 +499,24 @@ void NashSimpdivStrategySolver::update(State &state,
   }
 }
 
+template <class T>
 void NashSimpdivStrategySolver::getY(State &state,
-				     MixedStrategyProfile<Rational> &x,
-				     PVector<Rational> &v, 
+				     PVector<T> &x,
+				     const PVector<T> &v, 
 				     const PVector<int> &U,
 				     const PVector<int> &TT,
-				     const PVector<Rational> &ab,
+				     const PVector<int> &ab,
 				     const RectArray<int> &pi,
 				     int k) const
 {
-  static_cast<Vector<Rational> & >(x) = v;
-  for (size_t j = 1; j <= x.GetGame()->Players().size(); j++) {
-    GamePlayer player = x.GetGame()->Players()[j];
-    for (size_t h = 1; h <= player->Strategies().size(); h++) {
+  x = v;
+  for (int j = 1; j <= x.Lengths().Length(); j++) {
+    int nstrats = x.Lengths()[j];
+    for (int h = 1; h <= nstrats; h++) {
       if (TT(j,h) == 1 || U(j,h) == 1) {
-	x[player->Strategies()[h]] += state.d*ab(j,h);
-	int hh = (h > 1) ? h-1 : player->Strategies().size();
-	x[player->Strategies()[hh]] -= state.d*ab(j,h);
+	x(j,h) += T(ab(j,h));
+	int hh = (h > 1) ? h-1 : nstrats;
+	x(j,hh) -= T(ab(j,h));
       }
     }
   }
@@ -354,18 +525,18 @@ void NashSimpdivStrategySolver::getY(State &state,
   }
 }
 
+template <class T>
 void NashSimpdivStrategySolver::getnexty(State &state,
-					 MixedStrategyProfile<Rational> &x,
+					 PVector<T> &x,
 					 const RectArray<int> &pi, 
 					 const PVector<int> &U,
 					 int i) const
 {
   int j = pi(i,1);
-  GamePlayer player = x.GetGame()->Players()[j];
   int h = pi(i,2);
-  x[player->Strategies()[h]] += state.d;
-  int hh = get_b(j, h, player->Strategies().size(), U);
-  x[player->Strategies()[hh]] -= state.d;
+  x(j,h) += T(1);
+  int hh = get_b(j, h, x.Lengths()[j], U);
+  x(j,hh) -= T(1);
 }
 
 int NashSimpdivStrategySolver::get_b(int j, int h, int nstrats, const PVector<int> &U) const
@@ -387,46 +558,6 @@ int NashSimpdivStrategySolver::get_c(int j, int h, int nstrats,
   return (hh > nstrats) ? 1 : hh;
 }
 
-Rational 
-NashSimpdivStrategySolver::State::getlabel(MixedStrategyProfile<Rational> &yy,
-					   Array<int> &ylabel,
-					   PVector<Rational> &besty)
-{
-  Rational maxz = -1000000;
-  ylabel[1] = 1;
-  ylabel[2] = 1;
-  
-  for (int i = 1; i <= yy.GetGame()->NumPlayers(); i++) {
-    GamePlayer player = yy.GetGame()->Players()[i];
-    Rational payoff = 0;
-    Rational maxval = -1000000;
-    int jj = 0;
-    for (size_t j = 1; j <= player->Strategies().size(); j++) {
-      pay = yy.GetPayoff(player->Strategies()[j]);
-      payoff += yy[player->Strategies()[j]] * pay;
-      if (pay > maxval) {
-	maxval = pay;
-	jj = j;
-      }
-    }
-    if (maxval - payoff > maxz) {
-      maxz = maxval - payoff;
-      ylabel[1] = i;
-      ylabel[2] = jj;
-    }
-  }
-  if (maxz < bestz) {
-    bestz = maxz;
-    for (int i = 1; i <= yy.GetGame()->NumPlayers(); i++) {
-      GamePlayer player = yy.GetGame()->Players()[i];
-      for (size_t j = 1; j <= player->Strategies().size(); j++) {
-	besty(i,j) = yy[player->Strategies()[j]];
-      }
-    }
-  }
-  return maxz;
-}
-
 //-------------------------------------------------------------------------
 //           NashSimpdivStrategySolver: Main solution algorithm
 //-------------------------------------------------------------------------
@@ -441,30 +572,49 @@ inline Integer find_lcd(const Vector<Rational> &vec)
 }
 
 
-List<MixedStrategyProfile<Rational> >
-NashSimpdivStrategySolver::Solve(const MixedStrategyProfile<Rational> &p_start) const
+bool
+NashSimpdivStrategySolver::Run(MixedStrategyProfile<Rational> &y,
+			       int p_gridResize, RunControl &p_run) const
 {
-  if (!p_start.GetGame()->IsPerfectRecall()) {
-    throw UndefinedException("Computing equilibria of games with imperfect recall is not supported.");
-  }
-  Integer k = find_lcd((const Vector<Rational> &) p_start);
-  Rational d = Rational(1, k);
+  Integer D = find_lcd((const Vector<Rational> &) y);
+  Rational d = Rational(1, D);
     
-  MixedStrategyProfile<Rational> y(p_start);
   if (m_verbose) {
     this->m_onEquilibrium->Render(y, "start");
   }
 
   while (true) {
     const double TOL = 1.0e-10;
-    d /= m_gridResize;
-    Rational maxz = Simplex(y, d);
+    d /= p_gridResize;
+    D *= p_gridResize;
+    // Numerators stay within a few multiples of D, so machine integers
+    // suffice until D approaches the range of a long.
+    Rational maxz = ((D <= Integer(LONG_MAX / 4)) ? 
+		     Simplex<long>(y, D, p_run) : Simplex<Integer>(y, D, p_run));
+    if (p_run.m_stopped) {
+      return false;
+    }
+    p_run.m_summary.m_grids++;
     
     if (m_verbose) {
       this->m_onEquilibrium->Render(y, lexical_cast<std::string>(d));
     }
-    if (maxz < Rational(TOL)) break;
+    if (maxz < Rational(TOL)) {
+      return true;
+    }
   }
+}
+
+List<MixedStrategyProfile<Rational> >
+NashSimpdivStrategySolver::Solve(const MixedStrategyProfile<Rational> &p_start) const
+{
+  if (!p_start.GetGame()->IsPerfectRecall()) {
+    throw UndefinedException("Computing equilibria of games with imperfect recall is not supported.");
+  }
+  MixedStrategyProfile<Rational> y(p_start);
+  NashSimpdivRunSummary summary;
+  RunControl control(summary);
+  Run(y, m_gridResize, control);
     
   this->m_onEquilibrium->Render(y);
   List<MixedStrategyProfile<Rational> > sol;
@@ -472,6 +622,81 @@ NashSimpdivStrategySolver::Solve(const MixedStrategyProfile<Rational> &p_start)
   return sol;
 }
 
+//
+// Runs are numbered in the order of their summaries, and handed out to
+// threads in that order.  The starting points are copied out of the
+// list beforehand, as List indexing is not safe for concurrent reads.
+// A run which is stopped early does not report the point it reached.
+//
+List<MixedStrategyProfile<Rational> >
+NashSimpdivStrategySolver::Solve(const List<MixedStrategyProfile<Rational> > &p_starts,
+				 const Array<int> &p_gridResizes,
+				 int p_threads, int p_stopAfter,
+				 double p_maxSeconds,
+				 List<NashSimpdivRunSummary> *p_summaries) const
+{
+  List<MixedStrategyProfile<Rational> > solutions;
+  if (p_starts.size() == 0 || p_gridResizes.Length() == 0) {
+    if (p_summaries) {
+      *p_summaries = List<NashSimpdivRunSummary>();
+    }
+    return solutions;
+  }
+  Game game = p_starts[1].GetGame();
+  if (!game->IsPerfectRecall()) {
+    throw UndefinedException("Computing equilibria of games with imperfect recall is not supported.");
+  }
+
+  std::vector<MixedStrategyProfile<Rational> > starts;
+  for (size_t i = 1; i <= p_starts.size(); i++) {
+    starts.push_back(p_starts[i]);
+  }
+  int numRuns = starts.size() * p_gridResizes.Length();
+  if (!game->PrepareConcurrentAccess() || m_verbose) {
+    // Action graph representations share scratch data, and the
+    // verbose output of Run() is not synchronized
+    p_threads = 1;
+  }
+  p_threads = std::max(1, std::min(p_threads, numRuns));
+
+  std::vector<NashSimpdivRunSummary> summaries(numRuns);
+  int cancel = 0;
+  double deadline = (p_maxSeconds > 0.0) ? WallClock() + p_maxSeconds : 0.0;
+#pragma omp parallel for schedule(dynamic) num_threads(p_threads)
+  for (int i = 0; i < numRuns; i++) {
+    double start = WallClock();
+    MixedStrategyProfile<Rational> y(starts[i / p_gridResizes.Length()]);
+    summaries[i].m_gridResize = p_gridResizes[i % p_gridResizes.Length() + 1];
+    RunControl control(summaries[i], &cancel, deadline);
+    if (!control.Stop()) {
+      summaries[i].m_converged = Run(y, summaries[i].m_gridResize, control);
+    }
+    summaries[i].m_seconds = WallClock() - start;
+    if (summaries[i].m_converged) {
+#pragma omp critical(simpdiv_results)
+      {
+	if ((p_stopAfter <= 0 || solutions.size() < (size_t) p_stopAfter) &&
+	    IsNewEquilibrium(solutions, y)) {
+	  m_onEquilibrium->Render(y);
+	  solutions.push_back(y);
+	  if (p_stopAfter > 0 && solutions.size() >= (size_t) p_stopAfter) {
+#pragma omp atomic write
+	    cancel = 1;
+	  }
+	}
+      }
+    }
+  }
+
+  if (p_summaries) {
+    *p_summaries = List<NashSimpdivRunSummary>();
+    for (size_t i = 0; i < summaries.size(); i++) {
+      p_summaries->push_back(summaries[i]);
+    }
+  }
+  return solutions;
+}
+
 ///
 /// Compute an equilibrium using the default starting point. 
 ///
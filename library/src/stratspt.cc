@@ -20,8 +20,12 @@
 // Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
 //
 
+#include <algorithm>
+#include <cmath>
+
 #include "gambit/gambit.h"
 #include "gambit/gametable.h"
+#include "gambit/linalg/lpsolve.h"
 
 namespace Gambit {
 
@@ -221,119 +225,598 @@ bool StrategySupportProfile::RemoveStrategy(const GameStrategy &p_strategy)
 //                 Identification of dominated strategies
 //---------------------------------------------------------------------------
 
-bool StrategySupportProfile::Dominates(const GameStrategy &s,
-				const GameStrategy &t, 
-				bool p_strict) const
+namespace {
+
+//
+// The payoffs to a player of a list of his strategies, against each
+// contingency of the other players' strategies in a support.  These are
+// held as a row of doubles for each strategy, so that strategies are
+// compared by running along their rows, with pairs whose rows do not
+// overlap decided from the least and greatest entries alone.  Payoffs
+// too close to tell apart as doubles are compared exactly; this is never
+// needed for table games whose payoffs are all exact as doubles.
+//
+// Contingencies are numbered with the other players' indices in the
+// support as digits, the lowest-numbered player's being the last
+// significant.  When a comparison fails, the contingency at which it
+// does is recorded, so that once contingencies have been dropped by
+// RemoveStrategy() it is only repeated if that contingency has gone.
+//
+class DominanceTable {
+public:
+  DominanceTable(const StrategySupportProfile &p_support,
+		 const GamePlayer &p_player,
+		 const Array<GameStrategy> &p_strategies);
+
+  /// Returns the number of strategies in the table
+  int NumStrategies(void) const { return m_strategies.Length(); }
+  /// Returns the p_row'th strategy in the table
+  const GameStrategy &GetStrategy(int p_row) const
+  { return m_strategies[p_row]; }
+
+  /// Returns the number of contingencies remaining
+  long NumContingencies(void) const { return m_contingencies.size(); }
+  /// Returns the payoffs in row s at the remaining contingencies
+  const double *GetPayoffs(int s) const
+  { return &m_payoffs[(s - 1) * m_contingencies.size()]; }
+
+  /// Does the strategy in row s dominate the one in row t?
+  bool Dominates(int s, int t, bool p_strict) const;
+  /// Drops the contingencies in which another player plays the strategy
+  void RemoveStrategy(const GameStrategy &);
+
+private:
+  enum { BLOCK_SIZE = 64 };
+  enum { NOT_FOUND = -1, NEVER = -2 };
+
+  Game m_game;
+  int m_player;
+  Array<GameStrategy> m_strategies;
+  const GameTableRep *m_table;
+
+  /// The other players, the strategies of each in the support, and the
+  /// place value of their digits in the numbers of the contingencies
+  std::vector<int> m_others;
+  std::vector<Array<GameStrategy> > m_otherStrategies;
+  std::vector<long> m_placeValues;
+  /// The offset in the game table of each player's strategies
+  std::vector<long> m_strides;
+
+  /// The numbers of the contingencies remaining, and whether each
+  /// contingency, by number, remains
+  std::vector<long> m_contingencies;
+  std::vector<char> m_remaining;
+
+  /// The payoffs, by row and then by remaining contingency, with the
+  /// least and greatest in each row
+  std::vector<double> m_payoffs, m_min, m_max;
+  /// Differences of at most this are compared exactly, unless the
+  /// payoffs are exact
+  double m_tolerance;
+  bool m_exact;
+
+  /// For each ordered pair of rows, a contingency at which the first
+  /// does not weakly (respectively strictly) dominate the second
+  mutable std::vector<long> m_failures[2];
+
+  long GetTableIndex(long p_contingency, int p_row) const;
+  void SetContingency(long p_contingency, PureStrategyProfile &) const;
+  int Compare(int s, int t, int p_column) const;
+  void ComputeBounds(void);
+};
+
+DominanceTable::DominanceTable(const StrategySupportProfile &p_support,
+			       const GamePlayer &p_player,
+			       const Array<GameStrategy> &p_strategies)
+  : m_game(p_support.GetGame()), m_player(p_player->GetNumber()),
+    m_strategies(p_strategies),
+    m_table(dynamic_cast<const GameTableRep *>(m_game.operator->())),
+    m_strides(m_game->NumPlayers() + 1, 1)
 {
-  bool equal = true;
-  
-  for (StrategyProfileIterator iter(*this); !iter.AtEnd(); iter++) {
-    Rational ap = (*iter)->GetStrategyValue(s);
-    Rational bp = (*iter)->GetStrategyValue(t);
-    if (p_strict && ap <= bp) {
-      return false;
+  long numContingencies = 1;
+  for (int pl = 1; pl <= m_game->NumPlayers(); pl++) {
+    if (pl < m_game->NumPlayers()) {
+      m_strides[pl + 1] = m_strides[pl] * m_game->GetPlayer(pl)->NumStrategies();
     }
-    else if (!p_strict) {
-      if (ap < bp) return false;
-      else if (ap > bp) equal = false;
+    if (pl != m_player) {
+      m_others.push_back(pl);
+      m_otherStrategies.push_back(p_support.Strategies(m_game->GetPlayer(pl)));
+      m_placeValues.push_back(numContingencies);
+      numContingencies *= p_support.NumStrategies(pl);
     }
   }
 
-  return (p_strict || !equal);
+  int numRows = m_strategies.Length();
+  m_contingencies.resize(numContingencies);
+  m_remaining.assign(numContingencies, 1);
+  m_payoffs.resize(numRows * numContingencies);
+  if (m_table) {
+    const double *payoffs = m_table->GetPayoffTable<double>(m_player);
+    for (long c = 0; c < numContingencies; c++) {
+      m_contingencies[c] = c;
+      long index = GetTableIndex(c, 0);
+      for (int row = 1; row <= numRows; row++) {
+	m_payoffs[(row - 1) * numContingencies + c] = 
+	  payoffs[index + m_strides[m_player] * (m_strategies[row]->GetNumber() - 1)];
+      }
+    }
+  }
+  else {
+    PureStrategyProfile profile = m_game->NewPureStrategyProfile();
+    for (long c = 0; c < numContingencies; c++) {
+      m_contingencies[c] = c;
+      SetContingency(c, profile);
+      for (int row = 1; row <= numRows; row++) {
+	profile->SetStrategy(m_strategies[row]);
+	m_payoffs[(row - 1) * numContingencies + c] = 
+	  (double) profile->GetPayoff(m_player);
+      }
+    }
+  }
+
+  m_exact = (m_table && m_table->HasExactDoublePayoffs());
+  double scale = 1.0;
+  for (size_t i = 0; i < m_payoffs.size(); i++) {
+    scale = std::max(scale, std::fabs(m_payoffs[i]));
+  }
+  m_tolerance = (m_exact) ? 0.0 : 1.0e-9 * scale;
+
+  m_failures[0].assign(numRows * numRows, NOT_FOUND);
+  m_failures[1].assign(numRows * numRows, NOT_FOUND);
+  ComputeBounds();
+}
+
+/// Returns the index in the game table of the contingency, with the
+/// player playing the strategy in the given row (or the first strategy,
+/// for row 0)
+long DominanceTable::GetTableIndex(long p_contingency, int p_row) const
+{
+  long index = (p_row > 0) ? 
+    m_strides[m_player] * (m_strategies[p_row]->GetNumber() - 1) : 0;
+  for (size_t i = 0; i < m_others.size(); i++) {
+    const Array<GameStrategy> &strategies = m_otherStrategies[i];
+    int digit = (p_contingency / m_placeValues[i]) % strategies.Length();
+    index += m_strides[m_others[i]] * (strategies[digit + 1]->GetNumber() - 1);
+  }
+  return index;
+}
+
+void DominanceTable::SetContingency(long p_contingency,
+				    PureStrategyProfile &p_profile) const
+{
+  for (size_t i = 0; i < m_others.size(); i++) {
+    const Array<GameStrategy> &strategies = m_otherStrategies[i];
+    int digit = (p_contingency / m_placeValues[i]) % strategies.Length();
+    p_profile->SetStrategy(strategies[digit + 1]);
+  }
 }
 
+/// Returns the sign of the difference in the payoffs of rows s and t
+/// (counting from zero) at the remaining contingency in the column
+int DominanceTable::Compare(int s, int t, int p_column) const
+{
+  long numColumns = m_contingencies.size();
+  double diff = m_payoffs[s * numColumns + p_column] - m_payoffs[t * numColumns + p_column];
+  if (m_exact || diff > m_tolerance || diff < -m_tolerance) {
+    return (diff > 0.0) ? 1 : ((diff < 0.0) ? -1 : 0);
+  }
 
-bool StrategySupportProfile::IsDominated(const GameStrategy &s,
-				  bool p_strict,
-				  bool p_external) const
+  long contingency = m_contingencies[p_column];
+  Rational a, b;
+  if (m_table) {
+    const Rational *payoffs = m_table->GetPayoffTable<Rational>(m_player);
+    a = payoffs[GetTableIndex(contingency, s + 1)];
+    b = payoffs[GetTableIndex(contingency, t + 1)];
+  }
+  else {
+    PureStrategyProfile profile = m_game->NewPureStrategyProfile();
+    SetContingency(contingency, profile);
+    a = profile->GetStrategyValue(m_strategies[s + 1]);
+    b = profile->GetStrategyValue(m_strategies[t + 1]);
+  }
+  return (a > b) ? 1 : ((a < b) ? -1 : 0);
+}
+
+void DominanceTable::ComputeBounds(void)
 {
-  if (p_external) {
-    GamePlayer player = s->GetPlayer();
-    for (int st = 1; st <= player->NumStrategies(); st++) {
-      if (player->GetStrategy(st) != s &&
-	  Dominates(player->GetStrategy(st), s, p_strict)) {
-	return true;
-      }
+  int numRows = m_strategies.Length();
+  long numColumns = m_contingencies.size();
+  m_min.assign(numRows, 0.0);
+  m_max.assign(numRows, 0.0);
+  for (int row = 0; row < numRows && numColumns > 0; row++) {
+    const double *payoffs = &m_payoffs[row * numColumns];
+    double least = payoffs[0], greatest = payoffs[0];
+    for (long c = 1; c < numColumns; c++) {
+      least = std::min(least, payoffs[c]);
+      greatest = std::max(greatest, payoffs[c]);
     }
+    m_min[row] = least;
+    m_max[row] = greatest;
+  }
+}
+
+bool DominanceTable::Dominates(int s, int t, bool p_strict) const
+{
+  int numRows = m_strategies.Length();
+  long numColumns = m_contingencies.size();
+  long &failure = m_failures[(p_strict) ? 1 : 0][(s - 1) * numRows + t - 1];
+  if (failure == NEVER || (failure >= 0 && m_remaining[failure])) {
     return false;
   }
-  else {
-    for (int i = 1; i <= NumStrategies(s->GetPlayer()->GetNumber()); i++) {
-      if (GetStrategy(s->GetPlayer()->GetNumber(), i) != s &&
-	  Dominates(GetStrategy(s->GetPlayer()->GetNumber(), i), s, 
-		    p_strict)) {
-	return true;
+
+  if (m_min[s - 1] - m_max[t - 1] > m_tolerance) {
+    return true;
+  }
+  else if (m_max[s - 1] - m_min[t - 1] < -m_tolerance) {
+    failure = m_contingencies[0];
+    return false;
+  }
+
+  const double *a = &m_payoffs[(s - 1) * numColumns];
+  const double *b = &m_payoffs[(t - 1) * numColumns];
+  bool equal = true;
+  for (long start = 0; start < numColumns; start += BLOCK_SIZE) {
+    long end = std::min(start + (long) BLOCK_SIZE, numColumns);
+    // Find the least difference over the block in a tight loop, and
+    // only look at the entries one by one if that is not clearly positive
+    double least = a[start] - b[start];
+    for (long c = start + 1; c < end; c++) {
+      double diff = a[c] - b[c];
+      least = (diff < least) ? diff : least;
+    }
+    if (least > m_tolerance) {
+      equal = false;
+      continue;
+    }
+
+    for (long c = start; c < end; c++) {
+      int sign = Compare(s - 1, t - 1, c);
+      if (sign < 0 || (sign == 0 && p_strict)) {
+	failure = m_contingencies[c];
+	return false;
+      }
+      else if (sign > 0) {
+	equal = false;
       }
     }
+  }
+
+  if (!p_strict && equal) {
+    // The rows remain equal whichever contingencies are dropped
+    failure = NEVER;
     return false;
   }
+  return true;
 }
 
-bool StrategySupportProfile::Undominated(StrategySupportProfile &newS, int p_player,
-				  bool p_strict, bool p_external) const
+void DominanceTable::RemoveStrategy(const GameStrategy &p_strategy)
 {
-  Array<GameStrategy> set((p_external) ? 
-			  m_nfg->GetPlayer(p_player)->NumStrategies() :
-			  NumStrategies(p_player));
-
-  if (p_external) {
-    for (int st = 1; st <= set.Length(); st++) {
-      set[st] = m_nfg->GetPlayer(p_player)->GetStrategy(st);
+  int pl = p_strategy->GetPlayer()->GetNumber();
+  size_t i = std::find(m_others.begin(), m_others.end(), pl) - m_others.begin();
+  if (i == m_others.size() || !m_otherStrategies[i].Contains(p_strategy)) {
+    return;
+  }
+  const Array<GameStrategy> &strategies = m_otherStrategies[i];
+  int digit = strategies.Find(p_strategy) - 1;
+
+  // The rows are compacted in place, as no entry moves to the right
+  int numRows = m_strategies.Length();
+  long numColumns = m_contingencies.size();
+  std::vector<long> kept;
+  for (long c = 0; c < numColumns; c++) {
+    if ((m_contingencies[c] / m_placeValues[i]) % strategies.Length() == digit) {
+      m_remaining[m_contingencies[c]] = 0;
+    }
+    else {
+      kept.push_back(c);
     }
   }
-  else {
-    for (int st = 1; st <= set.Length(); st++) {
-      set[st] = GetStrategy(p_player, st);
+  long numKept = kept.size();
+  for (int row = 0; row < numRows; row++) {
+    for (long c = 0; c < numKept; c++) {
+      m_payoffs[row * numKept + c] = m_payoffs[row * numColumns + kept[c]];
     }
   }
+  for (long c = 0; c < numKept; c++) {
+    m_contingencies[c] = m_contingencies[kept[c]];
+  }
+  m_payoffs.resize(numRows * numKept);
+  m_contingencies.resize(numKept);
+  ComputeBounds();
+}
 
-  int min = 0, dis = set.Length() - 1;
+//
+// Finds the strategies in the rows listed which are not dominated by
+// any other, moving them to the front of the list, and returns their
+// number.  The undominated strategies found so far are kept at the front
+// of the list; the candidate at the end of the list is either dominated
+// by one of them, or becomes one, after all other remaining candidates
+// it dominates have been discarded, or it is replaced by one which
+// dominates it.
+//
+int FindUndominated(const DominanceTable &p_table, Array<int> &p_rows,
+		    bool p_strict)
+{
+  int min = 0, dis = p_rows.Length() - 1;
 
   while (min <= dis) {
     int pp;
     for (pp = 0;
-	 pp < min && !Dominates(set[pp+1], set[dis+1], p_strict);
+	 pp < min && !p_table.Dominates(p_rows[pp+1], p_rows[dis+1], p_strict);
 	 pp++);
     if (pp < min)
       dis--;
     else  {
-      GameStrategy foo = set[dis+1];
-      set[dis+1] = set[min+1];
-      set[min+1] = foo;
+      std::swap(p_rows[dis+1], p_rows[min+1]);
 
       for (int inc = min + 1; inc <= dis; )  {
-	if (Dominates(set[min+1], set[dis+1], p_strict)) {
-	  //p_tracefile << GetStrategy(p_player, set[dis+1])->GetNumber() << " dominated by " << GetStrategy(p_player, set[min+1])->GetNumber() << '\n';
+	if (p_table.Dominates(p_rows[min+1], p_rows[dis+1], p_strict)) {
 	  dis--;
 	}
-	else if (Dominates(set[dis+1], set[min+1], p_strict)) {
-	  //p_tracefile << GetStrategy(p_player, set[min+1])->GetNumber() << " dominated by " << GetStrategy(p_player, set[dis+1])->GetNumber() << '\n';
-	  foo = set[dis+1];
-	  set[dis+1] = set[min+1];
-	  set[min+1] = foo;
+	else if (p_table.Dominates(p_rows[dis+1], p_rows[min+1], p_strict)) {
+	  std::swap(p_rows[dis+1], p_rows[min+1]);
 	  dis--;
 	}
 	else  {
-	  foo = set[dis+1];
-	  set[dis+1] = set[inc+1];
-	  set[inc+1] = foo;
+	  std::swap(p_rows[dis+1], p_rows[inc+1]);
 	  inc++;
 	}
       }
       min++;
     }
   }
-    
-  if (min + 1 <= set.Length()) {
-    for (int i = min + 1; i <= set.Length(); i++) {
-      newS.RemoveStrategy(set[i]);
+  return min;
+}
+
+//
+// Finds which of the strategies in the rows listed are strictly dominated
+// by a mixture of them.  With the payoffs u scaled to lie between one and
+// two, the strategy in row t is so dominated if and only if the program
+//   maximize    sum_c y_c u(t, c)
+//   subject to  sum_c y_c u(s, c) <= 1 for each row s,  y >= 0
+// has optimum less than one, in which case the dual variables are
+// proportional to the weights of a dominating mixture.  The mixture is
+// checked against every contingency before the strategy is reported as
+// dominated.  Only the objective depends on the candidate, so each thread
+// solves the program once, and starts from the optimal basis for its
+// previous candidate for each one after.
+//
+void FindMixedDominated(const DominanceTable &p_table, const Array<int> &p_rows,
+			int p_threads, Array<bool> &p_dominated)
+{
+  const double TOLERANCE = 1.0e-9;
+  int numRows = p_rows.Length();
+  long numColumns = p_table.NumContingencies();
+  p_dominated = Array<bool>(numRows);
+  for (int i = 1; i <= numRows; p_dominated[i++] = false);
+  if (numRows < 2) {
+    return;
+  }
+
+  double least = p_table.GetPayoffs(p_rows[1])[0], greatest = least;
+  for (int i = 1; i <= numRows; i++) {
+    const double *payoffs = p_table.GetPayoffs(p_rows[i]);
+    for (long c = 0; c < numColumns; c++) {
+      least = std::min(least, payoffs[c]);
+      greatest = std::max(greatest, payoffs[c]);
+    }
+  }
+  if (greatest - least <= 0.0) {
+    return;
+  }
+  Matrix<double> A(numRows, numColumns);
+  Vector<double> b(numRows);
+  for (int i = 1; i <= numRows; i++) {
+    const double *payoffs = p_table.GetPayoffs(p_rows[i]);
+    for (long c = 0; c < numColumns; c++) {
+      A(i, c + 1) = 1.0 + (payoffs[c] - least) / (greatest - least);
+    }
+    b[i] = 1.0;
+  }
+
+  p_threads = std::max(1, std::min(p_threads, numRows));
+#pragma omp parallel num_threads(p_threads)
+  {
+    linalg::LPSolve<double> *lp = 0;
+    Vector<double> cost(numColumns);
+#pragma omp for schedule(dynamic)
+    for (int t = 1; t <= numRows; t++) {
+      for (long c = 1; c <= numColumns; c++) {
+	cost[c] = A(t, c);
+      }
+      try {
+	if (lp) {
+	  lp->Reoptimize(cost);
+	}
+	else {
+	  lp = new linalg::LPSolve<double>(A, b, cost, 0);
+	}
+      }
+      catch (Exception &) {
+	// Numerical trouble; the next candidate starts afresh
+	delete lp;
+	lp = 0;
+	continue;
+      }
+      if (!lp->IsFeasible() || !lp->IsBounded() ||
+	  lp->OptimumCost() >= 1.0 - TOLERANCE) {
+	continue;
+      }
+
+      const Vector<double> &weights = lp->DualVector();
+      double total = 0.0;
+      for (int s = 1; s <= numRows; s++) {
+	total += std::max(weights[s], 0.0);
+      }
+      if (total <= 0.0) {
+	continue;
+      }
+      bool dominated = true;
+      for (long c = 1; dominated && c <= numColumns; c++) {
+	double value = 0.0;
+	for (int s = 1; s <= numRows; s++) {
+	  value += std::max(weights[s], 0.0) * A(s, c);
+	}
+	dominated = (value / total - A(t, c) > TOLERANCE);
+      }
+      p_dominated[t] = dominated;
+    }
+    delete lp;
+  }
+}
+
+//
+// Eliminates the dominated strategies from the support, by pure strategies
+// and, if p_mixed is set, strictly by mixed strategies.  If p_iterated
+// is set, this continues until no dominated strategies remain.
+//
+StrategySupportProfile EliminateDominated(const StrategySupportProfile &p_support,
+					  bool p_strict, bool p_mixed,
+					  bool p_iterated, int p_threads)
+{
+  Game game = p_support.GetGame();
+  StrategySupportProfile support(p_support);
+  std::vector<DominanceTable> tables;
+  Array<Array<int> > rows;
+  Array<bool> changed(game->NumPlayers());
+  for (int pl = 1; pl <= game->NumPlayers(); pl++) {
+    tables.push_back(DominanceTable(p_support, game->GetPlayer(pl),
+				    p_support.Strategies(game->GetPlayer(pl))));
+    rows.Append(Array<int>(p_support.NumStrategies(pl)));
+    for (int row = 1; row <= rows[pl].Length(); row++) {
+      rows[pl][row] = row;
+    }
+    changed[pl] = true;
+  }
+
+  while (true) {
+    // The undominated strategies of a player remain so until another
+    // player loses a strategy
+    List<GameStrategy> dominated;
+    for (int pl = 1; pl <= game->NumPlayers(); pl++) {
+      if (!changed[pl]) continue;
+      const DominanceTable &table = tables[pl - 1];
+      int min = FindUndominated(table, rows[pl], p_strict);
+      Array<int> undominated(min);
+      for (int i = 1; i <= rows[pl].Length(); i++) {
+	if (i <= min) {
+	  undominated[i] = rows[pl][i];
+	}
+	else {
+	  dominated.Append(table.GetStrategy(rows[pl][i]));
+	}
+      }
+      rows[pl] = undominated;
+      changed[pl] = false;
+
+      if (p_mixed) {
+	Array<bool> mixed;
+	FindMixedDominated(table, rows[pl], p_threads, mixed);
+	undominated = Array<int>();
+	for (int i = 1; i <= rows[pl].Length(); i++) {
+	  if (mixed[i]) {
+	    dominated.Append(table.GetStrategy(rows[pl][i]));
+	  }
+	  else {
+	    undominated.Append(rows[pl][i]);
+	  }
+	}
+	rows[pl] = undominated;
+      }
+    }
+    if (dominated.Length() == 0) {
+      return support;
+    }
+
+    for (int i = 1; i <= dominated.Length(); i++) {
+      support.RemoveStrategy(dominated[i]);
+      if (!p_iterated) continue;
+      for (int pl = 1; pl <= game->NumPlayers(); pl++) {
+	if (pl != dominated[i]->GetPlayer()->GetNumber()) {
+	  tables[pl - 1].RemoveStrategy(dominated[i]);
+	  changed[pl] = true;
+	}
+      }
+    }
+    if (!p_iterated) {
+      return support;
+    }
+  }
+}
+
+}  // end anonymous namespace
+
+bool StrategySupportProfile::Dominates(const GameStrategy &s,
+				const GameStrategy &t, 
+				bool p_strict) const
+{
+  Array<GameStrategy> strategies;
+  strategies.Append(s);
+  strategies.Append(t);
+  return DominanceTable(*this, s->GetPlayer(), strategies).Dominates(1, 2, p_strict);
+}
+
+
+bool StrategySupportProfile::IsDominated(const GameStrategy &s,
+				  bool p_strict,
+				  bool p_external) const
+{
+  GamePlayer player = s->GetPlayer();
+  Array<GameStrategy> strategies;
+  strategies.Append(s);
+  if (p_external) {
+    for (int st = 1; st <= player->NumStrategies(); st++) {
+      if (player->GetStrategy(st) != s) {
+	strategies.Append(player->GetStrategy(st));
+      }
     }
-    
-    return true;
   }
   else {
-    return false;
+    for (int st = 1; st <= NumStrategies(player->GetNumber()); st++) {
+      if (GetStrategy(player->GetNumber(), st) != s) {
+	strategies.Append(GetStrategy(player->GetNumber(), st));
+      }
+    }
+  }
+
+  DominanceTable table(*this, player, strategies);
+  for (int row = 2; row <= table.NumStrategies(); row++) {
+    if (table.Dominates(row, 1, p_strict)) {
+      return true;
+    }
   }
+  return false;
+}
+
+bool StrategySupportProfile::Undominated(StrategySupportProfile &newS, int p_player,
+				  bool p_strict, bool p_external) const
+{
+  Array<GameStrategy> set((p_external) ? 
+			  m_nfg->GetPlayer(p_player)->NumStrategies() :
+			  NumStrategies(p_player));
+
+  if (p_external) {
+    for (int st = 1; st <= set.Length(); st++) {
+      set[st] = m_nfg->GetPlayer(p_player)->GetStrategy(st);
+    }
+  }
+  else {
+    for (int st = 1; st <= set.Length(); st++) {
+      set[st] = GetStrategy(p_player, st);
+    }
+  }
+
+  DominanceTable table(*this, m_nfg->GetPlayer(p_player), set);
+  Array<int> rows(table.NumStrategies());
+  for (int row = 1; row <= rows.Length(); row++) {
+    rows[row] = row;
+  }
+
+  int min = FindUndominated(table, rows, p_strict);
+  for (int i = min + 1; i <= rows.Length(); i++) {
+    newS.RemoveStrategy(table.GetStrategy(rows[i]));
+  }
+  return (min < rows.Length());
 }
 
 StrategySupportProfile StrategySupportProfile::Undominated(bool p_strict,
@@ -361,6 +844,18 @@ StrategySupportProfile::Undominated(bool p_strict, const Array<int> &players) co
   return newS;
 }
 
+StrategySupportProfile
+StrategySupportProfile::IteratedUndominated(bool p_strict) const
+{
+  return EliminateDominated(*this, p_strict, false, true, 1);
+}
+
+StrategySupportProfile
+StrategySupportProfile::MixedUndominated(bool p_iterated, int p_threads) const
+{
+  return EliminateDominated(*this, true, true, p_iterated, p_threads);
+}
+
 //---------------------------------------------------------------------------
 //                Identification of overwhelmed strategies
 //---------------------------------------------------------------------------
@@ -401,7 +896,7 @@ Game StrategySupportProfile::Restrict(void) const
     player->m_unrestricted = m_nfg->Players()[pl];
     for (int st = 1; st <= player->NumStrategies(); st++) {
       GameStrategyRep *strategy = player->m_strategies[st];
-      strategy->m_unrestricted = m_nfg->Players()[pl]->Strategies()[st];
+      strategy->m_unrestricted = m_support[pl][st];
     }
   }
   dynamic_cast<GameTableRep &>(*restricted).m_unrestricted = m_nfg;
@@ -31,6 +31,7 @@
 #include <wx/tokenzr.h>
 
 #include "wx/sheet/sheet.h"
+#include "gambit.h"      // for wxGetApp()
 #include "dlefglogit.h"
 
 class gbtLogitBehavList : public wxSheet {
@@ -260,11 +261,15 @@ void gbtLogitBehavDialog::Start(void)
   m_process = new wxProcess(this, GBT_ID_PROCESS);
   m_process->Redirect();
 
+  wxString cacheOption = wxGetApp().GetLogitCacheOption();
+
 #ifdef __WXMAC__
-  m_pid = wxExecute(wxStandardPaths::Get().GetExecutablePath() + wxT("-logit"),
+  m_pid = wxExecute(wxStandardPaths::Get().GetExecutablePath() + wxT("-logit") +
+		    cacheOption,
 		    wxEXEC_ASYNC, m_process);
 #else	
-  m_pid = wxExecute(wxT("gambit-logit"), wxEXEC_ASYNC, m_process);
+  m_pid = wxExecute(wxT("gambit-logit") + cacheOption,
+		    wxEXEC_ASYNC, m_process);
 #endif // __WXMAC__
   
   std::ostringstream s;
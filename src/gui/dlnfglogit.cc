@@ -36,6 +36,7 @@
 #include "wx/plotctrl/plotctrl.h"
 #include "wx/wxthings/spinctld.h"   // for wxSpinCtrlDbl
 
+#include "gambit.h"              // for wxGetApp()
 #include "gamedoc.h"
 #include "menuconst.h"            // for tool IDs
 
@@ -736,12 +737,15 @@ void LogitMixedDialog::Start(void)
   m_process = new wxProcess(this, GBT_ID_PROCESS);
   m_process->Redirect();
 
+  wxString cacheOption = wxGetApp().GetLogitCacheOption();
+
 #ifdef __WXMAC__
   m_pid = wxExecute(wxStandardPaths::Get().GetExecutablePath() + 
-		    wxT("-logit -S"),
+		    wxT("-logit -S") + cacheOption,
                     wxEXEC_ASYNC, m_process);
 #else
-  m_pid = wxExecute(wxT("gambit-logit -S"), wxEXEC_ASYNC, m_process);
+  m_pid = wxExecute(wxT("gambit-logit -S") + cacheOption,
+		    wxEXEC_ASYNC, m_process);
 #endif // __WXMAC__
   
   std::ostringstream s;
@@ -21,6 +21,8 @@
 //
 
 #include <fstream>
+#include <algorithm>
+#include <vector>
 
 #include <wx/wxprec.h>
 #ifndef WX_PRECOMP
@@ -28,8 +30,12 @@
 #endif  // WX_PRECOMP
 #include <wx/image.h>
 #include <wx/splash.h>
+#include <wx/stdpaths.h>
+#include <wx/filename.h>
+#include <wx/dir.h>
 
 #include "gambit/gambit.h"
+#include "gambit/gametable.h"
 
 #include "gambit.h"
 #include "gameframe.h"
@@ -121,6 +127,13 @@ gbtAppLoadResult gbtApplication::LoadFile(const wxString &p_filename)
 
   try {
     Gambit::Game nfg = Gambit::ReadGame(infile);
+    // The interface edits payoffs through outcomes, which games read
+    // from binary tables do not have until they are created
+    Gambit::GameTableRep *table = 
+      dynamic_cast<Gambit::GameTableRep *>(nfg.operator->());
+    if (table) {
+      table->Materialize();
+    }
 
     m_fileHistory.AddFileToHistory(p_filename);
     m_fileHistory.Save(*wxConfigBase::Get());
@@ -140,6 +153,44 @@ void gbtApplication::SetCurrentDir(const wxString &p_dir)
   wxConfigBase::Get()->Write(_T("/General/CurrentDirectory"), p_dir);
 }
 
+/// The most branches kept in the logit cache directory
+const size_t MAX_LOGIT_CACHE_FILES = 100;
+
+wxString gbtApplication::GetLogitCacheOption(void) const
+{
+  // Caching branches between runs saves tracing a game again when it
+  // is reopened, but the files accumulate, so it is turned on only
+  // when asked for, and the oldest files are removed before each run.
+  bool useCache;
+  wxConfigBase::Get()->Read(_T("/Logit/CacheBranches"), &useCache, false);
+  if (!useCache) {
+    return wxEmptyString;
+  }
+
+  wxString directory = (wxStandardPaths::Get().GetUserDataDir() +
+			wxFileName::GetPathSeparator() + wxT("logit"));
+  if (!wxFileName::DirExists(directory) &&
+      !wxFileName::Mkdir(directory, 0777, wxPATH_MKDIR_FULL)) {
+    return wxEmptyString;
+  }
+
+  wxArrayString files;
+  wxDir::GetAllFiles(directory, &files, wxEmptyString, wxDIR_FILES);
+  if (files.GetCount() >= MAX_LOGIT_CACHE_FILES) {
+    std::vector<std::pair<time_t, wxString> > byAge;
+    for (size_t i = 0; i < files.GetCount(); i++) {
+      wxDateTime modified = wxFileName(files[i]).GetModificationTime();
+      byAge.push_back(std::make_pair(modified.GetTicks(), files[i]));
+    }
+    std::sort(byAge.begin(), byAge.end());
+    for (size_t i = 0; i + MAX_LOGIT_CACHE_FILES <= byAge.size(); i++) {
+      wxRemoveFile(byAge[i].second);
+    }
+  }
+
+  return wxT(" -c \"") + directory + wxT("\"");
+}
+
 bool gbtApplication::AreDocumentsModified(void) const
 {
   for (int i = 1; i <= m_documents.Length(); i++) {
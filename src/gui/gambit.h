@@ -56,6 +56,10 @@ public:
     { m_fileHistory.UseMenu(p_menu); m_fileHistory.AddFilesToMenu(p_menu); }
   void RemoveMenu(wxMenu *p_menu)  { m_fileHistory.RemoveMenu(p_menu); }
   
+  /// Returns the options to pass to gambit-logit for caching branches
+  /// between runs; empty unless caching is turned on in the configuration
+  wxString GetLogitCacheOption(void) const;
+
 
   gbtAppLoadResult LoadFile(const wxString &);
 #ifdef __WXMAC__
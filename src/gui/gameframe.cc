@@ -1320,9 +1320,16 @@ void gbtGameFrame::OnViewStrategic(wxCommandEvent &p_event)
       return;
     }
     
-    int ncont = m_doc->GetGame()->NumStrategyContingencies();
+    long ncont;
+    try {
+      ncont = m_doc->GetGame()->NumStrategyContingencies();
+    }
+    catch (std::exception &ex) {
+      gbtExceptionDialog(this, ex.what()).ShowModal();
+      return;
+    }
     if (!m_nfgPanel && ncont >= 50000) {
-      if (wxMessageBox(wxString::Format(wxT("This game has %d contingencies in strategic form.\n"), ncont) +
+      if (wxMessageBox(wxString::Format(wxT("This game has %ld contingencies in strategic form.\n"), ncont) +
 		       wxT("Performance in browsing strategic form will be poor,\n") +
 		       wxT("and may render the program nonresponsive.\n") +
 		       wxT("Do you wish to continue?"),
@@ -1451,9 +1458,16 @@ void gbtGameFrame::OnToolsEquilibrium(wxCommandEvent &)
 
   if (dialog.ShowModal() == wxID_OK) {
     if (dialog.UseStrategic()) {
-      int ncont = m_doc->GetGame()->NumStrategyContingencies();
+      long ncont;
+      try {
+	ncont = m_doc->GetGame()->NumStrategyContingencies();
+      }
+      catch (std::exception &ex) {
+	gbtExceptionDialog(this, ex.what()).ShowModal();
+	return;
+      }
       if (ncont >= 50000) {
-	if (wxMessageBox(wxString::Format(wxT("This game has %d contingencies in strategic form.\n"), ncont) +
+	if (wxMessageBox(wxString::Format(wxT("This game has %ld contingencies in strategic form.\n"), ncont) +
 			 wxT("Performance in solving strategic form will be poor,\n") +
 			 wxT("and may render the program nonresponsive.\n") +
 			 wxT("Do you wish to continue?"),
@@ -137,8 +137,10 @@ cdef class Game(object):
         for i in range(1, len(dim)+1):
             setitem_array_int(d, i, dim[i-1])
         g = cls()
-        g.game = NewTable(d)
-        del d
+        try:
+            g.game = NewTable(d)
+        finally:
+            del d
         return g
 
     @classmethod
@@ -284,6 +286,32 @@ cdef class Game(object):
         def __get__(self):
             return rat_to_py(self.game.deref().GetMaxPayoff(0))
 
+    def payoff_array(self, player):
+        """Returns the payoffs to the player in each contingency of a
+        table game, as a read-only NumPy array with one dimension per
+        player, indexed by strategy number as for game[...]."""
+        import numpy
+        cdef cvarray payoffs
+        if isinstance(player, (int, str)):
+            player = self.players[player]
+        elif not isinstance(player, Player):
+            raise TypeError("player index must be int, str, or Player, not %s" %
+                            player.__class__.__name__)
+        if self.is_tree:
+            raise UndefinedOperationError("Payoff arrays are only "\
+                                          "defined for strategic games")
+        shape = tuple(len(p.strategies) for p in self.players)
+        payoffs = cvarray(shape=shape, itemsize=sizeof(double),
+                          format="d", mode="fortran")
+        if not copypayoffs(self.game,
+                           (<Player>player).player.deref().GetNumber(),
+                           <double *> payoffs.data):
+            raise UndefinedOperationError("Payoff arrays are only "\
+                                          "defined for table games")
+        array = numpy.asarray(payoffs)
+        array.flags.writeable = False
+        return array
+
     def _get_contingency(self, *args):
         cdef c_PureStrategyProfile *psp
         cdef Outcome outcome
@@ -27,6 +27,7 @@ import fractions
 import warnings
 from libcpp cimport bool
 from libcpp.string cimport string
+from cython.view cimport array as cvarray
 
 class Decimal(decimal.Decimal):
     pass
@@ -211,6 +212,7 @@ cdef extern from "gambit/game.h":
 
     cdef cppclass c_GameRep "GameRep":
         int IsTree()
+        bool PrepareConcurrentAccess() except +RuntimeError
         
         string GetTitle()
         void SetTitle(string)
@@ -259,7 +261,7 @@ cdef extern from "gambit/game.h":
         c_Rational GetPayoff(int)
 
     c_Game NewTree()
-    c_Game NewTable(Array[int] *)
+    c_Game NewTable(Array[int] *) except +
 
 # The spaces in the quoted C++ names of the strategy and behavior profiles
 # are required to avoid adjacent angle brackets when generating e.g.
@@ -363,6 +365,8 @@ cdef extern from "gambit/stratspt.h":
         c_GameStrategy GetStrategy(int, int) except +IndexError
         bool Contains(c_GameStrategy)
         c_StrategySupportProfile Undominated(bool, bool)
+        c_StrategySupportProfile IteratedUndominated(bool)
+        c_StrategySupportProfile MixedUndominated(bool, int)
         c_MixedStrategyProfileDouble NewMixedStrategyProfileDouble "NewMixedStrategyProfile<double>"()
         c_MixedStrategyProfileRational NewMixedStrategyProfileRational "NewMixedStrategyProfile<Rational>"()
 
@@ -390,6 +394,17 @@ cdef extern from "util.h":
     void setitem_mbpr_action "setitem"(c_MixedBehaviorProfileRational *,
                                        c_GameAction, c_Rational)
 
+    double *getdata_mspd "getdata"(c_MixedStrategyProfileDouble *) except +IndexError
+    double getvalue_mspd "getvalue"(c_MixedStrategyProfileDouble *, int) except +
+    c_Rational getvalue_mspr "getvalue"(c_MixedStrategyProfileRational *, int) except +
+    double getjacobian_mspd "getjacobian"(c_MixedStrategyProfileDouble *,
+                                          int, int) except +
+    c_Rational getjacobian_mspr "getjacobian"(c_MixedStrategyProfileRational *,
+                                              int, int) except +
+    void copyvalues(c_MixedStrategyProfileDouble *, double *) except +
+    void copyjacobian(c_MixedStrategyProfileDouble *, double *) except +
+    bint copypayoffs(c_Game, int, double *) except +RuntimeError
+
     c_MixedStrategyProfileDouble *copyitem_list_mspd "copyitem"(c_List[c_MixedStrategyProfileDouble], int)
     c_MixedStrategyProfileRational *copyitem_list_mspr "copyitem"(c_List[c_MixedStrategyProfileRational], int)
     c_MixedBehaviorProfileDouble *copyitem_list_mbpd "copyitem"(c_List[c_MixedBehaviorProfileDouble], int)
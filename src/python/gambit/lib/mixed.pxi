@@ -158,7 +158,17 @@ cdef class MixedStrategyProfile(object):
         elif not isinstance(player, Player):
             raise TypeError("argument should be a str or Player instance; received {}"
                             .format(player.__class__.__name__))
-        return [self.strategy_value(item) for item in player.strategies]
+        if len(self) != len(self.game.strategies):
+            return [self.strategy_value(item) for item in player.strategies]
+        # The values of all strategies are computed together, in profile order
+        offset = sum(len(p.strategies) for p in list(self.game.players)[:player.number])
+        return self._strategy_values()[offset:offset+len(player.strategies)]
+
+    def payoff_jacobian(self):
+        """Returns the matrix of derivatives of each strategy's value with
+        respect to the probability each strategy is played, as a list of
+        rows indexed in the same order as the profile."""
+        return self._payoff_jacobian()
 
     def strategy_value_deriv(self, player, strategy1, strategy2):
         if isinstance(player, (int, str)):
@@ -180,12 +190,31 @@ cdef class MixedStrategyProfile(object):
 
 cdef class MixedStrategyProfileDouble(MixedStrategyProfile):
     cdef c_MixedStrategyProfileDouble *profile
+    cdef Py_ssize_t buffer_shape[1]
 
     def __dealloc__(self):
         del self.profile
     def __len__(self):
         return self.profile.MixedProfileLength()
 
+    # The probabilities are exported through the buffer protocol, so that
+    # e.g. numpy.asarray() gives a writable view sharing their storage.
+    def __getbuffer__(self, Py_buffer *buffer, int flags):
+        self.buffer_shape[0] = self.profile.MixedProfileLength()
+        buffer.buf = <char *> getdata_mspd(self.profile)
+        buffer.obj = self
+        buffer.len = self.buffer_shape[0] * sizeof(double)
+        buffer.readonly = 0
+        buffer.itemsize = sizeof(double)
+        buffer.format = b"d"
+        buffer.ndim = 1
+        buffer.shape = self.buffer_shape
+        buffer.strides = NULL
+        buffer.suboffsets = NULL
+        buffer.internal = NULL
+    def __releasebuffer__(self, Py_buffer *buffer):
+        pass
+
     def _strategy_index(self, Strategy st):
         return self.profile.GetSupport().GetIndex(st.strategy)
     def _getprob(self, int index):
@@ -203,6 +232,34 @@ cdef class MixedStrategyProfileDouble(MixedStrategyProfile):
     def _strategy_value_deriv(self, int pl,
                               Strategy s1, Strategy s2):
         return self.profile.GetPayoffDeriv(pl, s1.strategy, s2.strategy)
+    def _strategy_values(self):
+        return [getvalue_mspd(self.profile, i) for i in range(1, len(self)+1)]
+    def _payoff_jacobian(self):
+        return [[getjacobian_mspd(self.profile, i, j) for j in range(1, len(self)+1)]
+                for i in range(1, len(self)+1)]
+
+    def as_array(self):
+        """Returns the probabilities as a NumPy array which shares
+        storage with the profile, so that changes to either are seen in
+        the other."""
+        import numpy
+        return numpy.asarray(self)
+    def strategy_values_array(self):
+        """Returns the payoff to each strategy, in profile order, as a
+        NumPy array."""
+        import numpy
+        cdef cvarray values = cvarray(shape=(len(self),), itemsize=sizeof(double),
+                                      format="d")
+        copyvalues(self.profile, <double *> values.data)
+        return numpy.asarray(values)
+    def payoff_jacobian_array(self):
+        """Returns the payoff Jacobian (see payoff_jacobian()) as a
+        two-dimensional NumPy array."""
+        import numpy
+        cdef cvarray jacobian = cvarray(shape=(len(self), len(self)),
+                                        itemsize=sizeof(double), format="d")
+        copyjacobian(self.profile, <double *> jacobian.data)
+        return numpy.asarray(jacobian)
 
     def liap_value(self):
         return self.profile.GetLiapValue()
@@ -275,6 +332,13 @@ cdef class MixedStrategyProfileRational(MixedStrategyProfile):
     def _strategy_value_deriv(self, int pl,
                               Strategy s1, Strategy s2):
         return rat_to_py(self.profile.GetPayoffDeriv(pl, s1.strategy, s2.strategy))
+    def _strategy_values(self):
+        return [rat_to_py(getvalue_mspr(self.profile, i))
+                for i in range(1, len(self)+1)]
+    def _payoff_jacobian(self):
+        return [[rat_to_py(getjacobian_mspr(self.profile, i, j))
+                 for j in range(1, len(self)+1)]
+                for i in range(1, len(self)+1)]
 
     def liap_value(self):
         return rat_to_py(self.profile.GetLiapValue())
@@ -22,6 +22,12 @@
 
 #include "gambit/gambit.h"
 #include "tools/logit/nfglogit.h"
+#include "tools/logit/efglogit.h"
+#include "tools/liap/nfgliap.h"
+#include "tools/liap/efgliap.h"
+#include "tools/enumpoly/enumpoly.h"
+#include "gambit/nash/enummixed.h"
+#include "gambit/nash/lcp.h"
 
 using namespace std;
 using namespace Gambit;
@@ -64,3 +70,98 @@ logit_principal_branch(const Game &p_game, double p_maxLambda=1000000.0)
   return alg.TraceStrategicPath(p_game, null_stream, p_maxLambda, 1.0);
 }
 
+// The solvers below report equilibria to a renderer or stream as they
+// go; the shims discard that output and return the equilibria found.
+
+List<MixedStrategyProfile<double> >
+logit_strategy_solve(const Game &p_game, double p_maxLambda=1000000.0)
+{
+  LogitQREMixedStrategyProfile start(p_game);
+  StrategicQREPathTracer alg;
+  alg.SetFullGraph(false);
+  NullBuffer null_buffer;
+  std::ostream null_stream(&null_buffer);
+  List<LogitQREMixedStrategyProfile> qres =
+    alg.TraceStrategicPath(start, null_stream, p_maxLambda, 1.0);
+  List<MixedStrategyProfile<double> > solutions;
+  for (int i = 1; i <= qres.Length(); i++) {
+    solutions.push_back(qres[i].GetProfile());
+  }
+  return solutions;
+}
+
+List<MixedBehaviorProfile<double> >
+logit_behavior_solve(const Game &p_game, double p_maxLambda=1000000.0)
+{
+  LogitQREMixedBehaviorProfile start(p_game);
+  AgentQREPathTracer alg;
+  alg.SetFullGraph(false);
+  NullBuffer null_buffer;
+  std::ostream null_stream(&null_buffer);
+  List<LogitQREMixedBehaviorProfile> qres =
+    alg.TraceAgentPath(start, null_stream, p_maxLambda, 1.0);
+  List<MixedBehaviorProfile<double> > solutions;
+  for (int i = 1; i <= qres.Length(); i++) {
+    solutions.push_back(qres[i].GetProfile());
+  }
+  return solutions;
+}
+
+List<MixedStrategyProfile<double> >
+liap_strategy_solve(const Game &p_game, int p_tries, int p_maxits,
+		    int p_threads)
+{
+  List<MixedStrategyProfile<double> > starts;
+  for (int i = 1; i <= p_tries; i++) {
+    MixedStrategyProfile<double> p(p_game->NewMixedStrategyProfile(0.0));
+    p.Randomize();
+    starts.push_back(p);
+  }
+  NashLiapStrategySolver alg(p_maxits);
+  return alg.Solve(starts, p_threads);
+}
+
+List<MixedBehaviorProfile<double> >
+liap_behavior_solve(const Game &p_game, int p_tries, int p_maxits,
+		    int p_threads)
+{
+  List<MixedBehaviorProfile<double> > starts;
+  for (int i = 1; i <= p_tries; i++) {
+    MixedBehaviorProfile<double> p(p_game);
+    p.Randomize();
+    starts.push_back(p);
+  }
+  NashLiapBehavSolver alg(p_maxits);
+  return alg.Solve(starts, p_threads);
+}
+
+List<MixedStrategyProfile<double> >
+enumpoly_strategy_solve(const Game &p_game)
+{
+  NullBuffer null_buffer;
+  std::ostream null_stream(&null_buffer);
+  return SolveStrategic(p_game, null_stream);
+}
+
+List<MixedBehaviorProfile<double> >
+enumpoly_behavior_solve(const Game &p_game)
+{
+  NullBuffer null_buffer;
+  std::ostream null_stream(&null_buffer);
+  return SolveExtensive(p_game, null_stream);
+}
+
+List<MixedStrategyProfile<double> >
+enummixed_strategy_solve_double(const Game &p_game, bool p_dense)
+{
+  Nash::EnumMixedStrategySolver<double> alg(0, p_dense);
+  return alg.Solve(p_game);
+}
+
+List<MixedStrategyProfile<double> >
+lcp_strategy_solve_double(const Game &p_game, int p_stopAfter, int p_maxDepth,
+			  bool p_dense)
+{
+  Nash::NashLcpStrategySolver<double> alg(p_stopAfter, p_maxDepth, 0, 1, p_dense);
+  return alg.Solve(p_game);
+}
@@ -20,14 +20,19 @@
 # Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
 #
 
+cdef bint _prepare_concurrent(Game game) except *:
+    # Solvers run without holding the GIL only on representations which
+    # can be safely read by several threads at once.
+    return game.game.deref().PrepareConcurrentAccess()
+
 cdef extern from "gambit/nash/enumpure.h":
     cdef cppclass c_NashEnumPureStrategySolver "EnumPureStrategySolver":
         c_NashEnumPureStrategySolver()
-        c_List[c_MixedStrategyProfileRational] Solve(c_Game) except +RuntimeError
+        c_List[c_MixedStrategyProfileRational] Solve(c_Game) except +RuntimeError nogil
 
     cdef cppclass c_NashEnumPureAgentSolver "EnumPureAgentSolver":
         c_NashEnumPureAgentSolver()
-        c_List[c_MixedBehaviorProfileRational] Solve(c_Game) except +RuntimeError
+        c_List[c_MixedBehaviorProfileRational] Solve(c_Game) except +RuntimeError nogil
 
 cdef class EnumPureStrategySolver(object):
     cdef c_NashEnumPureStrategySolver *alg
@@ -37,9 +42,14 @@ cdef class EnumPureStrategySolver(object):
     def __dealloc__(self):
         del self.alg
     def solve(self, Game game):
+        cdef c_Game g = game.game
         cdef c_List[c_MixedStrategyProfileRational] solns
         cdef MixedStrategyProfileRational p
-        solns = self.alg.Solve(game.game)
+        if _prepare_concurrent(game):
+            with nogil:
+                solns = self.alg.Solve(g)
+        else:
+            solns = self.alg.Solve(g)
         ret = [ ]
         for i in xrange(solns.Length()):
             p = MixedStrategyProfileRational()
@@ -55,9 +65,14 @@ cdef class EnumPureAgentSolver(object):
     def __dealloc__(self):
         del self.alg
     def solve(self, Game game):
+        cdef c_Game g = game.game
         cdef c_List[c_MixedBehaviorProfileRational] solns
         cdef MixedBehaviorProfileRational p
-        solns = self.alg.Solve(game.game)
+        if _prepare_concurrent(game):
+            with nogil:
+                solns = self.alg.Solve(g)
+        else:
+            solns = self.alg.Solve(g)
         ret = [ ]
         for i in xrange(solns.Length()):
             p = MixedBehaviorProfileRational()
@@ -66,29 +81,32 @@ cdef class EnumPureAgentSolver(object):
         return ret
 
 cdef extern from "gambit/nash/enummixed.h":
-    cdef cppclass c_NashEnumMixedStrategySolverDouble "EnumMixedStrategySolver<double>":
-        c_NashEnumMixedStrategySolverDouble()
-        c_List[c_MixedStrategyProfileDouble] Solve(c_Game) except +RuntimeError
-
     cdef cppclass c_NashEnumMixedStrategySolverRational "EnumMixedStrategySolver<Rational>":
         c_NashEnumMixedStrategySolverRational()
-        c_List[c_MixedStrategyProfileRational] Solve(c_Game) except +RuntimeError
+        c_List[c_MixedStrategyProfileRational] Solve(c_Game) except +RuntimeError nogil
 
     cdef cppclass c_NashEnumMixedLrsStrategySolver "EnumMixedLrsStrategySolver":
         c_NashEnumMixedLrsStrategySolver()
         c_List[c_MixedStrategyProfileRational] Solve(c_Game) except +RuntimeError
 
+cdef extern from "nash.h":
+    c_List[c_MixedStrategyProfileDouble] _enummixed_strategy_solve_double "enummixed_strategy_solve_double"(c_Game, bint) except +RuntimeError nogil
+    c_List[c_MixedStrategyProfileDouble] _lcp_strategy_solve_double "lcp_strategy_solve_double"(c_Game, int, int, bint) except +RuntimeError nogil
+
 cdef class EnumMixedStrategySolverDouble(object):
-    cdef c_NashEnumMixedStrategySolverDouble *alg
+    cdef bint dense
 
-    def __cinit__(self):
-        self.alg = new c_NashEnumMixedStrategySolverDouble()
-    def __dealloc__(self):
-        del self.alg
+    def __cinit__(self, p_dense=False):
+        self.dense = p_dense
     def solve(self, Game game):
+        cdef c_Game g = game.game
         cdef c_List[c_MixedStrategyProfileDouble] solns
         cdef MixedStrategyProfileDouble p
-        solns = self.alg.Solve(game.game)
+        if _prepare_concurrent(game):
+            with nogil:
+                solns = _enummixed_strategy_solve_double(g, self.dense)
+        else:
+            solns = _enummixed_strategy_solve_double(g, self.dense)
         ret = [ ]
         for i in xrange(solns.Length()):
             p = MixedStrategyProfileDouble()
@@ -104,9 +122,14 @@ cdef class EnumMixedStrategySolverRational(object):
     def __dealloc__(self):
         del self.alg
     def solve(self, Game game):
+        cdef c_Game g = game.game
         cdef c_List[c_MixedStrategyProfileRational] solns
         cdef MixedStrategyProfileRational p
-        solns = self.alg.Solve(game.game)
+        if _prepare_concurrent(game):
+            with nogil:
+                solns = self.alg.Solve(g)
+        else:
+            solns = self.alg.Solve(g)
         ret = [ ]
         for i in xrange(solns.Length()):
             p = MixedStrategyProfileRational()
@@ -133,21 +156,17 @@ cdef class EnumMixedLrsStrategySolver(object):
         return ret
 
 cdef extern from "gambit/nash/lcp.h":
-    cdef cppclass c_NashLcpStrategySolverDouble "NashLcpStrategySolver<double>":
-        c_NashLcpStrategySolverDouble(int, int)
-        c_List[c_MixedStrategyProfileDouble] Solve(c_Game) except +RuntimeError
-
     cdef cppclass c_NashLcpStrategySolverRational "NashLcpStrategySolver<Rational>":
         c_NashLcpStrategySolverRational(int, int)
-        c_List[c_MixedStrategyProfileRational] Solve(c_Game) except +RuntimeError
+        c_List[c_MixedStrategyProfileRational] Solve(c_Game) except +RuntimeError nogil
 
     cdef cppclass c_NashLcpBehaviorSolverDouble "NashLcpBehaviorSolver<double>":
         c_NashLcpBehaviorSolverDouble(int, int)
-        c_List[c_MixedBehaviorProfileDouble] Solve(c_Game) except +RuntimeError
+        c_List[c_MixedBehaviorProfileDouble] Solve(c_Game) except +RuntimeError nogil
 
     cdef cppclass c_NashLcpBehaviorSolverRational "NashLcpBehaviorSolver<Rational>":
         c_NashLcpBehaviorSolverRational(int, int)
-        c_List[c_MixedBehaviorProfileRational] Solve(c_Game) except +RuntimeError
+        c_List[c_MixedBehaviorProfileRational] Solve(c_Game) except +RuntimeError nogil
 
 
 cdef class LCPBehaviorSolverDouble(object):
@@ -158,9 +177,14 @@ cdef class LCPBehaviorSolverDouble(object):
     def __dealloc__(self):
         del self.alg
     def solve(self, Game game):
+        cdef c_Game g = game.game
         cdef c_List[c_MixedBehaviorProfileDouble] solns
         cdef MixedBehaviorProfileDouble p
-        solns = self.alg.Solve(game.game)
+        if _prepare_concurrent(game):
+            with nogil:
+                solns = self.alg.Solve(g)
+        else:
+            solns = self.alg.Solve(g)
         ret = [ ]
         for i in xrange(solns.Length()):
             p = MixedBehaviorProfileDouble()
@@ -176,9 +200,14 @@ cdef class LCPBehaviorSolverRational(object):
     def __dealloc__(self):
         del self.alg
     def solve(self, Game game):
+        cdef c_Game g = game.game
         cdef c_List[c_MixedBehaviorProfileRational] solns
         cdef MixedBehaviorProfileRational p
-        solns = self.alg.Solve(game.game)
+        if _prepare_concurrent(game):
+            with nogil:
+                solns = self.alg.Solve(g)
+        else:
+            solns = self.alg.Solve(g)
         ret = [ ]
         for i in xrange(solns.Length()):
             p = MixedBehaviorProfileRational()
@@ -187,16 +216,24 @@ cdef class LCPBehaviorSolverRational(object):
         return ret
 
 cdef class LCPStrategySolverDouble(object): 
-    cdef c_NashLcpStrategySolverDouble *alg
+    cdef int stopAfter, maxDepth
+    cdef bint dense
 
-    def __cinit__(self, p_stopAfter=0, p_maxDepth=0):
-        self.alg = new c_NashLcpStrategySolverDouble(p_stopAfter, p_maxDepth)
-    def __dealloc__(self):
-        del self.alg
+    def __cinit__(self, p_stopAfter=0, p_maxDepth=0, p_dense=False):
+        self.stopAfter = p_stopAfter
+        self.maxDepth = p_maxDepth
+        self.dense = p_dense
     def solve(self, Game game):
+        cdef c_Game g = game.game
         cdef c_List[c_MixedStrategyProfileDouble] solns
         cdef MixedStrategyProfileDouble p
-        solns = self.alg.Solve(game.game)
+        if _prepare_concurrent(game):
+            with nogil:
+                solns = _lcp_strategy_solve_double(g, self.stopAfter,
+                                                   self.maxDepth, self.dense)
+        else:
+            solns = _lcp_strategy_solve_double(g, self.stopAfter,
+                                               self.maxDepth, self.dense)
         ret = [ ]
         for i in xrange(solns.Length()):
             p = MixedStrategyProfileDouble()
@@ -212,9 +249,14 @@ cdef class LCPStrategySolverRational(object):
     def __dealloc__(self):
         del self.alg
     def solve(self, Game game):
+        cdef c_Game g = game.game
         cdef c_List[c_MixedStrategyProfileRational] solns
         cdef MixedStrategyProfileRational p
-        solns = self.alg.Solve(game.game)
+        if _prepare_concurrent(game):
+            with nogil:
+                solns = self.alg.Solve(g)
+        else:
+            solns = self.alg.Solve(g)
         ret = [ ]
         for i in xrange(solns.Length()):
             p = MixedStrategyProfileRational()
@@ -226,20 +268,20 @@ cdef class LCPStrategySolverRational(object):
 cdef extern from "tools/lp/nfglp.h":
     cdef cppclass c_NashLpStrategySolverDouble "NashLpStrategySolver<double>":
         c_NashLpStrategySolverDouble()
-        c_List[c_MixedStrategyProfileDouble] Solve(c_Game) except +RuntimeError
+        c_List[c_MixedStrategyProfileDouble] Solve(c_Game) except +RuntimeError nogil
 
     cdef cppclass c_NashLpStrategySolverRational "NashLpStrategySolver<Rational>":
         c_NashLpStrategySolverRational()
-        c_List[c_MixedStrategyProfileRational] Solve(c_Game) except +RuntimeError
+        c_List[c_MixedStrategyProfileRational] Solve(c_Game) except +RuntimeError nogil
 
 cdef extern from "tools/lp/efglp.h":
     cdef cppclass c_NashLpBehavSolverDouble "NashLpBehavSolver<double>":
         c_NashLpBehavSolverDouble()
-        c_List[c_MixedBehaviorProfileDouble] Solve(c_Game) except +RuntimeError
+        c_List[c_MixedBehaviorProfileDouble] Solve(c_Game) except +RuntimeError nogil
 
     cdef cppclass c_NashLpBehavSolverRational "NashLpBehavSolver<Rational>":
         c_NashLpBehavSolverRational()
-        c_List[c_MixedBehaviorProfileRational] Solve(c_Game) except +RuntimeError
+        c_List[c_MixedBehaviorProfileRational] Solve(c_Game) except +RuntimeError nogil
 
 
 cdef class LPBehaviorSolverDouble(object):
@@ -250,9 +292,14 @@ cdef class LPBehaviorSolverDouble(object):
     def __dealloc__(self):
         del self.alg
     def solve(self, Game game):
+        cdef c_Game g = game.game
         cdef c_List[c_MixedBehaviorProfileDouble] solns
         cdef MixedBehaviorProfileDouble p
-        solns = self.alg.Solve(game.game)
+        if _prepare_concurrent(game):
+            with nogil:
+                solns = self.alg.Solve(g)
+        else:
+            solns = self.alg.Solve(g)
         ret = [ ]
         for i in xrange(solns.Length()):
             p = MixedBehaviorProfileDouble()
@@ -268,9 +315,14 @@ cdef class LPBehaviorSolverRational(object):
     def __dealloc__(self):
         del self.alg
     def solve(self, Game game):
+        cdef c_Game g = game.game
         cdef c_List[c_MixedBehaviorProfileRational] solns
         cdef MixedBehaviorProfileRational p
-        solns = self.alg.Solve(game.game)
+        if _prepare_concurrent(game):
+            with nogil:
+                solns = self.alg.Solve(g)
+        else:
+            solns = self.alg.Solve(g)
         ret = [ ]
         for i in xrange(solns.Length()):
             p = MixedBehaviorProfileRational()
@@ -286,9 +338,14 @@ cdef class LPStrategySolverDouble(object):
     def __dealloc__(self):
         del self.alg
     def solve(self, Game game):
+        cdef c_Game g = game.game
         cdef c_List[c_MixedStrategyProfileDouble] solns
         cdef MixedStrategyProfileDouble p
-        solns = self.alg.Solve(game.game)
+        if _prepare_concurrent(game):
+            with nogil:
+                solns = self.alg.Solve(g)
+        else:
+            solns = self.alg.Solve(g)
         ret = [ ]
         for i in xrange(solns.Length()):
             p = MixedStrategyProfileDouble()
@@ -304,9 +361,14 @@ cdef class LPStrategySolverRational(object):
     def __dealloc__(self):
         del self.alg
     def solve(self, Game game):
+        cdef c_Game g = game.game
         cdef c_List[c_MixedStrategyProfileRational] solns
         cdef MixedStrategyProfileRational p
-        solns = self.alg.Solve(game.game)
+        if _prepare_concurrent(game):
+            with nogil:
+                solns = self.alg.Solve(g)
+        else:
+            solns = self.alg.Solve(g)
         ret = [ ]
         for i in xrange(solns.Length()):
             p = MixedStrategyProfileRational()
@@ -318,8 +380,8 @@ cdef class LPStrategySolverRational(object):
 cdef extern from "gambit/nash/simpdiv.h":
     cdef cppclass c_NashSimpdivStrategySolver "NashSimpdivStrategySolver":
         c_NashSimpdivStrategySolver()
-        c_List[c_MixedStrategyProfileRational] Solve(c_Game) except +RuntimeError
-        c_List[c_MixedStrategyProfileRational] Solve(c_MixedStrategyProfileRational) except +RuntimeError
+        c_List[c_MixedStrategyProfileRational] Solve(c_Game) except +RuntimeError nogil
+        c_List[c_MixedStrategyProfileRational] Solve(c_MixedStrategyProfileRational) except +RuntimeError nogil
 
 cdef class SimpdivStrategySolver(object):
     cdef c_NashSimpdivStrategySolver *alg
@@ -329,9 +391,14 @@ cdef class SimpdivStrategySolver(object):
     def __dealloc__(self):
         del self.alg
     def solve(self, Game game):
+        cdef c_Game g = game.game
         cdef c_List[c_MixedStrategyProfileRational] solns
         cdef MixedStrategyProfileRational p
-        solns = self.alg.Solve(game.game)
+        if _prepare_concurrent(game):
+            with nogil:
+                solns = self.alg.Solve(g)
+        else:
+            solns = self.alg.Solve(g)
         ret = [ ]
         for i in xrange(solns.Length()):
             p = MixedStrategyProfileRational()
@@ -342,7 +409,7 @@ cdef class SimpdivStrategySolver(object):
 cdef extern from "gambit/nash/ipa.h":
     cdef cppclass c_NashIPAStrategySolver "NashIPAStrategySolver":
         c_NashIPAStrategySolver()
-        c_List[c_MixedStrategyProfileDouble] Solve(c_Game) except +RuntimeError
+        c_List[c_MixedStrategyProfileDouble] Solve(c_Game) except +RuntimeError nogil
 
 cdef class IPAStrategySolver(object):
     cdef c_NashIPAStrategySolver *alg
@@ -352,9 +419,14 @@ cdef class IPAStrategySolver(object):
     def __dealloc__(self):
         del self.alg
     def solve(self, Game game):
+        cdef c_Game g = game.game
         cdef c_List[c_MixedStrategyProfileDouble] solns
         cdef MixedStrategyProfileDouble p
-        solns = self.alg.Solve(game.game)
+        if _prepare_concurrent(game):
+            with nogil:
+                solns = self.alg.Solve(g)
+        else:
+            solns = self.alg.Solve(g)
         ret = [ ]
         for i in xrange(solns.Length()):
             p = MixedStrategyProfileDouble()
@@ -365,7 +437,7 @@ cdef class IPAStrategySolver(object):
 cdef extern from "gambit/nash/gnm.h":
     cdef cppclass c_NashGNMStrategySolver "NashGNMStrategySolver":
         c_NashGNMStrategySolver()
-        c_List[c_MixedStrategyProfileDouble] Solve(c_Game) except +RuntimeError
+        c_List[c_MixedStrategyProfileDouble] Solve(c_Game) except +RuntimeError nogil
 
 cdef class GNMStrategySolver(object):
     cdef c_NashGNMStrategySolver *alg
@@ -375,9 +447,44 @@ cdef class GNMStrategySolver(object):
     def __dealloc__(self):
         del self.alg
     def solve(self, Game game):
+        cdef c_Game g = game.game
         cdef c_List[c_MixedStrategyProfileDouble] solns
         cdef MixedStrategyProfileDouble p
-        solns = self.alg.Solve(game.game)
+        if _prepare_concurrent(game):
+            with nogil:
+                solns = self.alg.Solve(g)
+        else:
+            solns = self.alg.Solve(g)
+        ret = [ ]
+        for i in xrange(solns.Length()):
+            p = MixedStrategyProfileDouble()
+            p.profile = copyitem_list_mspd(solns, i+1)
+            ret.append(p)
+        return ret
+
+cdef extern from "nash.h":
+    c_List[c_MixedStrategyProfileDouble] _liap_strategy_solve "liap_strategy_solve"(c_Game, int, int, int) except +RuntimeError nogil
+    c_List[c_MixedBehaviorProfileDouble] _liap_behavior_solve "liap_behavior_solve"(c_Game, int, int, int) except +RuntimeError nogil
+    c_List[c_MixedStrategyProfileDouble] _enumpoly_strategy_solve "enumpoly_strategy_solve"(c_Game) except +RuntimeError
+    c_List[c_MixedBehaviorProfileDouble] _enumpoly_behavior_solve "enumpoly_behavior_solve"(c_Game) except +RuntimeError
+
+cdef class LiapStrategySolver(object):
+    cdef int tries, maxits, threads
+
+    def __cinit__(self, p_tries=10, p_maxits=100, p_threads=1):
+        self.tries = p_tries
+        self.maxits = p_maxits
+        self.threads = p_threads
+    def solve(self, Game game):
+        cdef c_Game g = game.game
+        cdef c_List[c_MixedStrategyProfileDouble] solns
+        cdef MixedStrategyProfileDouble p
+        if _prepare_concurrent(game):
+            with nogil:
+                solns = _liap_strategy_solve(g, self.tries, self.maxits,
+                                             self.threads)
+        else:
+            solns = _liap_strategy_solve(g, self.tries, self.maxits, 1)
         ret = [ ]
         for i in xrange(solns.Length()):
             p = MixedStrategyProfileDouble()
@@ -385,6 +492,56 @@ cdef class GNMStrategySolver(object):
             ret.append(p)
         return ret
 
+cdef class LiapBehaviorSolver(object):
+    cdef int tries, maxits, threads
+
+    def __cinit__(self, p_tries=10, p_maxits=100, p_threads=1):
+        self.tries = p_tries
+        self.maxits = p_maxits
+        self.threads = p_threads
+    def solve(self, Game game):
+        cdef c_Game g = game.game
+        cdef c_List[c_MixedBehaviorProfileDouble] solns
+        cdef MixedBehaviorProfileDouble p
+        if _prepare_concurrent(game):
+            with nogil:
+                solns = _liap_behavior_solve(g, self.tries, self.maxits,
+                                             self.threads)
+        else:
+            solns = _liap_behavior_solve(g, self.tries, self.maxits, 1)
+        ret = [ ]
+        for i in xrange(solns.Length()):
+            p = MixedBehaviorProfileDouble()
+            p.profile = copyitem_list_mbpd(solns, i+1)
+            ret.append(p)
+        return ret
+
+# The polynomial system solvers keep their settings in global variables,
+# so these hold the GIL while they run.
+cdef class EnumPolyStrategySolver(object):
+    def solve(self, Game game):
+        cdef c_List[c_MixedStrategyProfileDouble] solns
+        cdef MixedStrategyProfileDouble p
+        solns = _enumpoly_strategy_solve(game.game)
+        ret = [ ]
+        for i in xrange(solns.Length()):
+            p = MixedStrategyProfileDouble()
+            p.profile = copyitem_list_mspd(solns, i+1)
+            ret.append(p)
+        return ret
+
+cdef class EnumPolyBehaviorSolver(object):
+    def solve(self, Game game):
+        cdef c_List[c_MixedBehaviorProfileDouble] solns
+        cdef MixedBehaviorProfileDouble p
+        solns = _enumpoly_behavior_solve(game.game)
+        ret = [ ]
+        for i in xrange(solns.Length()):
+            p = MixedBehaviorProfileDouble()
+            p.profile = copyitem_list_mbpd(solns, i+1)
+            ret.append(p)
+        return ret
+
 cdef extern from "tools/logit/nfglogit.h":
     cdef cppclass c_LogitQREMixedStrategyProfile "LogitQREMixedStrategyProfile":
         c_LogitQREMixedStrategyProfile(c_Game)
@@ -408,7 +565,51 @@ cdef extern from "nash.h":
     c_LogitQREMixedStrategyProfile *_logit_estimate "logit_estimate"(c_MixedStrategyProfileDouble *)
     c_LogitQREMixedStrategyProfile *_logit_atlambda "logit_atlambda"(c_Game, double)
     c_List[c_LogitQREMixedStrategyProfile] _logit_principal_branch "logit_principal_branch"(c_Game, double)
+    c_List[c_MixedStrategyProfileDouble] _logit_strategy_solve "logit_strategy_solve"(c_Game, double) except +RuntimeError nogil
+    c_List[c_MixedBehaviorProfileDouble] _logit_behavior_solve "logit_behavior_solve"(c_Game, double) except +RuntimeError nogil
     
+cdef class LogitStrategySolver(object):
+    cdef double maxLambda
+
+    def __cinit__(self, p_maxLambda=1000000.0):
+        self.maxLambda = p_maxLambda
+    def solve(self, Game game):
+        cdef c_Game g = game.game
+        cdef c_List[c_MixedStrategyProfileDouble] solns
+        cdef MixedStrategyProfileDouble p
+        if _prepare_concurrent(game):
+            with nogil:
+                solns = _logit_strategy_solve(g, self.maxLambda)
+        else:
+            solns = _logit_strategy_solve(g, self.maxLambda)
+        ret = [ ]
+        for i in xrange(solns.Length()):
+            p = MixedStrategyProfileDouble()
+            p.profile = copyitem_list_mspd(solns, i+1)
+            ret.append(p)
+        return ret
+
+cdef class LogitBehaviorSolver(object):
+    cdef double maxLambda
+
+    def __cinit__(self, p_maxLambda=1000000.0):
+        self.maxLambda = p_maxLambda
+    def solve(self, Game game):
+        cdef c_Game g = game.game
+        cdef c_List[c_MixedBehaviorProfileDouble] solns
+        cdef MixedBehaviorProfileDouble p
+        if _prepare_concurrent(game):
+            with nogil:
+                solns = _logit_behavior_solve(g, self.maxLambda)
+        else:
+            solns = _logit_behavior_solve(g, self.maxLambda)
+        ret = [ ]
+        for i in xrange(solns.Length()):
+            p = MixedBehaviorProfileDouble()
+            p.profile = copyitem_list_mbpd(solns, i+1)
+            ret.append(p)
+        return ret
+
 cdef class LogitQREMixedStrategyProfile(object):
     cdef c_LogitQREMixedStrategyProfile *thisptr
     def __init__(self, game=None):
@@ -127,10 +127,16 @@ cdef class StrategySupportProfile(Collection):
         restriction.support = new c_StrategySupportProfile(deref(self.support))
         return restriction
 
-    def undominated(self, strict=False, external=False):
+    def undominated(self, strict=False, external=False, iterated=False,
+                    mixed=False, threads=1):
         cdef StrategicRestriction restriction
         restriction = StrategicRestriction()
-        restriction.support = new c_StrategySupportProfile(self.support.Undominated(strict, external))
+        if mixed:
+            restriction.support = new c_StrategySupportProfile(self.support.MixedUndominated(iterated, threads))
+        elif iterated:
+            restriction.support = new c_StrategySupportProfile(self.support.IteratedUndominated(strict))
+        else:
+            restriction.support = new c_StrategySupportProfile(self.support.Undominated(strict, external))
         new_profile = StrategySupportProfile(restriction.strategies, self.game)
         return new_profile 
 
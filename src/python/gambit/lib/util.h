@@ -27,28 +27,66 @@
 //
 
 #include <string>
+#include <new>
+#include <algorithm>
 #include <fstream>
 #include <sstream>
 #include "gambit/gambit.h"
+#include "gambit/gametable.h"
 #include "gambit/nash.h"
 
 using namespace std;
 using namespace Gambit;
 using namespace Gambit::Nash;
 
+// Cython reports std::bad_alloc as MemoryError, and other exceptions
+// as RuntimeError; tables too large to store are reported as the former
+class TableMemoryError : public std::bad_alloc {
+public:
+  TableMemoryError(const std::string &s) : m_what(s) { }
+  virtual ~TableMemoryError() throw() { }
+  virtual const char *what(void) const throw() { return m_what.c_str(); }
+
+private:
+  std::string m_what;
+};
+
 inline Game NewTable(Array<int> *dim)
-{ return NewTable(*dim); }
+{
+  try {
+    return NewTable(*dim);
+  }
+  catch (TableTooLargeException &e) {
+    throw TableMemoryError(e.what());
+  }
+}
+
+// Games read from binary tables have no outcomes, through which the
+// contingencies of table games are accessed here, so they are created
+// when the game is read
+inline Game MaterializeTable(const Game &p_game)
+{
+  GameTableRep *table = dynamic_cast<GameTableRep *>(p_game.operator->());
+  if (table) {
+    try {
+      table->Materialize();
+    }
+    catch (std::exception &ex) {
+      throw InvalidFileException(ex.what());
+    }
+  }
+  return p_game;
+}
 
 Game ReadGame(char *fn) throw (InvalidFileException)
 { 
-  std::ifstream f(fn);
-  return ReadGame(f);
+  return MaterializeTable(ReadGameFile(fn));
 }
 
 Game ParseGame(char *s) throw (InvalidFileException)
 {
   std::istringstream f(s);
-  return ReadGame(f);
+  return MaterializeTable(ReadGame(f));
 }
 
 std::string WriteGame(const Game &p_game, const std::string &p_format)
@@ -85,3 +123,53 @@ void setitem(C *p_container, const X &p_index, const T &p_value)
 // Convert the (C-style) string p_value to a Rational
 inline Rational to_rational(const char *p_value)
 { return lexical_cast<Rational>(std::string(p_value)); }
+
+// Returns the address of the probabilities of the profile, which are
+// stored contiguously in profile order
+inline double *getdata(MixedStrategyProfile<double> *p_profile)
+{ return &(*p_profile)[1]; }
+
+// Returns the value of strategy i of the profile, in profile order
+template <class T> T getvalue(const MixedStrategyProfile<T> *p_profile, int i)
+{ return p_profile->GetStrategyValues()[i]; }
+
+// Returns entry (i, j) of the payoff Jacobian of the profile
+template <class T>
+T getjacobian(const MixedStrategyProfile<T> *p_profile, int i, int j)
+{ return p_profile->GetPayoffJacobian()(i, j); }
+
+// Copy the values of the strategies of the profile into p_data
+inline void copyvalues(const MixedStrategyProfile<double> *p_profile,
+		       double *p_data)
+{
+  const Vector<double> &values = p_profile->GetStrategyValues();
+  for (int i = 1; i <= values.Length(); i++) {
+    *(p_data++) = values[i];
+  }
+}
+
+// Copy the payoff Jacobian of the profile into p_data, in row-major order
+inline void copyjacobian(const MixedStrategyProfile<double> *p_profile,
+			 double *p_data)
+{
+  const Matrix<double> &jacobian = p_profile->GetPayoffJacobian();
+  for (int i = 1; i <= jacobian.NumRows(); i++) {
+    for (int j = 1; j <= jacobian.NumColumns(); j++) {
+      *(p_data++) = jacobian(i, j);
+    }
+  }
+}
+
+// Copy the payoffs of player pl in each contingency of a table game
+// into p_data, with the first player's strategy varying fastest.
+// Returns false if the game is not a table.
+inline bool copypayoffs(const Game &p_game, int pl, double *p_data)
+{
+  const GameTableRep *table = dynamic_cast<const GameTableRep *>(p_game.operator->());
+  if (!table) {
+    return false;
+  }
+  const double *payoffs = table->GetPayoffTable<double>(pl);
+  std::copy(payoffs, payoffs + table->NumContingencies(), p_data);
+  return true;
+}
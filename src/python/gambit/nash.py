@@ -236,31 +236,36 @@ def enumpure_solve(game, use_strategic=True, external=False):
     """Convenience function to solve game to find pure-strategy Nash equilibria.
     """
     if external:
-        return ExternalEnumPureSolve().solve(game, use_strategic=True)
+        return ExternalEnumPureSolver().solve(game, use_strategic=use_strategic)
     if not game.is_tree or use_strategic:
         alg = gambit.lib.libgambit.EnumPureStrategySolver()
     else:
         alg = gambit.lib.libgambit.EnumPureAgentSolver()
     return alg.solve(game)
 
-def enummixed_solve(game, rational=True, external=False, use_lrs=False):
+def enummixed_solve(game, rational=True, external=False, use_lrs=False,
+                    dense=False):
     """Convenience function to solve two-player game to find all
-    mixed-strategy Nash equilibria.
+    mixed-strategy Nash equilibria.  With rational=False, setting
+    dense pivots on explicit dense tableaux, which is usually faster
+    on large games.
     """
     if external:
         return ExternalEnumMixedSolver().solve(game, rational=rational)
     if use_lrs:
         alg = gambit.lib.libgambit.EnumMixedLrsStrategySolver()
-    if rational:
+    elif rational:
         alg = gambit.lib.libgambit.EnumMixedStrategySolverRational()
     else:
-        alg = gambit.lib.libgambit.EnumMixedStrategySolverDouble()
+        alg = gambit.lib.libgambit.EnumMixedStrategySolverDouble(dense)
     return alg.solve(game)
 
 def lcp_solve(game, rational=True, use_strategic=False, external=False,
-              stop_after=None, max_depth=None):
+              stop_after=None, max_depth=None, dense=False):
     """Convenience function to solve game using an appropriate linear
-    complementarity solver.
+    complementarity solver.  With rational=False, setting dense
+    pivots on explicit dense tableaux when solving the strategic game,
+    which is usually faster on large games.
     """
     if stop_after is None: stop_after = 0
     if max_depth is None:  max_depth = 0
@@ -271,7 +276,8 @@ def lcp_solve(game, rational=True, use_strategic=False, external=False,
         if rational:
             alg = gambit.lib.libgambit.LCPStrategySolverRational(stop_after, max_depth)
         else:
-            alg = gambit.lib.libgambit.LCPStrategySolverDouble(stop_after, max_depth)
+            alg = gambit.lib.libgambit.LCPStrategySolverDouble(stop_after, max_depth,
+                                                               dense)
     else:        
         if rational:
             alg = gambit.lib.libgambit.LCPBehaviorSolverRational(stop_after, max_depth)
@@ -312,7 +318,7 @@ def ipa_solve(game, external=False):
     Nash equilibrium using iterated polymatrix appoximation.
     """
     if external:
-        return ExternalIPASolver().solve(game)
+        return ExternalIteratedPolymatrixSolver().solve(game)
     alg = gambit.lib.libgambit.IPAStrategySolver()
     return alg.solve(game)
 
@@ -321,10 +327,51 @@ def gnm_solve(game, external=False):
     Nash equilibria using the global Newton method.
     """
     if external:
-        return ExternalGNMSolver().solve(game)
+        return ExternalGlobalNewtonSolver().solve(game)
     alg = gambit.lib.libgambit.GNMStrategySolver()
     return alg.solve(game)
 
+def enumpoly_solve(game, use_strategic=False, external=False):
+    """Convenience function to solve game to find Nash equilibria
+    by enumerating supports and solving systems of polynomial equations.
+    """
+    if external:
+        return ExternalEnumPolySolver().solve(game, use_strategic=use_strategic)
+    if not game.is_tree or use_strategic:
+        alg = gambit.lib.libgambit.EnumPolyStrategySolver()
+    else:
+        alg = gambit.lib.libgambit.EnumPolyBehaviorSolver()
+    return alg.solve(game)
+
+def liap_solve(game, use_strategic=False, external=False,
+               tries=10, max_iterations=100, threads=1):
+    """Convenience function to solve game to find Nash equilibria
+    by minimizing the Lyapunov function from random starting points.
+    """
+    if external:
+        return ExternalLyapunovSolver().solve(game, use_strategic=use_strategic)
+    if not game.is_tree or use_strategic:
+        alg = gambit.lib.libgambit.LiapStrategySolver(tries, max_iterations,
+                                                      threads)
+    else:
+        alg = gambit.lib.libgambit.LiapBehaviorSolver(tries, max_iterations,
+                                                      threads)
+    return alg.solve(game)
+
+def logit_solve(game, use_strategic=False, external=False,
+                max_lambda=1000000.0):
+    """Convenience function to solve game to find a Nash equilibrium
+    by tracing the principal branch of the logit quantal response
+    equilibrium correspondence.
+    """
+    if external:
+        return ExternalLogitSolver().solve(game, use_strategic=use_strategic)
+    if not game.is_tree or use_strategic:
+        alg = gambit.lib.libgambit.LogitStrategySolver(max_lambda)
+    else:
+        alg = gambit.lib.libgambit.LogitBehaviorSolver(max_lambda)
+    return alg.solve(game)
+
 logit_estimate = gambit.lib.libgambit.logit_estimate
 logit_atlambda = gambit.lib.libgambit.logit_atlambda
 logit_principal_branch = gambit.lib.libgambit.logit_principal_branch
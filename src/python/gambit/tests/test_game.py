@@ -13,6 +13,10 @@ class TestGambitGame(object):
         del self.game
         del self.extensive_game
 
+    def test_game_new_table_too_large(self):
+        "To test a table too large to store raises MemoryError"
+        assert_raises(MemoryError, gambit.Game.new_table, [1000000] * 4)
+
     def test_game_get_outcome_with_ints(self):
         "To test getting the first outcome"
         assert self.game.outcomes[0] == self.game[0,0]
@@ -77,6 +81,27 @@ class TestGambitGame(object):
         game = gambit.Game.read_game("test_games/payoff_game.nfg")
         assert game.max_payoff == fractions.Fraction(10,1)
 
+    def test_game_payoff_array(self):
+        "To test the payoff array of each player matches the outcomes"
+        game = gambit.Game.read_game("test_games/payoff_game.nfg")
+        for player in game.players:
+            payoffs = game.payoff_array(player)
+            assert payoffs.shape == (2, 2)
+            assert not payoffs.flags.writeable
+            for i in range(2):
+                for j in range(2):
+                    assert payoffs[i, j] == game[i, j][player]
+
+    def test_game_payoff_array_error(self):
+        "To test raising an error for payoff arrays of extensive games"
+        assert_raises(UndefinedOperationError,
+                      self.extensive_game.payoff_array, 0)
+
+    def test_game_payoff_array_agg_error(self):
+        "To test raising an error for payoff arrays of action graph games"
+        game = gambit.Game.read_game("test_games/2x2.agg")
+        assert_raises(UndefinedOperationError, game.payoff_array, 0)
+
     def test_game_is_perfect_recall(self):
         "To test checking if the game is of perfect recall"
         game = gambit.Game.read_game("test_games/perfect_recall.efg")
@@ -1,5 +1,6 @@
 import gambit
 import fractions
+import itertools
 from nose.tools import assert_raises
 from gambit.lib.error import UndefinedOperationError
 
@@ -58,6 +59,61 @@ class TestGambitMixedStrategyGame(object):
         assert self.profile_double.strategy_values("joe") == [0.0, 0.0]
         assert self.profile_rational.strategy_values("joe") == [0.0, 0.0]
         
+    def test_payoff_jacobian(self):
+        "Test the payoff Jacobian agrees with the individual derivatives"
+        jacobian = self.tree_profile_rational.payoff_jacobian()
+        strategies = list(self.tree_game.strategies)
+        for (i, s1) in enumerate(strategies):
+            for (j, s2) in enumerate(strategies):
+                if s1.player == s2.player:
+                    assert jacobian[i][j] == 0
+                else:
+                    assert jacobian[i][j] == \
+                        self.tree_profile_rational.strategy_value_deriv(s1.player, s1, s2)
+
+    def test_payoff_jacobian_table(self):
+        "Test the payoff Jacobian of a three-player table game"
+        game = gambit.Game.new_table([2,3,2])
+        contingencies = itertools.product(range(2), range(3), range(2))
+        for (i, contingency) in enumerate(contingencies):
+            for pl in range(3):
+                game[contingency][pl] = (7*i + 3*pl) % 11
+        profile = game.mixed_strategy_profile(True)
+        probs = [ fractions.Fraction(1, 3), fractions.Fraction(2, 3),
+                  fractions.Fraction(1, 2), fractions.Fraction(1, 6),
+                  fractions.Fraction(1, 3),
+                  fractions.Fraction(1, 4), fractions.Fraction(3, 4) ]
+        for (k, prob) in enumerate(probs):
+            profile[k] = prob
+        jacobian = profile.payoff_jacobian()
+        strategies = list(game.strategies)
+        for (i, s1) in enumerate(strategies):
+            for (j, s2) in enumerate(strategies):
+                if s1.player == s2.player:
+                    assert jacobian[i][j] == 0
+                else:
+                    assert jacobian[i][j] == \
+                        profile.strategy_value_deriv(s1.player, s1, s2)
+
+    def test_as_array(self):
+        "Test the array view shares storage with the profile"
+        probs = self.profile_double.as_array()
+        assert list(probs) == [0.5, 0.5, 0.5, 0.5]
+        probs[1] = 0.75
+        assert self.profile_double[1] == 0.75
+        self.profile_double[2] = 0.25
+        assert probs[2] == 0.25
+
+    def test_strategy_values_array(self):
+        "Test the strategy values array agrees with the values by player"
+        values = self.tree_profile_double.strategy_values_array()
+        assert list(values) == sum(self.tree_profile_double.strategy_values(), [])
+
+    def test_payoff_jacobian_array(self):
+        "Test the payoff Jacobian array agrees with the list of rows"
+        jacobian = self.tree_profile_double.payoff_jacobian_array()
+        assert jacobian.tolist() == self.tree_profile_double.payoff_jacobian()
+
     def test_get_probabilities_strategy(self):
         "Test retrieving probabilities"
         assert self.profile_double[0] == 0.5
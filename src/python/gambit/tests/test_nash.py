@@ -0,0 +1,85 @@
+import gambit
+import gambit.nash
+import nose
+import subprocess
+import threading
+
+class TestGambitNash(object):
+    def setUp(self):
+        self.nfg = gambit.Game.read_game("test_games/const_sum_game.nfg")
+        self.efg = gambit.Game.read_game("test_games/complicated_extensive_game.efg")
+
+    def tearDown(self):
+        del self.nfg
+        del self.efg
+
+    def test_logit_strategy(self):
+        "Test computing an equilibrium in-process by tracing the logit branch"
+        eqa = gambit.nash.logit_solve(self.nfg)
+        assert len(eqa) == 1
+        assert eqa[0].liap_value() < 1.0e-6
+
+    def test_logit_behavior(self):
+        "Test tracing the agent logit branch in-process on a tree"
+        eqa = gambit.nash.logit_solve(self.efg)
+        assert len(eqa) == 1
+        assert eqa[0].liap_value() < 1.0e-6
+
+    def test_liap_strategy(self):
+        "Test minimizing the Lyapunov function in-process"
+        for eqm in gambit.nash.liap_solve(self.nfg, tries=5, threads=2):
+            assert eqm.liap_value() < 1.0e-4
+
+    def test_enumpoly_behavior(self):
+        "Test enumerating equilibria on supports of a tree in-process"
+        eqa = gambit.nash.enumpoly_solve(self.efg)
+        assert len(eqa) > 0
+        for eqm in eqa:
+            assert eqm.liap_value() < 1.0e-6
+
+    def test_enumpoly_strategy(self):
+        "Test enumerating equilibria on supports of a table in-process"
+        eqa = gambit.nash.enumpoly_solve(self.efg, use_strategic=True)
+        assert len(eqa) > 0
+        for eqm in eqa:
+            assert eqm.liap_value() < 1.0e-6
+
+    def test_dense_tableaux(self):
+        "Test pivoting on dense tableaux finds the same equilibria"
+        for solve in [ gambit.nash.lcp_solve, gambit.nash.enummixed_solve ]:
+            expected = [ list(eqm) for eqm in solve(self.nfg, rational=False) ]
+            eqa = [ list(eqm) for eqm in solve(self.nfg, rational=False,
+                                               dense=True) ]
+            assert len(eqa) == len(expected)
+            for (p, q) in zip(eqa, expected):
+                assert max([ abs(x-y) for (x, y) in zip(p, q) ]) < 1.0e-9
+
+    def test_concurrent_solves(self):
+        "Test running solvers on the same game from several threads"
+        expected = [ list(eqm) for eqm in gambit.nash.lcp_solve(self.efg) ]
+        results = [ ]
+        def solve():
+            for i in range(5):
+                eqa = gambit.nash.lcp_solve(self.efg)
+                results.append([ list(eqm) for eqm in eqa ] == expected)
+                gambit.nash.logit_solve(self.nfg)
+        threads = [ threading.Thread(target=solve) for i in range(4) ]
+        for thread in threads:
+            thread.start()
+        for thread in threads:
+            thread.join()
+        assert len(results) == 20
+        assert all(results)
+
+    def test_undominated_tools(self):
+        "Test the solvers report equilibria of the full game after removing mixed-dominated strategies"
+        for tool in [ "gambit-lcp", "gambit-enummixed", "gambit-enumpoly" ]:
+            try:
+                output = subprocess.check_output([ tool, "-q", "-R",
+                                                   "test_games/mixdom.nfg" ])
+            except OSError:
+                raise nose.SkipTest("%s is not installed" % tool)
+            eqa = [ [ float(x) for x in line.split(",")[1:] ]
+                    for line in output.decode().splitlines()
+                    if line.startswith("NE,") ]
+            assert eqa == [ [ 0, 0, 1, 0, 0, 1, 0, 0 ] ]
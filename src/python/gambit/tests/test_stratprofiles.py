@@ -112,6 +112,24 @@ class TestGambitStrategySupportProfile(object):
         assert loop_profile == gambit.lib.libgambit.StrategySupportProfile(
             [self.support_profile[0], self.support_profile[3]], self.game)
 
+    def test_iterated_undominated(self):
+        "Test removing dominated strategies iteratively in one call"
+        profile = self.support_profile.undominated(iterated=True)
+        assert profile == gambit.lib.libgambit.StrategySupportProfile(
+            [self.support_profile[0], self.support_profile[3]], self.game)
+
+    def test_mixed_undominated(self):
+        "Test removing strategies dominated by mixed strategies"
+        game = gambit.Game.read_game("test_games/mixed_dominance.nfg")
+        support_profile = game.support_profile()
+        assert support_profile.undominated(strict=True) == support_profile
+        profile = support_profile.undominated(mixed=True)
+        assert profile == support_profile.remove(support_profile[2])
+        profile = support_profile.undominated(mixed=True, iterated=True)
+        assert profile == gambit.lib.libgambit.StrategySupportProfile(
+            [support_profile[0], support_profile[1],
+             support_profile[3], support_profile[4]], game)
+
     @nose.tools.raises(UndefinedOperationError)
     def test_remove_error(self):
         "Test removing the last strategy of a player"
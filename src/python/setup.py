@@ -32,6 +32,10 @@ from Cython.Distutils import build_ext
 #    m.Extension.__dict__ = m._Extension.__dict__
     
 import glob
+import os.path
+# All of the enumpoly sources built into gambit-enumpoly, except its main()
+enumpoly = [ fn for fn in glob.glob("../tools/enumpoly/*.cc")
+             if os.path.basename(fn) not in [ "enumpoly.cc", "gpolyctr.cc" ] ]
 libgame = Extension("gambit.lib.libgambit",
                     sources=[ "gambit/lib/libgambit.pyx" ] +
                             glob.glob("gambit/lib/*.pxi") +
@@ -42,9 +46,16 @@ libgame = Extension("gambit.lib.libgambit",
                               "../tools/lp/efglp.cc",
                               "../tools/logit/path.cc",
                               "../tools/logit/nfglogit.cc",
-                              "../tools/logit/efglogit.cc" ],
+                              "../tools/logit/efglogit.cc",
+                              "../tools/liap/nfgliap.cc",
+                              "../tools/liap/efgliap.cc" ] +
+                            enumpoly,
                     language="c++",
-                    include_dirs=[ "../..", "../../library/include", ".." ] )
+                    include_dirs=[ "../..", "../../library/include", ".." ],
+                    # The solvers share games between threads, and keep
+                    # reference counts atomically, only when built with OpenMP
+                    extra_compile_args=[ "-fopenmp" ],
+                    extra_link_args=[ "-fopenmp" ] )
 
 setup(name="gambit",
       version="16.0.1",
@@ -49,6 +49,7 @@ void PrintHelp(char *progname)
   std::cerr << "  -O FORMAT        output file format (required):\n";
   std::cerr << "     FORMAT=html   convert to HTML\n";
   std::cerr << "     FORMAT=sgame  convert to LaTeX sgame style\n";
+  std::cerr << "     FORMAT=nfgbin convert to binary strategic form table\n";
   std::cerr << "  -c PLAYER        the player to show on columns (default is 2)\n";
   std::cerr << "  -r PLAYER        the player to show on rows (default is 1)\n";
   std::cerr << "  -h               print this help message\n";
@@ -102,7 +103,7 @@ int main(int argc, char *argv[])
     std::cerr << argv[0] << ": Output format argument -O required.\n";
     return 1;
   }
-  else if (format != "sgame" && format != "html") {
+  else if (format != "sgame" && format != "html" && format != "nfgbin") {
     std::cerr << argv[0] << ": Unknown output format '" << format << "'.\n";
     return 1;
   }
@@ -126,7 +127,13 @@ int main(int argc, char *argv[])
   }
 
   try {
-    Gambit::Game game = Gambit::ReadGame(*input_stream);
+    Gambit::Game game = (optind < argc) ? Gambit::ReadGameFile(argv[optind]) :
+      Gambit::ReadGame(*input_stream);
+
+    if (format == "nfgbin") {
+      game->Write(std::cout, "nfgbin");
+      return 0;
+    }
 
     if (rowPlayer < 1 || rowPlayer > game->NumPlayers()) {
       std::cerr << argv[0] << ": Player " << rowPlayer << " does not exist.\n";
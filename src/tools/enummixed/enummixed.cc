@@ -65,7 +65,12 @@ void PrintHelp(char *progname)
   std::cerr << "Options:\n";
   std::cerr << "  -d DECIMALS      compute using floating-point arithmetic;\n";
   std::cerr << "                   display results with DECIMALS digits\n";
+  std::cerr << "  -T               with -d, pivot on dense tableaux\n";
+  std::cerr << "                   (faster on large games)\n";
   std::cerr << "  -D               don't eliminate dominated strategies first\n";
+  std::cerr << "  -R               eliminate strategies strictly dominated by\n";
+  std::cerr << "                   mixed strategies before solving\n";
+  std::cerr << "  -j THREADS       with -R, test up to THREADS strategies at once\n";
   std::cerr << "  -L               use lrslib for enumeration (experimental!)\n";
   std::cerr << "  -c               output connectedness information\n";
   std::cerr << "  -h, --help       print this help message\n";
@@ -78,8 +83,8 @@ int main(int argc, char *argv[])
 {
   int c;
   bool useFloat = false, uselrs = false, quiet = false, eliminate = true;
-  bool showConnect = false;
-  int numDecimals = 6;
+  bool showConnect = false, reduce = false, useDense = false;
+  int numDecimals = 6, numThreads = 1;
 
   int long_opt_index = 0;
   struct option long_options[] = {
@@ -87,7 +92,7 @@ int main(int argc, char *argv[])
     { "version", 0, NULL, 'v'  },
     { 0,    0,    0,    0   }
   };
-  while ((c = getopt_long(argc, argv, "d:DvhqcSL", long_options, &long_opt_index)) != -1) {
+  while ((c = getopt_long(argc, argv, "d:DvhqcSLRTj:", long_options, &long_opt_index)) != -1) {
     switch (c) {
     case 'v':
       PrintBanner(std::cerr); exit(1);
@@ -101,6 +106,15 @@ int main(int argc, char *argv[])
     case 'L':
       uselrs = true;
       break;
+    case 'R':
+      reduce = true;
+      break;
+    case 'T':
+      useDense = true;
+      break;
+    case 'j':
+      numThreads = atoi(optarg);
+      break;
     case 'h':
       PrintHelp(argv[0]);
       break;
@@ -143,10 +157,17 @@ int main(int argc, char *argv[])
   }
 
   try {
-    Game game = ReadGame(*input_stream);
+    Game game = (optind < argc) ? ReadGameFile(argv[optind]) :
+      ReadGame(*input_stream);
+    if (reduce) {
+      game = StrategySupportProfile(game).MixedUndominated(true, numThreads).Restrict();
+    }
     if (uselrs) {
       shared_ptr<StrategyProfileRenderer<Rational> > renderer;
       renderer = new MixedStrategyCSVRenderer<Rational>(std::cout);
+      if (reduce) {
+	renderer = new UnrestrictedStrategyRenderer<Rational>(renderer);
+      }
       EnumMixedLrsStrategySolver solver(renderer);
       solver.Solve(game);
     }
@@ -154,7 +175,10 @@ int main(int argc, char *argv[])
       shared_ptr<StrategyProfileRenderer<double> > renderer;
       renderer = new MixedStrategyCSVRenderer<double>(std::cout,
 						      numDecimals);
-      EnumMixedStrategySolver<double> solver(renderer);
+      if (reduce) {
+	renderer = new UnrestrictedStrategyRenderer<double>(renderer);
+      }
+      EnumMixedStrategySolver<double> solver(renderer, useDense);
       shared_ptr<EnumMixedStrategySolution<double> > solution =
 	solver.SolveDetailed(game);
       if (showConnect) {
@@ -166,6 +190,9 @@ int main(int argc, char *argv[])
     else {
       shared_ptr<StrategyProfileRenderer<Rational> > renderer;
       renderer = new MixedStrategyCSVRenderer<Rational>(std::cout);
+      if (reduce) {
+	renderer = new UnrestrictedStrategyRenderer<Rational>(renderer);
+      }
       EnumMixedStrategySolver<Rational> solver(renderer);
       shared_ptr<EnumMixedStrategySolution<Rational> > solution =
 	solver.SolveDetailed(game);
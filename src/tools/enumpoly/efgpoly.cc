@@ -33,9 +33,7 @@ using namespace Gambit;
 #include "rectangl.h"
 #include "quiksolv.h"
 #include "behavextend.h"
-
-extern int g_numDecimals;
-extern bool g_verbose;
+#include "enumpoly.h"
 
 //
 // A class to organize the data needed to build the polynomials
@@ -386,13 +384,15 @@ void PrintSupport(std::ostream &p_stream,
   p_stream << std::endl;
 }
 
-void SolveExtensive(const Game &p_game)
+List<MixedBehaviorProfile<double> >
+SolveExtensive(const Game &p_game, std::ostream &p_stream)
 {
   List<BehaviorSupportProfile> supports = PossibleNashSubsupports(p_game);
+  List<MixedBehaviorProfile<double> > solutions;
 
   for (int i = 1; i <= supports.Length(); i++) {
     if (g_verbose) {
-      PrintSupport(std::cout, "candidate", supports[i]);
+      PrintSupport(p_stream, "candidate", supports[i]);
     }
       
     bool isSingular = false;
@@ -402,13 +402,15 @@ void SolveExtensive(const Game &p_game)
     for (int j = 1; j <= newsolns.Length(); j++) {
       MixedBehaviorProfile<double> fullProfile = ToFullSupport(newsolns[j]);
       if (fullProfile.GetLiapValue(true) < 1.0e-6) {
-	PrintProfile(std::cout, "NE", fullProfile);
+	PrintProfile(p_stream, "NE", fullProfile);
+	solutions.push_back(fullProfile);
       }
     }
       
     if (isSingular && g_verbose) {
-      PrintSupport(std::cout, "singular", supports[i]);
+      PrintSupport(p_stream, "singular", supports[i]);
     }
   }
+  return solutions;
 }
 
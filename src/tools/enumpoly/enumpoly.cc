@@ -28,9 +28,7 @@
 #include <getopt.h>
 #include "gambit/gambit.h"
 #include "nfghs.h"
-
-int g_numDecimals = 6;
-bool g_verbose = false;
+#include "enumpoly.h"
 
 void PrintBanner(std::ostream &p_stream)
 {
@@ -53,6 +51,9 @@ void PrintHelp(char *progname)
   std::cerr << "  -S               use strategic game\n";
   std::cerr << "  -H               use heuristic search method to optimize time\n";
   std::cerr << "                   to find first equilibrium (strategic games only)\n";
+  std::cerr << "  -R               eliminate strategies strictly dominated by\n";
+  std::cerr << "                   mixed strategies first (strategic games only)\n";
+  std::cerr << "  -j THREADS       with -R, test up to THREADS strategies at once\n";
   std::cerr << "  -q               quiet mode (suppresses banner)\n";
   std::cerr << "  -V, --verbose    verbose mode (shows supports investigated)\n";
   std::cerr << "  -v, --version    print version information\n";
@@ -60,15 +61,13 @@ void PrintHelp(char *progname)
   exit(1);
 }
 
-extern void SolveStrategic(const Gambit::Game &);
-extern void SolveExtensive(const Gambit::Game &);
-
 int main(int argc, char *argv[])
 {
   opterr = 0;
 
   bool quiet = false;
-  bool useHeuristic = false, useStrategic = false;
+  bool useHeuristic = false, useStrategic = false, reduce = false;
+  int numThreads = 1;
 
   int long_opt_index = 0;
   struct option long_options[] = {
@@ -78,7 +77,7 @@ int main(int argc, char *argv[])
     { 0,    0,    0,    0   }
   };
   int c;
-  while ((c = getopt_long(argc, argv, "d:hHSqvV", long_options, &long_opt_index)) != -1) {
+  while ((c = getopt_long(argc, argv, "d:hHSRj:qvV", long_options, &long_opt_index)) != -1) {
     switch (c) {
     case 'v':
       PrintBanner(std::cerr); exit(1);
@@ -94,6 +93,12 @@ int main(int argc, char *argv[])
     case 'S':
       useStrategic = true;
       break;
+    case 'R':
+      reduce = true;
+      break;
+    case 'j':
+      numThreads = atoi(optarg);
+      break;
     case 'q':
       quiet = true;
       break;
@@ -131,7 +136,8 @@ int main(int argc, char *argv[])
   }
 
   try {
-    Gambit::Game game = Gambit::ReadGame(*input_stream);
+    Gambit::Game game = (optind < argc) ? Gambit::ReadGameFile(argv[optind]) :
+      Gambit::ReadGame(*input_stream);
     if (!game->IsPerfectRecall()) {
       throw Gambit::UndefinedException("Computing equilibria of games with imperfect recall is not supported.");
     }
@@ -141,12 +147,16 @@ int main(int argc, char *argv[])
 	gbtNfgHs algorithm(0);
 	algorithm.Solve(game);
       }
+      else if (reduce) {
+	SolveStrategic(Gambit::StrategySupportProfile(game).MixedUndominated(true, numThreads),
+		       std::cout);
+      }
       else {
-	SolveStrategic(game);
+	SolveStrategic(game, std::cout);
       }
     }
     else {
-      SolveExtensive(game);
+      SolveExtensive(game, std::cout);
     }
     return 0;
   }
@@ -0,0 +1,43 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2016, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: src/tools/enumpoly/enumpoly.h
+// Entry points for enumerating equilibria by solving polynomial systems
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#ifndef ENUMPOLY_H
+#define ENUMPOLY_H
+
+#include "gambit/gambit.h"
+
+extern int g_numDecimals;
+extern bool g_verbose;
+
+/// Enumerates the equilibria on each candidate subsupport of p_support,
+/// writing each as it is found to p_stream.  Returns the equilibria found.
+Gambit::List<Gambit::MixedStrategyProfile<double> >
+SolveStrategic(const Gambit::StrategySupportProfile &p_support,
+	       std::ostream &p_stream);
+
+/// Enumerates the equilibria on each candidate subsupport of the
+/// extensive game p_game, writing each as it is found to p_stream.
+/// Returns the equilibria found.
+Gambit::List<Gambit::MixedBehaviorProfile<double> >
+SolveExtensive(const Gambit::Game &p_game, std::ostream &p_stream);
+
+#endif  // ENUMPOLY_H
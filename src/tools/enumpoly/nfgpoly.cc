@@ -29,9 +29,10 @@
 #include "gpolylst.h"
 #include "rectangl.h"
 #include "quiksolv.h"
+#include "enumpoly.h"
 
-extern int g_numDecimals;
-extern bool g_verbose; 
+int g_numDecimals = 6;
+bool g_verbose = false;
 
 class PolEnumModule  {
 private:
@@ -478,9 +479,12 @@ void PrintSupport(std::ostream &p_stream,
   p_stream << std::endl;
 }
 
-void SolveStrategic(const Gambit::Game &p_nfg)
+Gambit::List<Gambit::MixedStrategyProfile<double> >
+SolveStrategic(const Gambit::StrategySupportProfile &p_support,
+	       std::ostream &p_stream)
 {
-  Gambit::List<Gambit::StrategySupportProfile> supports = PossibleNashSubsupports(p_nfg);
+  Gambit::List<Gambit::StrategySupportProfile> supports = PossibleNashSubsupports(p_support);
+  Gambit::List<Gambit::MixedStrategyProfile<double> > solutions;
 
   for (int i = 1; i <= supports.Length(); i++) {
     long newevals = 0;
@@ -489,7 +493,7 @@ void SolveStrategic(const Gambit::Game &p_nfg)
     bool is_singular = false;
     
     if (g_verbose) {
-      PrintSupport(std::cout, "candidate", supports[i]);
+      PrintSupport(p_stream, "candidate", supports[i]);
     }
 
     PolEnum(supports[i], newsolns, newevals, newtime, is_singular);
@@ -497,14 +501,16 @@ void SolveStrategic(const Gambit::Game &p_nfg)
     for (int j = 1; j <= newsolns.Length(); j++) {
       Gambit::MixedStrategyProfile<double> fullProfile = ToFullSupport(newsolns[j]);
       if (fullProfile.GetLiapValue() < 1.0e-6) {
-	PrintProfile(std::cout, "NE", fullProfile);
+	PrintProfile(p_stream, "NE", fullProfile);
+	solutions.push_back(fullProfile);
       }
     }
 
     if (is_singular && g_verbose) {
-      PrintSupport(std::cout, "singular", supports[i]);
+      PrintSupport(p_stream, "singular", supports[i]);
     }
   }
+  return solutions;
 }
 
 
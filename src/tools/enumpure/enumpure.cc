@@ -51,6 +51,7 @@ void PrintHelp(char *progname)
   std::cerr << "  -S               report equilibria in strategies even for extensive games\n";
   std::cerr << "  -A               compute agent form equilibria\n";
   std::cerr << "  -P               find only subgame-perfect equilibria\n";
+  std::cerr << "  -j THREADS       with -P, solve up to THREADS subgames at once\n";
   std::cerr << "  -h, --help       print this help message\n";
   std::cerr << "  -q               quiet mode (suppresses banner)\n";
   std::cerr << "  -v, --version    print version information\n";
@@ -63,6 +64,7 @@ int main(int argc, char *argv[])
   opterr = 0;
   bool quiet = false, reportStrategic = false, solveAgent = false, bySubgames = false;
   bool printDetail = false;
+  int numThreads = 1;
   
   int long_opt_index = 0;
   struct option long_options[] = {
@@ -71,7 +73,7 @@ int main(int argc, char *argv[])
     { 0,    0,    0,    0   }
   };
   int c;
-  while ((c = getopt_long(argc, argv, "DvhqASP", long_options, &long_opt_index)) != -1) {
+  while ((c = getopt_long(argc, argv, "DvhqASPj:", long_options, &long_opt_index)) != -1) {
     switch (c) {
     case 'v':
       PrintBanner(std::cerr); exit(1);
@@ -87,6 +89,9 @@ int main(int argc, char *argv[])
     case 'P':
       bySubgames = true;
       break;
+    case 'j':
+      numThreads = atoi(optarg);
+      break;
     case 'h':
       PrintHelp(argv[0]);
       break;
@@ -124,7 +129,8 @@ int main(int argc, char *argv[])
   }
 
   try {
-    Game game = ReadGame(*input_stream);
+    Game game = (optind < argc) ? ReadGameFile(argv[optind]) :
+      ReadGame(*input_stream);
     shared_ptr<StrategyProfileRenderer<Rational> > renderer;
     if (reportStrategic || !game->IsTree()) {
       if (printDetail) {
@@ -154,7 +160,7 @@ int main(int argc, char *argv[])
 	    new EnumPureStrategySolver();
 	  stage = new BehavViaStrategySolver<Rational>(substage);
 	}
-	SubgameBehavSolver<Rational> algorithm(stage, renderer);
+	SubgameBehavSolver<Rational> algorithm(stage, renderer, numThreads);
 	algorithm.Solve(game);
       }
       else {
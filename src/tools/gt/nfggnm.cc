@@ -85,6 +85,7 @@ void PrintHelp(char *progname)
   std::cerr << "Options:\n";
   std::cerr << "  -d DECIMALS      show equilibria as floating point with DECIMALS digits\n";
   std::cerr << "  -h, --help       print this help message\n";
+  std::cerr << "  -j THREADS       trace THREADS perturbation vectors at once\n";
   std::cerr << "  -n COUNT         number of perturbation vectors to generate\n";
   std::cerr << "  -s FILE          file containing perturbation vectors\n";
   std::cerr << "  -q               quiet mode (suppresses banner)\n";
@@ -98,7 +99,7 @@ int main(int argc, char *argv[])
 {
   opterr = 0;
   bool quiet = false, verbose = false;
-  int numDecimals = 6, numVectors = 1;
+  int numDecimals = 6, numVectors = 1, numThreads = 1;
   std::string startFile;
 
   int long_opt_index = 0;
@@ -109,7 +110,7 @@ int main(int argc, char *argv[])
     { 0,    0,    0,    0   }
   };
   int c;
-  while ((c = getopt_long(argc, argv, "d:n:s:qvVhS", long_options, &long_opt_index)) != -1) {
+  while ((c = getopt_long(argc, argv, "d:n:s:j:qvVhS", long_options, &long_opt_index)) != -1) {
     switch (c) {
     case 'v':
       PrintBanner(std::cerr); exit(1);
@@ -125,6 +126,9 @@ int main(int argc, char *argv[])
     case 'n':
       numVectors = atoi(optarg);
       break;
+    case 'j':
+      numThreads = atoi(optarg);
+      break;
     case 's':
       startFile = optarg;
       break;
@@ -164,7 +168,8 @@ int main(int argc, char *argv[])
   }
 
   try {
-    Game game = ReadGame(*input_stream);
+    Game game = (optind < argc) ? ReadGameFile(argv[optind]) :
+      ReadGame(*input_stream);
     shared_ptr<StrategyProfileRenderer<double> > renderer;
     renderer = new MixedStrategyCSVRenderer<double>(std::cout,
 						    numDecimals);
@@ -179,8 +184,15 @@ int main(int argc, char *argv[])
       // Generate the desired number of points randomly
       perts = RandomStrategyPerturbations(game, numVectors);
     }
-    for (int i = 1; i <= perts.size(); i++) {
-      solver.Solve(game, perts[i]);
+    List<NashGNMRaySummary> summaries;
+    solver.Solve(game, perts, numThreads, &summaries);
+    if (!quiet) {
+      for (int i = 1; i <= summaries.size(); i++) {
+	std::cerr << "Ray " << i << ": " << summaries[i].m_steps << " steps, "
+		  << summaries[i].m_lnmCalls << " LNM calls, "
+		  << summaries[i].m_equilibria << " equilibria, "
+		  << summaries[i].m_seconds << " seconds\n";
+      }
     }
     return 0;
   }
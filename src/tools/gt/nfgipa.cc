@@ -120,7 +120,8 @@ int main(int argc, char *argv[])
   }
 
   try {
-    Game game = ReadGame(*input_stream);
+    Game game = (optind < argc) ? ReadGameFile(argv[optind]) :
+      ReadGame(*input_stream);
     shared_ptr<StrategyProfileRenderer<double> > renderer;
     renderer = new MixedStrategyCSVRenderer<double>(std::cout,
 						    numDecimals);
@@ -49,8 +49,15 @@ void PrintHelp(char *progname)
   std::cerr << "Options:\n";
   std::cerr << "  -d DECIMALS      compute using floating-point arithmetic;\n";
   std::cerr << "                   display results with DECIMALS digits\n";
+  std::cerr << "  -T               with -d, pivot on dense tableaux\n";
+  std::cerr << "                   (faster on large strategic games)\n";
   std::cerr << "  -S               use strategic game\n";
   std::cerr << "  -P               find only subgame-perfect equilibria\n";
+  std::cerr << "  -R               eliminate strategies strictly dominated by\n";
+  std::cerr << "                   mixed strategies first (strategic game only)\n";
+  std::cerr << "  -j THREADS       with -P, solve up to THREADS subgames at once;\n";
+  std::cerr << "                   with -R, test up to THREADS strategies at once;\n";
+  std::cerr << "                   on strategic games, follow up to THREADS paths at once\n";
   std::cerr << "  -e EQA           terminate after finding EQA equilibria\n";
   std::cerr << "                   (default is to find all accessible equilbria\n";
   std::cerr << "  -r DEPTH         terminate recursion at DEPTH\n";
@@ -67,8 +74,8 @@ int main(int argc, char *argv[])
 {
   int c;
   bool useFloat = false, useStrategic = false, bySubgames = false, quiet = false;
-  bool printDetail = false;
-  int numDecimals = 6, stopAfter = 0, maxDepth = 0;
+  bool printDetail = false, reduce = false, useDense = false;
+  int numDecimals = 6, stopAfter = 0, maxDepth = 0, numThreads = 1;
 
   int long_opt_index = 0;
   struct option long_options[] = {
@@ -76,7 +83,7 @@ int main(int argc, char *argv[])
     { "version", 0, NULL, 'v'  },
     { 0,    0,    0,    0   }
   };
-  while ((c = getopt_long(argc, argv, "d:DvhqSPe:r:", long_options, &long_opt_index)) != -1) {
+  while ((c = getopt_long(argc, argv, "d:DvhqSPRTe:r:j:", long_options, &long_opt_index)) != -1) {
     switch (c) {
     case 'v':
       PrintBanner(std::cerr); exit(1);
@@ -105,6 +112,15 @@ int main(int argc, char *argv[])
     case 'P':
       bySubgames = true;
       break;
+    case 'R':
+      reduce = true;
+      break;
+    case 'T':
+      useDense = true;
+      break;
+    case 'j':
+      numThreads = atoi(optarg);
+      break;
     case '?':
       if (isprint(optopt)) {
 	std::cerr << argv[0] << ": Unknown option `-" << ((char) optopt) << "'.\n";
@@ -136,8 +152,12 @@ int main(int argc, char *argv[])
   }
 
   try {
-    Game game = ReadGame(*input_stream);
+    Game game = (optind < argc) ? ReadGameFile(argv[optind]) :
+      ReadGame(*input_stream);
     if (!game->IsTree() || useStrategic) {
+      if (reduce) {
+	game = StrategySupportProfile(game).MixedUndominated(true, numThreads).Restrict();
+      }
       if (useFloat) {
 	shared_ptr<StrategyProfileRenderer<double> > renderer;
 	if (printDetail)  {
@@ -147,8 +167,11 @@ int main(int argc, char *argv[])
 	else {
 	  renderer = new MixedStrategyCSVRenderer<double>(std::cout, numDecimals);
 	}
+	if (reduce) {
+	  renderer = new UnrestrictedStrategyRenderer<double>(renderer);
+	}
 	NashLcpStrategySolver<double> algorithm(stopAfter, maxDepth,
-						renderer);
+						renderer, numThreads, useDense);
 	algorithm.Solve(game);
       }
       else {
@@ -159,8 +182,11 @@ int main(int argc, char *argv[])
 	else {
 	  renderer = new MixedStrategyCSVRenderer<Rational>(std::cout);
 	}
+	if (reduce) {
+	  renderer = new UnrestrictedStrategyRenderer<Rational>(renderer);
+	}
 	NashLcpStrategySolver<Rational> algorithm(stopAfter, maxDepth,
-						  renderer);
+						  renderer, numThreads);
 	algorithm.Solve(game);
       }
     }
@@ -204,7 +230,7 @@ int main(int argc, char *argv[])
 	    renderer = new BehavStrategyCSVRenderer<double>(std::cout, 
 							    numDecimals);
 	  }
-	  SubgameBehavSolver<double> algorithm(stage, renderer);
+	  SubgameBehavSolver<double> algorithm(stage, renderer, numThreads);
 	  algorithm.Solve(game);
 	}
 	else {
@@ -219,7 +245,7 @@ int main(int argc, char *argv[])
 	    renderer = new BehavStrategyCSVRenderer<Rational>(std::cout, 
 							      numDecimals);
 	  }
-	  SubgameBehavSolver<Rational> algorithm(stage, renderer);
+	  SubgameBehavSolver<Rational> algorithm(stage, renderer, numThreads);
 	  algorithm.Solve(game);
 	}
       }
@@ -24,9 +24,11 @@
 #include <unistd.h>
 #include <iostream>
 #include <fstream>
+#include <vector>
 
 #include "gambit/gambit.h"
 #include "gambit/function.h"
+#include "library/src/multirun.h"
 #include "efgliap.h"
 
 using namespace Gambit;
@@ -78,33 +80,24 @@ bool AgentLyapunovFunction::Gradient(const Vector<double> &x,
 //                     class NashLiapBehavSolver
 //------------------------------------------------------------------------
 
-List<MixedBehaviorProfile<double> >
-NashLiapBehavSolver::Solve(const MixedBehaviorProfile<double> &p_start) const
-{
-  if (!p_start.GetGame()->IsPerfectRecall()) {
-    throw UndefinedException("Computing equilibria of games with imperfect recall is not supported.");
-  }
+const double NashLiapBehavSolver::GRADIENT_TOLERANCE = .001;
+const double NashLiapBehavSolver::DUPLICATE_TOLERANCE = 10.0 * GRADIENT_TOLERANCE;
 
+bool NashLiapBehavSolver::Minimize(MixedBehaviorProfile<double> &p) const
+{
   static const double ALPHA = .00000001;
-  List<MixedBehaviorProfile<double> > solutions;
-
-  MixedBehaviorProfile<double> p(p_start);
-  if (m_verbose) {
-    this->m_onEquilibrium->Render(p, "start");
-  }
 
   // if starting vector not interior, perturb it towards centroid
   int kk = 1;
   for (; kk <= p.Length() && p[kk] > ALPHA; kk++);
   if (kk <= p.Length()) {
-    MixedBehaviorProfile<double> c(p_start.GetGame());
+    MixedBehaviorProfile<double> c(p.GetGame());
     for (int k = 1; k <= p.Length(); k++) {
       p[k] = c[k]*ALPHA + p[k]*(1.0-ALPHA);
     }
   }
 
   AgentLyapunovFunction F(p);
-  Matrix<double> xi(p.Length(), p.Length());
   ConjugatePRMinimizer minimizer(p.Length());
   Vector<double> gradient(p.Length()), dx(p.Length());
   double fval;
@@ -115,17 +108,83 @@ NashLiapBehavSolver::Solve(const MixedBehaviorProfile<double> &p_start) const
       break;
     }
     
-    if (sqrt(gradient.NormSquared()) < .001) {
-      this->m_onEquilibrium->Render(p, "NE");
-      solutions.push_back(p);
-      break;
+    if (sqrt(gradient.NormSquared()) < GRADIENT_TOLERANCE) {
+      return true;
     }
   }
+  return false;
+}
+
+List<MixedBehaviorProfile<double> >
+NashLiapBehavSolver::Solve(const MixedBehaviorProfile<double> &p_start) const
+{
+  if (!p_start.GetGame()->IsPerfectRecall()) {
+    throw UndefinedException("Computing equilibria of games with imperfect recall is not supported.");
+  }
+
+  List<MixedBehaviorProfile<double> > solutions;
 
-  if (m_verbose && sqrt(gradient.NormSquared()) >= .001) {
+  MixedBehaviorProfile<double> p(p_start);
+  if (m_verbose) {
+    this->m_onEquilibrium->Render(p, "start");
+  }
+
+  if (Minimize(p)) {
+    this->m_onEquilibrium->Render(p, "NE");
+    solutions.push_back(p);
+  }
+  else if (m_verbose) {
     this->m_onEquilibrium->Render(p, "end");
   }
 
   return solutions;
 }
 
+//
+// As in the strategic version, each start is minimized on its own copy
+// of the profile, and results are reported one at a time.
+//
+List<MixedBehaviorProfile<double> >
+NashLiapBehavSolver::Solve(const List<MixedBehaviorProfile<double> > &p_starts,
+			   int p_threads, double p_tolerance) const
+{
+  List<MixedBehaviorProfile<double> > solutions;
+  if (p_starts.size() == 0) {
+    return solutions;
+  }
+  Game game = p_starts.front().GetGame();
+  if (!game->IsPerfectRecall()) {
+    throw UndefinedException("Computing equilibria of games with imperfect recall is not supported.");
+  }
+  if (!game->PrepareConcurrentAccess()) {
+    p_threads = 1;
+  }
+
+  std::vector<MixedBehaviorProfile<double> > starts;
+  for (size_t i = 1; i <= p_starts.size(); i++) {
+    starts.push_back(p_starts[i]);
+  }
+
+#pragma omp parallel for schedule(dynamic) num_threads(p_threads)
+  for (int i = 0; i < (int) starts.size(); i++) {
+    MixedBehaviorProfile<double> p(starts[i]);
+    bool found = Minimize(p);
+#pragma omp critical(liap_behavior_results)
+    {
+      if (m_verbose) {
+	this->m_onEquilibrium->Render(starts[i], "start");
+      }
+      if (found) {
+	if (IsNewEquilibrium(solutions, p, p_tolerance)) {
+	  this->m_onEquilibrium->Render(p, "NE");
+	  solutions.push_back(p);
+	}
+      }
+      else if (m_verbose) {
+	this->m_onEquilibrium->Render(p, "end");
+      }
+    }
+  }
+
+  return solutions;
+}
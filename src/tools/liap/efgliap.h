@@ -37,13 +37,35 @@ public:
   { }
   virtual ~NashLiapBehavSolver() { }
 
+  /// Minimization stops once the norm of the gradient of the Lyapunov
+  /// function is less than this
+  static const double GRADIENT_TOLERANCE;
+  /// Minimizers stop some way short of the equilibrium they approach, so
+  /// by default equilibria found from different starts are taken to be
+  /// the same when within this (a multiple of GRADIENT_TOLERANCE)
+  static const double DUPLICATE_TOLERANCE;
+
   List<MixedBehaviorProfile<double> > Solve(const MixedBehaviorProfile<double> &p_start) const;
   List<MixedBehaviorProfile<double> > Solve(const BehaviorSupportProfile &p_support) const
     { return Solve(MixedBehaviorProfile<double>(p_support)); }
+  /// \brief Minimizes from each of the starting points in turn.
+  ///
+  /// Up to p_threads starting points are minimized concurrently.
+  /// Equilibria are reported as they are found; an equilibrium within
+  /// p_tolerance (in each probability) of one already found is not
+  /// reported again.  Returns the distinct equilibria found.
+  List<MixedBehaviorProfile<double> > 
+  Solve(const List<MixedBehaviorProfile<double> > &p_starts,
+	int p_threads = 1,
+	double p_tolerance = DUPLICATE_TOLERANCE) const;
 
 private:
   int m_maxitsN;
   bool m_verbose;
+
+  /// Minimizes the Lyapunov function from p, which is replaced by the
+  /// minimizer; returns true if an equilibrium was found.
+  bool Minimize(MixedBehaviorProfile<double> &p) const;
 };
 
 #endif  // EFGLIAP_H
@@ -49,8 +49,11 @@ void PrintHelp(char *progname)
   std::cerr << "Options:\n";
   std::cerr << "  -d DECIMALS      print probabilities with DECIMALS digits\n";
   std::cerr << "  -h, --help       print this help message\n";
+  std::cerr << "  -j THREADS       minimize from THREADS starting points at once\n";
   std::cerr << "  -n COUNT         number of starting points to generate\n";
   std::cerr << "  -s FILE          file containing starting points\n";
+  std::cerr << "  -t TOLERANCE     report equilibria differing by less than TOLERANCE\n";
+  std::cerr << "                   in every probability only once (default is 0.01)\n";
   std::cerr << "  -q               quiet mode (suppresses banner)\n";
   std::cerr << "  -V, --verbose    verbose mode (shows intermediate output)\n";
   std::cerr << "                   (default is to only show equilibria)\n";
@@ -134,10 +137,11 @@ int main(int argc, char *argv[])
 {
   opterr = 0;
   bool quiet = false, useStrategic = false, useRandom = false, verbose = false;
-  int numTries = 10;
+  int numTries = 10, numThreads = 1;
   int maxitsN = 100;
   int numDecimals = 6;
   double tolN = 1.0e-10;
+  double tolerance = 0.0;
   std::string startFile = "";
  
   int long_opt_index = 0;
@@ -148,7 +152,7 @@ int main(int argc, char *argv[])
     { 0,    0,    0,    0   }
   };
   int c;
-  while ((c = getopt_long(argc, argv, "d:n:s:hqVvS", long_options, &long_opt_index)) != -1) {
+  while ((c = getopt_long(argc, argv, "d:n:s:j:t:hqVvS", long_options, &long_opt_index)) != -1) {
     switch (c) {
     case 'v':
       PrintBanner(std::cerr); exit(1);
@@ -158,9 +162,15 @@ int main(int argc, char *argv[])
     case 'n':
       numTries = atoi(optarg);
       break;
+    case 'j':
+      numThreads = atoi(optarg);
+      break;
     case 's':
       startFile = optarg;
       break;
+    case 't':
+      tolerance = atof(optarg);
+      break;
     case 'h':
       PrintHelp(argv[0]);
       break;
@@ -204,7 +214,8 @@ int main(int argc, char *argv[])
   }
 
   try {
-    Game game = ReadGame(*input_stream);
+    Game game = (optind < argc) ? ReadGameFile(argv[optind]) :
+      ReadGame(*input_stream);
     if (!game->IsTree() || useStrategic) {
       List<MixedStrategyProfile<double> > starts;
       if (startFile != "") {
@@ -216,13 +227,13 @@ int main(int argc, char *argv[])
 	starts = RandomStrategyProfiles(game, numTries);
       }
 
-      for (int i = 1; i <= starts.size(); i++) {
-	shared_ptr<StrategyProfileRenderer<double> > renderer;
-	renderer = new MixedStrategyCSVRenderer<double>(std::cout,
-							numDecimals);
-	NashLiapStrategySolver algorithm(maxitsN, verbose, renderer);
-	algorithm.Solve(starts[i]);
-      }
+      shared_ptr<StrategyProfileRenderer<double> > renderer;
+      renderer = new MixedStrategyCSVRenderer<double>(std::cout,
+						      numDecimals);
+      NashLiapStrategySolver algorithm(maxitsN, verbose, renderer);
+      algorithm.Solve(starts, numThreads,
+		      (tolerance > 0.0) ? tolerance :
+		      NashLiapStrategySolver::DUPLICATE_TOLERANCE);
     }
     else {
       List<MixedBehaviorProfile<double> > starts;
@@ -235,13 +246,13 @@ int main(int argc, char *argv[])
 	starts = RandomBehaviorProfiles(game, numTries);
       }
 
-      for (int i = 1; i <= starts.size(); i++) {
-	shared_ptr<StrategyProfileRenderer<double> > renderer;
-	renderer = new BehavStrategyCSVRenderer<double>(std::cout,
-							numDecimals);
-	NashLiapBehavSolver algorithm(maxitsN, verbose, renderer);
-	algorithm.Solve(starts[i]);
-      }
+      shared_ptr<StrategyProfileRenderer<double> > renderer;
+      renderer = new BehavStrategyCSVRenderer<double>(std::cout,
+						      numDecimals);
+      NashLiapBehavSolver algorithm(maxitsN, verbose, renderer);
+      algorithm.Solve(starts, numThreads,
+		      (tolerance > 0.0) ? tolerance :
+		      NashLiapBehavSolver::DUPLICATE_TOLERANCE);
     }
     return 0;
   }
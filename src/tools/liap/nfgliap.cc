@@ -24,9 +24,11 @@
 #include <unistd.h>
 #include <iostream>
 #include <fstream>
+#include <vector>
 
 #include "gambit/gambit.h"
 #include "gambit/function.h"
+#include "library/src/multirun.h"
 #include "nfgliap.h"
 
 using namespace Gambit;
@@ -49,37 +51,64 @@ private:
   double Value(const Vector<double> &) const;
   bool Gradient(const Vector<double> &, Vector<double> &) const;
 
-  double LiapDerivValue(int, int, const MixedStrategyProfile<double> &) const;
+  double LiapDerivValue(int, int, const MixedStrategyProfile<double> &,
+			const Vector<double> &) const;
 };
 
+//
+// The derivatives are computed from the strategy values and payoff
+// Jacobian of the profile, which are computed in bulk once per gradient
+// evaluation.  The profile is over the whole game, so strategies are
+// indexed consecutively by player.
+//
 double 
 StrategicLyapunovFunction::LiapDerivValue(int i1, int j1,
-					  const MixedStrategyProfile<double> &p) const
+					  const MixedStrategyProfile<double> &p,
+					  const Vector<double> &p_payoffs) const
 {
-  GameStrategy wrt_strategy = m_game->Players()[i1]->Strategies()[j1];
+  const Vector<double> &values = p.GetStrategyValues();
+  const Matrix<double> &jacobian = p.GetPayoffJacobian();
+
+  int wrt = j1;
+  for (int i = 1; i < i1; i++) {
+    wrt += m_game->Players()[i]->NumStrategies();
+  }
+
   double x = 0.0;
-  for (int i = 1; i <= m_game->NumPlayers(); i++)  {
+  for (int i = 1, offset = 0; i <= m_game->NumPlayers(); 
+       offset += m_game->Players()[i]->NumStrategies(), i++)  {
+    int numStrats = m_game->Players()[i]->NumStrategies();
+    // derivative of player i's payoff with respect to the strategy
+    double deriv = 0.0;
+    if (i == i1) {
+      deriv = values[wrt];
+    }
+    else {
+      for (int j = 1; j <= numStrats; j++) {
+	if (p[offset + j] > 0.0) {
+	  deriv += p[offset + j] * jacobian(offset + j, wrt);
+	}
+      }
+    }
+
     double psum = 0.0;
-    GamePlayer player = m_game->Players()[i];
-    for (int j = 1; j <= player->NumStrategies(); j++)  {
-      GameStrategy strategy = player->Strategies()[j];
-      psum += p[strategy];
-      double x1 = p.GetPayoff(strategy) - p.GetPayoff(i);
+    for (int j = 1; j <= numStrats; j++)  {
+      psum += p[offset + j];
+      double x1 = values[offset + j] - p_payoffs[i];
       if (i1 == i) {
 	if (x1 > 0.0)
-	  x -= x1 * p.GetPayoffDeriv(i, wrt_strategy);
+	  x -= x1 * deriv;
       }
       else if (x1 > 0.0) {
-	x += x1 * (p.GetPayoffDeriv(i, strategy, wrt_strategy) - 
-		   p.GetPayoffDeriv(i, wrt_strategy));
+	x += x1 * (jacobian(offset + j, wrt) - deriv);
       }
     }
     if (i == i1)  {
       x += 100.0 * (psum - 1.0);
     }
   }
-  if (p[wrt_strategy] < 0.0) {
-    x += p[wrt_strategy];
+  if (p[wrt] < 0.0) {
+    x += p[wrt];
   }
   return 2.0 * x;
 }
@@ -88,9 +117,13 @@ bool
 StrategicLyapunovFunction::Gradient(const Vector<double> &v, Vector<double> &d) const
 {
   static_cast<Vector<double> &>(m_profile).operator=(v);
+  Vector<double> payoffs(m_game->NumPlayers());
+  for (int pl = 1; pl <= m_game->NumPlayers(); pl++) {
+    payoffs[pl] = m_profile.GetPayoff(pl);
+  }
   for (int pl = 1, ii = 1; pl <= m_game->NumPlayers(); pl++) {
     for (int st = 1; st <= m_game->Players()[pl]->Strategies().size(); st++) {
-      d[ii++] = LiapDerivValue(pl, st, m_profile);
+      d[ii++] = LiapDerivValue(pl, st, m_profile, payoffs);
     }
   }
   Project(d, m_game->NumStrategies());
@@ -107,20 +140,12 @@ double StrategicLyapunovFunction::Value(const Vector<double> &v) const
 //                     class NashLiapStrategySolver
 //------------------------------------------------------------------------
 
-List<MixedStrategyProfile<double> > 
-NashLiapStrategySolver::Solve(const MixedStrategyProfile<double> &p_start) const
-{
-  if (!p_start.GetGame()->IsPerfectRecall()) {
-    throw UndefinedException("Computing equilibria of games with imperfect recall is not supported.");
-  }
+const double NashLiapStrategySolver::GRADIENT_TOLERANCE = .001;
+const double NashLiapStrategySolver::DUPLICATE_TOLERANCE = 10.0 * GRADIENT_TOLERANCE;
 
+bool NashLiapStrategySolver::Minimize(MixedStrategyProfile<double> &p) const
+{
   static const double ALPHA = .00000001;
-  List<MixedStrategyProfile<double> > solutions;
-
-  MixedStrategyProfile<double> p(p_start);
-  if (m_verbose) {
-    this->m_onEquilibrium->Render(p, "start");
-  }
 
   // if starting vector not interior, perturb it towards centroid
   int kk;
@@ -144,20 +169,85 @@ NashLiapStrategySolver::Solve(const MixedStrategyProfile<double> &p_start) const
       break;
     }
 
-    if (sqrt(gradient.NormSquared()) < .001) {
-      this->m_onEquilibrium->Render(p, "NE");
-      solutions.push_back(p);
-      break;
+    if (sqrt(gradient.NormSquared()) < GRADIENT_TOLERANCE) {
+      return true;
     }
   }
+  return false;
+}
 
-  if (m_verbose && sqrt(gradient.NormSquared()) >= .001) {
+List<MixedStrategyProfile<double> > 
+NashLiapStrategySolver::Solve(const MixedStrategyProfile<double> &p_start) const
+{
+  if (!p_start.GetGame()->IsPerfectRecall()) {
+    throw UndefinedException("Computing equilibria of games with imperfect recall is not supported.");
+  }
+
+  List<MixedStrategyProfile<double> > solutions;
+
+  MixedStrategyProfile<double> p(p_start);
+  if (m_verbose) {
+    this->m_onEquilibrium->Render(p, "start");
+  }
+
+  if (Minimize(p)) {
+    this->m_onEquilibrium->Render(p, "NE");
+    solutions.push_back(p);
+  }
+  else if (m_verbose) {
     this->m_onEquilibrium->Render(p, "end");
   }
 
   return solutions;
 }
 
+//
+// Each start is minimized on its own copy of the profile, with its own
+// Lyapunov function and minimizer.  The game itself is only read, once
+// anything it computes on demand has been built; results are checked
+// against those already found and reported one at a time.
+//
+List<MixedStrategyProfile<double> > 
+NashLiapStrategySolver::Solve(const List<MixedStrategyProfile<double> > &p_starts,
+			      int p_threads, double p_tolerance) const
+{
+  List<MixedStrategyProfile<double> > solutions;
+  if (p_starts.size() == 0) {
+    return solutions;
+  }
+  Game game = p_starts.front().GetGame();
+  if (!game->IsPerfectRecall()) {
+    throw UndefinedException("Computing equilibria of games with imperfect recall is not supported.");
+  }
+  if (!game->PrepareConcurrentAccess()) {
+    p_threads = 1;
+  }
 
+  std::vector<MixedStrategyProfile<double> > starts;
+  for (size_t i = 1; i <= p_starts.size(); i++) {
+    starts.push_back(p_starts[i]);
+  }
 
+#pragma omp parallel for schedule(dynamic) num_threads(p_threads)
+  for (int i = 0; i < (int) starts.size(); i++) {
+    MixedStrategyProfile<double> p(starts[i]);
+    bool found = Minimize(p);
+#pragma omp critical(liap_strategy_results)
+    {
+      if (m_verbose) {
+	this->m_onEquilibrium->Render(starts[i], "start");
+      }
+      if (found) {
+	if (IsNewEquilibrium(solutions, p, p_tolerance)) {
+	  this->m_onEquilibrium->Render(p, "NE");
+	  solutions.push_back(p);
+	}
+      }
+      else if (m_verbose) {
+	this->m_onEquilibrium->Render(p, "end");
+      }
+    }
+  }
 
+  return solutions;
+}
@@ -37,13 +37,35 @@ public:
   { }
   virtual ~NashLiapStrategySolver() { }
 
+  /// Minimization stops once the norm of the gradient of the Lyapunov
+  /// function is less than this
+  static const double GRADIENT_TOLERANCE;
+  /// Minimizers stop some way short of the equilibrium they approach, so
+  /// by default equilibria found from different starts are taken to be
+  /// the same when within this (a multiple of GRADIENT_TOLERANCE)
+  static const double DUPLICATE_TOLERANCE;
+
   List<MixedStrategyProfile<double> > Solve(const MixedStrategyProfile<double> &p_start) const;
   List<MixedStrategyProfile<double> > Solve(const Game &p_game) const
     { return Solve(p_game->NewMixedStrategyProfile(0.0)); }
+  /// \brief Minimizes from each of the starting points in turn.
+  ///
+  /// Up to p_threads starting points are minimized concurrently.
+  /// Equilibria are reported as they are found; an equilibrium within
+  /// p_tolerance (in each probability) of one already found is not
+  /// reported again.  Returns the distinct equilibria found.
+  List<MixedStrategyProfile<double> > 
+  Solve(const List<MixedStrategyProfile<double> > &p_starts,
+	int p_threads = 1,
+	double p_tolerance = DUPLICATE_TOLERANCE) const;
 
 private:
   int m_maxitsN;
   bool m_verbose;
+
+  /// Minimizes the Lyapunov function from p, which is replaced by the
+  /// minimizer; returns true if an equilibrium was found.
+  bool Minimize(MixedStrategyProfile<double> &p) const;
 };
 
 #endif  // NFGLIAP_H
@@ -23,20 +23,34 @@
 
 #include <cmath>
 #include <iostream>
+#include <algorithm>
+#include <functional>
 #include <gambit/gambit.h>
-#include "logbehav.imp"
 #include "efglogit.h"
 
 namespace Gambit {
 
 //------------------------------------------------------------------------------
-//                        Classes representing equations
+//                  AgentQREPathTracer: Equations on a flat tree
 //------------------------------------------------------------------------------
 
+//
+// The equations are evaluated on a flattened copy of the game tree,
+// which is built once when the system is constructed.  Nodes are
+// numbered in preorder, so that every node follows its parent and the
+// subtree of a node occupies a contiguous range of indices; realization
+// probabilities are then computed in one forward sweep, and node values
+// in one backward sweep, over plain arrays.
+//
+// Actions of the personal players are numbered from zero in the order
+// of the profile, which is also the order of the equations: the equation
+// of the first action of each information set is the sum-to-one equation
+// of the set, and the others are the ratio equations of their actions.
+//
 class AgentQREPathTracer::EquationSystem : public PathTracer::EquationSystem {
 public:
   EquationSystem(const Game &p_game);
-  virtual ~EquationSystem();
+  virtual ~EquationSystem() { }
   // Compute the value of the system of equations at the specified point.
   virtual void GetValue(const Vector<double> &p_point,
   	                Vector<double> &p_lhs) const;
@@ -45,227 +59,427 @@ public:
 			   Matrix<double> &p_matrix) const;
 
 private:
-  //
-  // This abstract base class represents one of the defining equations of the system.
-  //
-  class Equation {
-  public:
-    virtual ~Equation() { }
-    virtual double Value(const LogBehavProfile<double> &p_point,
-			 double p_lambda) const = 0;
-    virtual void Gradient(const LogBehavProfile<double> &p_point, 
-			  double p_lambda,
-			  Vector<double> &p_gradient) const = 0;
-  };
-
-  //
-  // This class represents the equation that the probabilities of actions
-  // in information set (pl,iset) sums to one
-  //
-  class SumToOneEquation : public Equation {
-  private:
-    Game m_game;
-    int m_pl, m_iset;
-    GameInfoset m_infoset;
-
-  public:
-    SumToOneEquation(Game p_game, int p_player, int p_infoset)
-      : m_game(p_game), m_pl(p_player), m_iset(p_infoset),
-	m_infoset(p_game->GetPlayer(p_player)->GetInfoset(p_infoset))
-    { }
-
-    double Value(const LogBehavProfile<double> &p_profile,
-		 double p_lambda) const;
-    void Gradient(const LogBehavProfile<double> &p_profile, double p_lambda,
-		  Vector<double> &p_gradient) const;
-  };
-
-  //
-  // This class represents the equation relating the probability of 
-  // playing action (pl,iset,act) to the probability of playing action
-  // (pl,iset,1)
-  //
-  class RatioEquation : public Equation {
-  private:
-    Game m_game;
-    int m_pl, m_iset, m_act;
-    GameInfoset m_infoset;
-
-  public:
-    RatioEquation(Game p_game, int p_player, int p_infoset, int p_action)
-      : m_game(p_game), m_pl(p_player), m_iset(p_infoset), m_act(p_action),
-	m_infoset(p_game->GetPlayer(p_player)->GetInfoset(p_infoset))
-    { }
-
-    double Value(const LogBehavProfile<double> &p_profile, 
-		 double p_lambda) const;
-    void Gradient(const LogBehavProfile<double> &p_profile, double p_lambda,
-		  Vector<double> &p_gradient) const;
-  };
-
-  Array<Equation *> m_equations;
-  const Game &m_game;
+  int m_numPlayers, m_numActions;
+
+  // Node data, indexed in preorder.  The action leading to a node is -1
+  // at the root and at the children of chance nodes, which instead carry
+  // the (log) probability of their chance action.  The infoset of a node
+  // is -1 at chance and terminal nodes.
+  std::vector<int> m_parent, m_action, m_infoset, m_end;
+  std::vector<double> m_chanceProb, m_logChanceProb;
+  // The children of node n are m_children[m_firstChild[n]..m_firstChild[n+1]-1]
+  std::vector<int> m_firstChild, m_children;
+  // Sum of the outcomes along the path to each node, for each player
+  std::vector<double> m_payoffs;
+
+  // Information set data.  The actions of infoset h are numbered
+  // m_firstAction[h]..m_firstAction[h+1]-1, and its members, in the order
+  // of the game, are m_members[m_firstMember[h]..m_firstMember[h+1]-1].
+  std::vector<int> m_player, m_firstAction, m_firstMember, m_members;
+  // The infoset at which each action is taken
+  std::vector<int> m_actionInfoset;
+  // For each infoset, the infosets with members on the path to one of its
+  // members, and itself, in descending preorder of the nodes, which is the
+  // order in which derivatives are propagated up the tree
+  std::vector<int> m_firstAncestor, m_ancestors;
+
+  // The point at which the following were last computed, if any
+  mutable bool m_isValid;
+  mutable Vector<double> m_point;
+  mutable std::vector<double> m_prob, m_logProb, m_logRealiz, m_belief;
+  mutable std::vector<double> m_nodeValues, m_actionValues;
+  // Scratch space for the Jacobian
+  mutable std::vector<double> m_diff, m_diffValues;
+  mutable std::vector<int> m_touched;
+  mutable std::vector<bool> m_isTouched;
+
+  double EdgeProb(int n) const
+  { return (m_action[n] >= 0) ? m_prob[m_action[n]] : m_chanceProb[n]; }
+
+  void SetPoint(const Vector<double> &p_point) const;
+  void DiffActionValues(int p_action) const;
 };
 
 AgentQREPathTracer::EquationSystem::EquationSystem(const Game &p_game)
-  : m_game(p_game)
+  : m_numPlayers(p_game->NumPlayers()), m_numActions(0),
+    m_isValid(false), m_point(p_game->BehavProfileLength() + 1)
 {
-  for (int pl = 1; pl <= m_game->NumPlayers(); pl++) {
-    GamePlayer player = m_game->GetPlayer(pl);
+  // Number the infosets and actions in profile order
+  Array<int> isetOffset(m_numPlayers);
+  for (int pl = 1; pl <= m_numPlayers; pl++) {
+    GamePlayer player = p_game->GetPlayer(pl);
+    isetOffset[pl] = m_player.size();
     for (int iset = 1; iset <= player->NumInfosets(); iset++) {
-      m_equations.Append(new SumToOneEquation(m_game, pl, iset));
-      for (int act = 2; act <= player->GetInfoset(iset)->NumActions(); act++) {
-	m_equations.Append(new RatioEquation(m_game, pl, iset, act));
+      m_player.push_back(pl - 1);
+      m_firstAction.push_back(m_numActions);
+      int numActions = player->GetInfoset(iset)->NumActions();
+      for (int act = 1; act <= numActions; act++) {
+	m_actionInfoset.push_back(m_player.size() - 1);
       }
+      m_numActions += numActions;
     }
   }
-}
+  m_firstAction.push_back(m_numActions);
+  int numInfosets = m_player.size();
+
+  // Flatten the tree in preorder
+  std::vector<int> index(p_game->NumNodes() + 1, -1);
+  std::vector<GameNode> stack;
+  stack.push_back(p_game->GetRoot());
+  while (!stack.empty()) {
+    GameNode node = stack.back();
+    stack.pop_back();
+    int n = m_parent.size();
+    index[node->GetNumber()] = n;
+
+    GameNode parent = node->GetParent();
+    int p = (parent) ? index[parent->GetNumber()] : -1;
+    m_parent.push_back(p);
+    m_action.push_back(-1);
+    m_chanceProb.push_back(1.0);
+    m_logChanceProb.push_back(0.0);
+    if (parent) {
+      GameInfoset infoset = parent->GetInfoset();
+      int act = node->GetPriorAction()->GetNumber();
+      if (infoset->IsChanceInfoset()) {
+	m_chanceProb[n] = infoset->GetActionProb(act, (double) 0);
+	m_logChanceProb[n] = log(m_chanceProb[n]);
+      }
+      else {
+	m_action[n] = m_firstAction[m_infoset[p]] + act - 1;
+      }
+    }
 
-AgentQREPathTracer::EquationSystem::~EquationSystem()
-{
-  for (int i = 1; i <= m_equations.Length(); i++) {
-    delete m_equations[i];
+    for (int pl = 1; pl <= m_numPlayers; pl++) {
+      double payoff = (p >= 0) ? m_payoffs[p * m_numPlayers + pl - 1] : 0.0;
+      if (node->GetOutcome()) {
+	payoff += node->GetOutcome()->GetPayoff<double>(pl);
+      }
+      m_payoffs.push_back(payoff);
+    }
+
+    GameInfoset infoset = node->GetInfoset();
+    m_infoset.push_back((infoset && !infoset->IsChanceInfoset()) ?
+			isetOffset[infoset->GetPlayer()->GetNumber()] +
+			infoset->GetNumber() - 1 : -1);
+    for (int child = node->NumChildren(); child >= 1; child--) {
+      stack.push_back(node->GetChild(child));
+    }
   }
-}
+  int numNodes = m_parent.size();
+
+  // Children, and the extents of the subtrees
+  m_end.resize(numNodes);
+  for (int n = numNodes - 1; n >= 0; n--) {
+    if (m_end[n] == 0) m_end[n] = n + 1;
+    if (m_parent[n] >= 0) {
+      m_end[m_parent[n]] = std::max(m_end[m_parent[n]], m_end[n]);
+    }
+  }
+  for (int n = 0; n < numNodes; n++) {
+    m_firstChild.push_back(m_children.size());
+    for (int c = n + 1; c < m_end[n]; c = m_end[c]) {
+      m_children.push_back(c);
+    }
+  }
+  m_firstChild.push_back(m_children.size());
 
-double
-AgentQREPathTracer::EquationSystem::SumToOneEquation::Value(const LogBehavProfile<double> &p_profile,
-							    double p_lambda) const
-{
-  double value = -1.0;
-  for (int act = 1; act <= m_infoset->NumActions(); act++) {
-    value += p_profile.GetProb(m_pl, m_iset, act);
+  // Members of the infosets, in the order of the game
+  for (int pl = 1; pl <= m_numPlayers; pl++) {
+    GamePlayer player = p_game->GetPlayer(pl);
+    for (int iset = 1; iset <= player->NumInfosets(); iset++) {
+      GameInfoset infoset = player->GetInfoset(iset);
+      m_firstMember.push_back(m_members.size());
+      for (int i = 1; i <= infoset->NumMembers(); i++) {
+	m_members.push_back(index[infoset->GetMember(i)->GetNumber()]);
+      }
+    }
   }
-  return value;
+  m_firstMember.push_back(m_members.size());
+
+  // The nodes at which the derivatives with respect to the actions
+  // of each infoset are nonzero: its members, and their ancestors
+  std::vector<int> stamp(numNodes, -1);
+  for (int h = 0; h < numInfosets; h++) {
+    m_firstAncestor.push_back(m_ancestors.size());
+    for (int i = m_firstMember[h]; i < m_firstMember[h+1]; i++) {
+      for (int n = m_members[i]; n >= 0 && stamp[n] != h; n = m_parent[n]) {
+	stamp[n] = h;
+	m_ancestors.push_back(n);
+      }
+    }
+    std::sort(m_ancestors.begin() + m_firstAncestor[h], m_ancestors.end(),
+	      std::greater<int>());
+  }
+  m_firstAncestor.push_back(m_ancestors.size());
+
+  m_prob.resize(m_numActions);
+  m_logProb.resize(m_numActions);
+  m_logRealiz.resize(numNodes);
+  m_belief.resize(numNodes);
+  m_nodeValues.resize(numNodes * m_numPlayers);
+  m_actionValues.resize(m_numActions);
+  m_diff.resize(m_numActions, 0.0);
+  m_diffValues.resize(numNodes * m_numPlayers);
+  m_isTouched.resize(numInfosets, false);
 }
 
+//
+// Computes the realization probabilities, beliefs, node values and
+// action values at the point, if it differs from the last one.  Node
+// values include the outcomes along the path to the node, as in
+// computing the values of behavior profiles.
+//
 void
-AgentQREPathTracer::EquationSystem::SumToOneEquation::Gradient(const LogBehavProfile<double> &p_profile,
-							       double p_lambda,
-							       Vector<double> &p_gradient) const
+AgentQREPathTracer::EquationSystem::SetPoint(const Vector<double> &p_point) const
 {
-  int i = 1;
-  for (int pl = 1; pl <= m_game->NumPlayers(); pl++) {
-    GamePlayer player = m_game->GetPlayer(pl);
+  bool same = m_isValid;
+  for (int i = 1; same && i < p_point.Length(); i++) {
+    same = (p_point[i] == m_point[i]);
+  }
+  if (same) return;
+  m_isValid = true;
+  for (int i = 1; i < p_point.Length(); i++) {
+    m_point[i] = p_point[i];
+  }
 
-    for (int iset = 1; iset <= player->NumInfosets(); iset++) {
-      GameInfoset infoset = player->GetInfoset(iset);
+  for (int a = 0; a < m_numActions; a++) {
+    m_logProb[a] = p_point[a + 1];
+    m_prob[a] = exp(m_logProb[a]);
+  }
 
-      for (int act = 1; act <= infoset->NumActions(); act++, i++) {
-	if (pl == m_pl && iset == m_iset) {
-	  p_gradient[i] = p_profile.GetProb(pl, iset, act);
-	}
-	else {
-	  p_gradient[i] = 0.0;
-	}
-      }
-    }
+  int numNodes = m_parent.size();
+  m_logRealiz[0] = 0.0;
+  for (int n = 1; n < numNodes; n++) {
+    m_logRealiz[n] = m_logRealiz[m_parent[n]] +
+      ((m_action[n] >= 0) ? m_logProb[m_action[n]] : m_logChanceProb[n]);
   }
 
-  // Derivative wrt lambda is zero
-  p_gradient[i] = 0.0;
-}
-			       
+  // Beliefs are computed relative to the most likely member, so that
+  // they remain defined when realization probabilities underflow
+  for (int h = 0; h < (int) m_player.size(); h++) {
+    int first = m_firstMember[h], last = m_firstMember[h+1];
+    if (first == last) continue;
+    double maxLogProb = m_logRealiz[m_members[first]];
+    for (int i = first + 1; i < last; i++) {
+      maxLogProb = std::max(maxLogProb, m_logRealiz[m_members[i]]);
+    }
+    double total = 0.0;
+    for (int i = first; i < last; i++) {
+      total += exp(m_logRealiz[m_members[i]] - maxLogProb);
+    }
+    for (int i = first; i < last; i++) {
+      m_belief[m_members[i]] =
+	exp(m_logRealiz[m_members[i]] - maxLogProb) / total;
+    }
+  }
 
+  for (int n = numNodes - 1; n >= 0; n--) {
+    double *value = &m_nodeValues[n * m_numPlayers];
+    if (m_firstChild[n] == m_firstChild[n+1]) {
+      std::copy(&m_payoffs[n * m_numPlayers],
+		&m_payoffs[n * m_numPlayers] + m_numPlayers, value);
+      continue;
+    }
+    std::fill(value, value + m_numPlayers, 0.0);
+    for (int i = m_firstChild[n]; i < m_firstChild[n+1]; i++) {
+      int c = m_children[i];
+      double prob = EdgeProb(c);
+      const double *childValue = &m_nodeValues[c * m_numPlayers];
+      for (int pl = 0; pl < m_numPlayers; pl++) {
+	value[pl] += prob * childValue[pl];
+      }
+    }
+  }
 
-double
-AgentQREPathTracer::EquationSystem::RatioEquation::Value(const LogBehavProfile<double> &p_profile,
-							 double p_lambda) const
-{
-  return (p_profile.GetLogProb(m_pl, m_iset, m_act) - 
-	  p_profile.GetLogProb(m_pl, m_iset, 1) -
-	  p_lambda *
-	  (p_profile.GetPayoff(m_infoset->GetAction(m_act)) -
-	   p_profile.GetPayoff(m_infoset->GetAction(1))));
+  std::fill(m_actionValues.begin(), m_actionValues.end(), 0.0);
+  for (int n = 0; n < numNodes; n++) {
+    int h = m_infoset[n];
+    if (h < 0) continue;
+    for (int i = m_firstChild[n]; i < m_firstChild[n+1]; i++) {
+      int c = m_children[i];
+      m_actionValues[m_action[c]] +=
+	m_belief[n] * m_nodeValues[c * m_numPlayers + m_player[h]];
+    }
+  }
 }
 
+//
+// Computes into m_diff the derivatives of the values of the actions at
+// infosets other than that of p_action with respect to the log of the
+// probability of p_action.  The infosets at which any are nonzero are
+// listed in m_touched.
+//
+// There are two contributions.  Beliefs at infosets following p_action
+// shift toward the members reached through it; and the values of nodes
+// preceding the members of the infoset of p_action change with the
+// probability it is played.
+//
 void
-AgentQREPathTracer::EquationSystem::RatioEquation::Gradient(const LogBehavProfile<double> &p_profile,
-							    double p_lambda,
-							    Vector<double> &p_gradient) const
+AgentQREPathTracer::EquationSystem::DiffActionValues(int p_action) const
 {
-  int i = 1;
-  for (int pl = 1; pl <= m_game->NumPlayers(); pl++) {
-    GamePlayer player = m_game->GetPlayer(pl);
-    for (int iset = 1; iset <= player->NumInfosets(); iset++) {
-      GameInfoset infoset = player->GetInfoset(iset);
-      for (int act = 1; act <= infoset->NumActions(); act++, i++) {
-	if (infoset == m_infoset) {
-	  if (act == 1) {
-	    p_gradient[i] = -1.0;
-	  }
-	  else if (act == m_act) {
-	    p_gradient[i] = 1.0; 
-	  }
-	  else {
-	    p_gradient[i] = 0.0;
-	  }
-	}
-	else {   // infoset1 != infoset2
-	  p_gradient[i] = 
-	    -p_lambda * 
-	    (p_profile.DiffActionValue(m_infoset->GetAction(m_act),
-				       infoset->GetAction(act)) -
-	     p_profile.DiffActionValue(m_infoset->GetAction(1),
-				       infoset->GetAction(act)));
-	}
+  for (size_t i = 0; i < m_touched.size(); i++) {
+    int h = m_touched[i];
+    std::fill(m_diff.begin() + m_firstAction[h],
+	      m_diff.begin() + m_firstAction[h+1], 0.0);
+    m_isTouched[h] = false;
+  }
+  m_touched.clear();
+
+  int infoset = m_actionInfoset[p_action];
+  int local = p_action - m_firstAction[infoset];
+  double prob = m_prob[p_action];
+
+  for (int i = m_firstMember[infoset]; i < m_firstMember[infoset+1]; i++) {
+    int m = m_members[i];
+    int child = m_children[m_firstChild[m] + local];
+
+    // Beliefs at infosets in the subtree following the action
+    for (int n = child; n < m_end[child]; n++) {
+      int h = m_infoset[n];
+      if (h < 0) continue;
+      if (!m_isTouched[h]) {
+	m_isTouched[h] = true;
+	m_touched.push_back(h);
+      }
+      int pl = m_player[h];
+      for (int j = m_firstChild[n]; j < m_firstChild[n+1]; j++) {
+	int c = m_children[j];
+	m_diff[m_action[c]] +=
+	  m_belief[n] * (m_nodeValues[c * m_numPlayers + pl] -
+			 m_actionValues[m_action[c]]);
       }
     }
+
+    const double *value = &m_nodeValues[child * m_numPlayers];
+    double *diff = &m_diffValues[m * m_numPlayers];
+    for (int pl = 0; pl < m_numPlayers; pl++) {
+      diff[pl] = prob * value[pl];
+    }
   }
 
-  p_gradient[i] = (p_profile.GetPayoff(m_infoset->GetAction(1)) -
-		   p_profile.GetPayoff(m_infoset->GetAction(m_act)));
+  // Propagate the derivatives of node values up from the members
+  for (int i = m_firstAncestor[infoset]; i < m_firstAncestor[infoset+1]; i++) {
+    int n = m_ancestors[i];
+    if (m_infoset[n] != infoset) {
+      std::fill(&m_diffValues[n * m_numPlayers],
+		&m_diffValues[n * m_numPlayers] + m_numPlayers, 0.0);
+    }
+  }
+  for (int i = m_firstAncestor[infoset]; i < m_firstAncestor[infoset+1]; i++) {
+    int n = m_ancestors[i], p = m_parent[n];
+    if (p < 0) continue;
+    const double *diff = &m_diffValues[n * m_numPlayers];
+    double *parentDiff = &m_diffValues[p * m_numPlayers];
+    double edgeProb = EdgeProb(n);
+    for (int pl = 0; pl < m_numPlayers; pl++) {
+      parentDiff[pl] += edgeProb * diff[pl];
+    }
+    int h = m_infoset[p];
+    if (h >= 0) {
+      if (!m_isTouched[h]) {
+	m_isTouched[h] = true;
+	m_touched.push_back(h);
+      }
+      m_diff[m_action[n]] += m_belief[p] * diff[m_player[h]];
+    }
+  }
 }
 
-
 void
 AgentQREPathTracer::EquationSystem::GetValue(const Vector<double> &p_point,
 					     Vector<double> &p_lhs) const
 {
-  LogBehavProfile<double> profile(m_game);
-  for (int i = 1; i <= profile.Length(); i++) {
-    profile.SetLogProb(i, p_point[i]);
-  }
-
+  SetPoint(p_point);
   double lambda = p_point[p_point.Length()];
 
-  for (int i = 1; i <= p_lhs.Length(); i++) {
-    p_lhs[i] = m_equations[i]->Value(profile, lambda);
+  for (int h = 0; h < (int) m_player.size(); h++) {
+    int first = m_firstAction[h];
+    // This is the sum-to-one equation
+    p_lhs[first + 1] = -1.0;
+    for (int a = first; a < m_firstAction[h+1]; a++) {
+      p_lhs[first + 1] += m_prob[a];
+    }
+    // These are the ratio equations
+    for (int a = first + 1; a < m_firstAction[h+1]; a++) {
+      p_lhs[a + 1] = (m_logProb[a] - m_logProb[first] -
+		      lambda * (m_actionValues[a] - m_actionValues[first]));
+    }
   }
 }
 
+//
+// The matrix is the transpose of the Jacobian, with one column for each
+// equation.  It is filled a row at a time, as the derivatives of all
+// the action values with respect to one action are computed together.
+//
 void
 AgentQREPathTracer::EquationSystem::GetJacobian(const Vector<double> &p_point, 
 						Matrix<double> &p_matrix) const
 {
-  LogBehavProfile<double> profile(m_game);
-  for (int i = 1; i <= profile.Length(); i++) {
-    profile.SetLogProb(i, p_point[i]);
-  }
+  SetPoint(p_point);
   double lambda = p_point[p_point.Length()];
 
-  for (int i = 1; i <= m_equations.Length(); i++) {
-    Vector<double> column(p_point.Length());
-    m_equations[i]->Gradient(profile, lambda, column);
-    p_matrix.SetColumn(i, column);
+  for (int b = 0; b < m_numActions; b++) {
+    int infoset = m_actionInfoset[b];
+    DiffActionValues(b);
+
+    for (int col = 1; col <= m_numActions; col++) {
+      p_matrix(b + 1, col) = 0.0;
+    }
+    // The equations of the infoset of the action itself
+    int own = m_firstAction[infoset];
+    p_matrix(b + 1, own + 1) = m_prob[b];
+    for (int a = own + 1; a < m_firstAction[infoset+1]; a++) {
+      if (b == own) {
+	p_matrix(b + 1, a + 1) = -1.0;
+      }
+      else if (b == a) {
+	p_matrix(b + 1, a + 1) = 1.0;
+      }
+    }
+    // The ratio equations of the other infosets whose values change
+    for (size_t i = 0; i < m_touched.size(); i++) {
+      int h = m_touched[i];
+      if (h == infoset) continue;
+      int first = m_firstAction[h];
+      for (int a = first + 1; a < m_firstAction[h+1]; a++) {
+	p_matrix(b + 1, a + 1) = -lambda * (m_diff[a] - m_diff[first]);
+      }
+    }
+  }
+
+  // The last row is the derivative wrt lambda
+  for (int h = 0; h < (int) m_player.size(); h++) {
+    int first = m_firstAction[h];
+    p_matrix(m_numActions + 1, first + 1) = 0.0;
+    for (int a = first + 1; a < m_firstAction[h+1]; a++) {
+      p_matrix(m_numActions + 1, a + 1) =
+	m_actionValues[first] - m_actionValues[a];
+    }
   }
 }
 
 class AgentQREPathTracer::CallbackFunction : public PathTracer::CallbackFunction {
 public:
   CallbackFunction(std::ostream &p_stream,
+		   const Game &p_game,
 		   bool p_fullGraph, double p_decimals)
-    : m_stream(p_stream),
+    : m_stream(p_stream), m_game(p_game),
       m_fullGraph(p_fullGraph), m_decimals(p_decimals) { }
   virtual ~CallbackFunction() { }
 
   virtual void operator()(const Vector<double> &p_point,
 			  bool p_isTerminal) const;
+  const List<LogitQREMixedBehaviorProfile> &GetProfiles(void) const
+  { return m_profiles; }
 
 private:
   std::ostream &m_stream;
+  Game m_game;
   bool m_fullGraph;
   double m_decimals;
+  mutable List<LogitQREMixedBehaviorProfile> m_profiles;
 };
 
 void AgentQREPathTracer::CallbackFunction::operator()(const Vector<double> &x,
@@ -285,35 +499,22 @@ void AgentQREPathTracer::CallbackFunction::operator()(const Vector<double> &x,
   }
   m_stream.unsetf(std::ios::fixed);
 
+  MixedBehaviorProfile<double> profile(m_game);
   for (int i = 1; i < x.Length(); i++) {
-    m_stream << "," << std::setprecision(m_decimals) << exp(x[i]);
+    profile[i] = exp(x[i]);
+    m_stream << "," << std::setprecision(m_decimals) << profile[i];
   }
 
   m_stream << std::endl;
+  m_profiles.push_back(LogitQREMixedBehaviorProfile(profile, x[x.Length()]));
 }
 
-//------------------------------------------------------------------------------
-//                   AgentQREPathTracer: Criterion function
-//------------------------------------------------------------------------------
-
-class AgentQREPathTracer::LambdaCriterion : public PathTracer::CriterionFunction {
-public:
-  LambdaCriterion(double p_lambda) : m_lambda(p_lambda) { }
-
-  virtual double operator()(const Vector<double> &p_point,
-			    const Vector<double> &p_tangent) const
-  { return p_point[p_point.Length()] - m_lambda; }
-
-private:
-  double m_lambda;
-};
-
 //------------------------------------------------------------------------------
 //              AgentQREPathTracer: Wrapper to the tracing engine
 //------------------------------------------------------------------------------
 
 
-void 
+List<LogitQREMixedBehaviorProfile>
 AgentQREPathTracer::TraceAgentPath(const LogitQREMixedBehaviorProfile &p_start,
 				   std::ostream &p_stream, 
 				   double p_maxLambda, 
@@ -325,17 +526,17 @@ AgentQREPathTracer::TraceAgentPath(const LogitQREMixedBehaviorProfile &p_start,
   }
   x[x.Length()] = p_start.GetLambda();
 
+  std::string key = GetCacheKey(p_start.GetGame(), "agent");
+  CallbackFunction func(p_stream, p_start.GetGame(), m_fullGraph, m_decimals);
   if (p_targetLambda > 0.0) {
-    TracePath(EquationSystem(p_start.GetGame()),
-	      x, p_maxLambda, p_omega,
-	      CallbackFunction(p_stream, m_fullGraph, m_decimals),
-	      LambdaCriterion(p_targetLambda));
+    SolveCachedAtLambda(EquationSystem(p_start.GetGame()), key,
+			x, p_targetLambda, p_maxLambda, p_omega, func);
   }
   else {
-    TracePath(EquationSystem(p_start.GetGame()),
-	      x, p_maxLambda, p_omega,
-	      CallbackFunction(p_stream, m_fullGraph, m_decimals));
+    TraceCachedPath(EquationSystem(p_start.GetGame()), key,
+		    x, p_maxLambda, p_omega, func);
   }
+  return func.GetProfiles();
 }
 
 }  // end namespace Gambit
@@ -29,6 +29,7 @@
 namespace Gambit  {
 
 class LogitQREMixedBehaviorProfile {
+  friend class AgentQREPathTracer;
 public:
   LogitQREMixedBehaviorProfile(const Game &p_game)
     : m_profile(p_game), m_lambda(0.0)
@@ -42,6 +43,14 @@ public:
   double operator[](int i) const        { return m_profile[i]; }
   
 private:
+  // Construct a logit QRE with a given behavior profile and lambda value.
+  // Access is restricted to classes in this module, which ensure that
+  // objects so constructed are in fact QREs.
+  LogitQREMixedBehaviorProfile(const MixedBehaviorProfile<double> &p_profile,
+			       double p_lambda)
+    : m_profile(p_profile), m_lambda(p_lambda)
+  { }
+
   const MixedBehaviorProfile<double> m_profile;
   double m_lambda;
 };
@@ -52,7 +61,7 @@ public:
   AgentQREPathTracer(void) : m_fullGraph(true), m_decimals(6) { }
   virtual ~AgentQREPathTracer() { }
 
-  void 
+  List<LogitQREMixedBehaviorProfile>
   TraceAgentPath(const LogitQREMixedBehaviorProfile &p_start,
 		 std::ostream &p_stream,
 		 double p_maxLambda, double p_omega,
@@ -70,7 +79,6 @@ private:
 
   class EquationSystem;
   class CallbackFunction;
-  class LambdaCriterion;
 };
 
 }  // end namespace Gambit
@@ -22,6 +22,7 @@
 //
 
 #include <iostream>
+#include <algorithm>
 #include <fstream>
 #include <cstdlib>
 #include <cerrno>
@@ -53,32 +54,45 @@ void PrintHelp(char *progname)
   std::cerr << "  -s STEP          initial stepsize (default is .03)\n";
   std::cerr << "  -a ACCEL         maximum acceleration (default is 1.1)\n";
   std::cerr << "  -m MAXLAMBDA     stop when reaching MAXLAMBDA (default is 1000000)\n";
+  std::cerr << "  -u UPDATES       update the Jacobian for up to UPDATES steps\n";
+  std::cerr << "                   between computing it (default is 0)\n";
   std::cerr << "  -l LAMBDA        compute QRE at `lambda` accurately\n";
+  std::cerr << "  -c DIRECTORY     keep traced branches in DIRECTORY, and reuse them\n";
   std::cerr << "  -L FILE          compute maximum likelihood estimates;\n";
-  std::cerr << "                   read strategy frequencies from FILE\n";
+  std::cerr << "                   read strategy frequencies from FILE, one\n";
+  std::cerr << "                   data set per line\n";
   std::cerr << "  -h, --help       print this help message\n";
   std::cerr << "  -q               quiet mode (suppresses banner)\n";
   std::cerr << "  -e               print only the terminal equilibrium\n";
   std::cerr << "                   (default is to print the entire branch)\n";
+  std::cerr << "  -V               report the steps taken on each path traced\n";
   std::cerr << "  -v, --version    print version information\n";
   exit(1);
 }
 
 //
-// Read in a comma-separated values list of observed data values
+// Read in a comma-separated values list of observed data values.
+// Returns false if there are no more data sets in the stream, and
+// throws InvalidFileException if the data set is malformed.
 //
 bool ReadProfile(std::istream &p_stream, Vector<double> &p_profile)
 {
-  for (int i = 1; i <= p_profile.Length(); i++) {
-    if (p_stream.eof() || p_stream.bad()) {
-      return false;
-    }
+  p_stream >> std::ws;
+  if (p_stream.eof()) {
+    return false;
+  }
 
+  for (int i = 1; i <= p_profile.Length(); i++) {
     p_stream >> p_profile[i];
     if (i < p_profile.Length()) {
       char comma;
       p_stream >> comma;
     }
+    if (p_stream.fail()) {
+      throw InvalidFileException("Expected " +
+				 lexical_cast<std::string>(p_profile.Length()) +
+				 " comma-separated strategy frequencies");
+    }
   }
   // Read in the rest of the line and discard
   std::string foo;
@@ -86,12 +100,29 @@ bool ReadProfile(std::istream &p_stream, Vector<double> &p_profile)
   return true;
 }
 
+//
+// Report the number of steps of each kind taken on each path, followed
+// by the kind of each step in turn
+//
+void PrintStepRecord(std::ostream &p_stream,
+		     const PathTracer::StepRecord &p_record)
+{
+  for (size_t i = 0; i < p_record.size(); i++) {
+    const std::string &steps = p_record[i];
+    p_stream << "Path " << (i + 1) << ": " << steps.size() << " steps, "
+	     << std::count(steps.begin(), steps.end(), 'F') << " factored, "
+	     << std::count(steps.begin(), steps.end(), 'U') << " updated, "
+	     << (std::count(steps.begin(), steps.end(), 'f') +
+		 std::count(steps.begin(), steps.end(), 'u')) << " rejected: "
+	     << steps << std::endl;
+  }
+}
 
 int main(int argc, char *argv[])
 {
   opterr = 0;
 
-  bool quiet = false, useStrategic = false;
+  bool quiet = false, useStrategic = false, verbose = false;
   double maxLambda = 1000000.0;
   std::string mleFile = "";
   double maxDecel = 1.1;
@@ -99,6 +130,9 @@ int main(int argc, char *argv[])
   double targetLambda = -1.0;
   bool fullGraph = true;
   int decimals = 6;
+  int maxUpdates = 0;
+  std::string cacheDirectory = "";
+  PathTracer::StepRecord steps;
 
   int long_opt_index = 0;
   struct option long_options[] = {
@@ -107,13 +141,16 @@ int main(int argc, char *argv[])
     { 0,    0,    0,    0   }
   };
   int c;
-  while ((c = getopt_long(argc, argv, "d:s:a:m:vqehSL:p:l:", long_options, &long_opt_index)) != -1) {
+  while ((c = getopt_long(argc, argv, "d:s:a:m:u:c:vVqehSL:p:l:", long_options, &long_opt_index)) != -1) {
     switch (c) {
     case 'v':
       PrintBanner(std::cerr); exit(1);
     case 'q':
       quiet = true;
       break;
+    case 'V':
+      verbose = true;
+      break;
     case 'd':
       decimals = atoi(optarg);
       break;
@@ -126,6 +163,9 @@ int main(int argc, char *argv[])
     case 'm':
       maxLambda = atof(optarg);
       break;
+    case 'u':
+      maxUpdates = atoi(optarg);
+      break;
     case 'e':
       fullGraph = false;
       break;
@@ -141,6 +181,9 @@ int main(int argc, char *argv[])
     case 'l':
       targetLambda = atof(optarg);
       break;
+    case 'c':
+      cacheDirectory = optarg;
+      break;
     case '?':
       if (isprint(optopt)) {
 	std::cerr << argv[0] << ": Unknown option `-" << ((char) optopt) << "'.\n";
@@ -172,23 +215,49 @@ int main(int argc, char *argv[])
   }
 
   try {
-    Game game = ReadGame(*input_stream);
+    Game game = (optind < argc) ? ReadGameFile(argv[optind]) :
+      ReadGame(*input_stream);
     if (!game->IsPerfectRecall()) {
       throw UndefinedException("Computing equilibria of games with imperfect recall is not supported.");
     }
 
     if (mleFile != "" && (!game->IsTree() || useStrategic)) {
-      MixedStrategyProfile<double> frequencies(game->NewMixedStrategyProfile(0.0));
+      // Each line of the file is a separate data set
+      List<MixedStrategyProfile<double> > frequencies;
       std::ifstream mleData(mleFile.c_str());
-      ReadProfile(mleData, frequencies);
+      if (!mleData.is_open()) {
+	std::ostringstream error_message;
+	error_message << argv[0] << ": " << mleFile;
+	perror(error_message.str().c_str());
+	exit(1);
+      }
+      MixedStrategyProfile<double> data(game->NewMixedStrategyProfile(0.0));
+      while (ReadProfile(mleData, data)) {
+	frequencies.push_back(data);
+      }
+      if (frequencies.size() == 0) {
+	throw InvalidFileException("No strategy frequencies in " + mleFile);
+      }
 
       LogitQREMixedStrategyProfile start(game);
       StrategicQREEstimator tracer;
       tracer.SetMaxDecel(maxDecel);
       tracer.SetStepsize(hStart);
+      tracer.SetMaxUpdates(maxUpdates);
       tracer.SetFullGraph(fullGraph);
       tracer.SetDecimals(decimals);
-      tracer.Estimate(start, frequencies, std::cout, maxLambda, 1.0);
+      if (verbose) {
+	tracer.SetStepRecord(&steps);
+      }
+      if (frequencies.size() == 1) {
+	tracer.Estimate(start, frequencies[1], std::cout, maxLambda, 1.0);
+      }
+      else {
+	tracer.EstimateBatch(start, frequencies, std::cout, maxLambda, 1.0);
+      }
+      if (verbose) {
+	PrintStepRecord(std::cerr, steps);
+      }
       return 0;
     }
 
@@ -197,8 +266,13 @@ int main(int argc, char *argv[])
       StrategicQREPathTracer tracer;
       tracer.SetMaxDecel(maxDecel);
       tracer.SetStepsize(hStart);
+      tracer.SetMaxUpdates(maxUpdates);
+      tracer.SetCacheDirectory(cacheDirectory);
       tracer.SetFullGraph(fullGraph);
       tracer.SetDecimals(decimals);
+      if (verbose) {
+	tracer.SetStepRecord(&steps);
+      }
       if (targetLambda > 0.0) {
 	tracer.SolveAtLambda(start, std::cout, targetLambda, 1.0);
       }
@@ -211,10 +285,18 @@ int main(int argc, char *argv[])
       AgentQREPathTracer tracer;
       tracer.SetMaxDecel(maxDecel);
       tracer.SetStepsize(hStart);
+      tracer.SetMaxUpdates(maxUpdates);
+      tracer.SetCacheDirectory(cacheDirectory);
       tracer.SetFullGraph(fullGraph);
       tracer.SetDecimals(decimals);
+      if (verbose) {
+	tracer.SetStepRecord(&steps);
+      }
       tracer.TraceAgentPath(start, std::cout, maxLambda, 1.0, targetLambda);
     }
+    if (verbose) {
+      PrintStepRecord(std::cerr, steps);
+    }
     return 0;
   }
   catch (std::runtime_error &e) {
@@ -24,6 +24,7 @@
 #include <cmath>
 #include <iostream>
 #include <fstream>
+#include <vector>
 
 #include <gambit/gambit.h>
 #include "nfglogit.h"
@@ -36,7 +37,7 @@ namespace Gambit {
 
 class StrategicQREPathTracer::EquationSystem : public PathTracer::EquationSystem {
 public:
-  EquationSystem(const Game &p_game) : m_game(p_game) { }
+  EquationSystem(const Game &p_game);
   virtual ~EquationSystem() { }
   // Compute the value of the system of equations at the specified point.
   virtual void GetValue(const Vector<double> &p_point,
@@ -47,125 +48,131 @@ public:
 
 private:
   Game m_game;
+  // The profile at the last point evaluated.  This is reused from call
+  // to call, so that the strategy values and payoff Jacobian it caches
+  // are computed only once when the value and Jacobian of the system
+  // are both needed at the same point.
+  mutable MixedStrategyProfile<double> m_profile;
+  // For each strategy, in profile order, the indices of the first and
+  // last strategies of the same player
+  Array<int> m_first, m_last;
+
+  void SetPoint(const Vector<double> &p_point) const;
 };
 
+StrategicQREPathTracer::EquationSystem::EquationSystem(const Game &p_game)
+  : m_game(p_game), m_profile(p_game->NewMixedStrategyProfile(0.0)),
+    m_first(m_profile.MixedProfileLength()),
+    m_last(m_profile.MixedProfileLength())
+{
+  for (int index = 1, pl = 1; pl <= m_game->NumPlayers(); pl++) {
+    int first = index;
+    int last = first + m_game->GetPlayer(pl)->NumStrategies() - 1;
+    for (; index <= last; index++) {
+      m_first[index] = first;
+      m_last[index] = last;
+    }
+  }
+}
+
+void
+StrategicQREPathTracer::EquationSystem::SetPoint(const Vector<double> &p_point) const
+{
+  for (int i = 1; i <= m_profile.MixedProfileLength(); i++) {
+    m_profile[i] = exp(p_point[i]);
+  }
+}
+
+//
+// The rows of the system are indexed as the strategies of the profile.
+// The row of each player's first strategy is a sum-to-one equation;
+// the others equate the log ratio of the strategy's probability to that
+// of the first strategy with lambda times the difference in their values.
+//
 void 
 StrategicQREPathTracer::EquationSystem::GetValue(const Vector<double> &p_point,
 						 Vector<double> &p_lhs) const
 {
-  MixedStrategyProfile<double> profile(m_game->NewMixedStrategyProfile(0.0)), logprofile(m_game->NewMixedStrategyProfile(0.0));
-  for (int i = 1; i <= profile.MixedProfileLength(); i++) {
-    profile[i] = exp(p_point[i]);
-    logprofile[i] = p_point[i];
-  }
+  SetPoint(p_point);
   double lambda = p_point[p_point.Length()];
-  p_lhs = 0.0;
-  for (int rowno = 0, pl = 1; pl <= m_game->NumPlayers(); pl++) {
-    GamePlayer player = m_game->Players()[pl];
-    for (size_t st = 1; st <= player->Strategies().size(); st++) {
-      rowno++;
-      if (st == 1) {
-	// This is a sum-to-one equation
-	p_lhs[rowno] = -1.0;
-	for (size_t j = 1; j <= player->Strategies().size(); j++) {
-	  p_lhs[rowno] += profile[player->GetStrategy(j)];
-	}
-      }
-      else {
-	// This is a ratio equation
-	p_lhs[rowno] = (logprofile[player->GetStrategy(st)] - 
-			logprofile[player->GetStrategy(1)] -
-			lambda * (profile.GetPayoff(player->GetStrategy(st)) -
-				  profile.GetPayoff(player->GetStrategy(1))));
-
+  const Vector<double> &values = m_profile.GetStrategyValues();
+  for (int row = 1; row <= m_profile.MixedProfileLength(); row++) {
+    int first = m_first[row];
+    if (row == first) {
+      // This is a sum-to-one equation
+      p_lhs[row] = -1.0;
+      for (int j = first; j <= m_last[row]; j++) {
+	p_lhs[row] += m_profile[j];
       }
     }
+    else {
+      // This is a ratio equation
+      p_lhs[row] = (p_point[row] - p_point[first] -
+		    lambda * (values[row] - values[first]));
+    }
   }
 }
 
+//
+// The matrix is the transpose of the Jacobian, with one column for
+// each equation.  Each entry is written exactly once; the derivatives
+// of an equation with respect to its own player's strategies are
+// constants, and only those with respect to the other players'
+// strategies are computed, from the payoff Jacobian of the profile.
+//
 void
 StrategicQREPathTracer::EquationSystem::GetJacobian(const Vector<double> &p_point,
 						    Matrix<double> &p_matrix) const
 {
-  MixedStrategyProfile<double> profile(m_game->NewMixedStrategyProfile(0.0)), logprofile(m_game->NewMixedStrategyProfile(0.0));
-  for (int i = 1; i <= profile.MixedProfileLength(); i++) {
-    profile[i] = exp(p_point[i]);
-    logprofile[i] = p_point[i];
-  }
+  SetPoint(p_point);
   double lambda = p_point[p_point.Length()];
-
-  p_matrix = 0.0;
-
-  for (int rowno = 0, i = 1; i <= m_game->NumPlayers(); i++) {
-    GamePlayer player = m_game->Players()[i];
-    for (size_t j = 1; j <= player->Strategies().size(); j++) {
-      rowno++;
-      if (j == 1) {
-	// This is a sum-to-one equation
-	for (int colno = 0, ell = 1; ell <= m_game->NumPlayers(); ell++) {
-	  GamePlayer player2 = m_game->Players()[ell];
-	  for (size_t m = 1; m <= player2->Strategies().size(); m++) {
-	    colno++;
-	    if (i == ell) {
-	      p_matrix(colno, rowno) = profile[player2->GetStrategy(m)];
-	    }
-	    // Otherwise, entry is zero
-	  }
-	}
-	// The last column is derivative wrt lamba, which is zero
+  // The profile is on the full game, so these are indexed as the rows are
+  const Matrix<double> &jacobian = m_profile.GetPayoffJacobian();
+  const Vector<double> &values = m_profile.GetStrategyValues();
+
+  int length = m_profile.MixedProfileLength();
+  for (int rowno = 1; rowno <= length; rowno++) {
+    int first = m_first[rowno], last = m_last[rowno];
+    if (rowno == first) {
+      // This is a sum-to-one equation, which depends only on the
+      // player's own strategies
+      for (int colno = 1; colno < first; colno++) {
+	p_matrix(colno, rowno) = 0.0;
+      }
+      for (int colno = first; colno <= last; colno++) {
+	p_matrix(colno, rowno) = m_profile[colno];
       }
-      else {
-	// This is a ratio equation
-	for (int colno = 0, ell = 1; ell <= m_game->NumPlayers(); ell++) {
-	  GamePlayer player2 = m_game->Players()[ell];
-  	  for (size_t m = 1; m <= player2->Strategies().size(); m++) {
-	    colno++;
-	    if (i == ell) {
-	      if (m == 1) {
-		p_matrix(colno, rowno) = -1.0;
-	      }
-	      else if (m == j) {
-		p_matrix(colno, rowno) = 1.0;
-	      }
-	      // Entry is zero for all other strategy pairs
-	    }
-	    else {
-	      p_matrix(colno, rowno) =
-		-lambda * profile[player2->GetStrategy(m)] *
-		(profile.GetPayoffDeriv(i, 
-					player->GetStrategy(j),
-					player2->GetStrategy(m)) -
-		 profile.GetPayoffDeriv(i, 
-					player->GetStrategy(1),
-					player2->GetStrategy(m)));
-	    }
-	  }
+      for (int colno = last + 1; colno <= length; colno++) {
+	p_matrix(colno, rowno) = 0.0;
+      }
+      // The last column is derivative wrt lamba, which is zero
+      p_matrix(length + 1, rowno) = 0.0;
+    }
+    else {
+      // This is a ratio equation
+      for (int colno = 1; colno <= length; colno++) {
+	if (colno < first || colno > last) {
+	  p_matrix(colno, rowno) =
+	    -lambda * m_profile[colno] *
+	    (jacobian(rowno, colno) - jacobian(first, colno));
+	}
+	else if (colno == first) {
+	  p_matrix(colno, rowno) = -1.0;
+	}
+	else if (colno == rowno) {
+	  p_matrix(colno, rowno) = 1.0;
+	}
+	else {
+	  // Entry is zero for all other strategy pairs
+	  p_matrix(colno, rowno) = 0.0;
 	}
-	// Fill the last column, the derivative wrt lambda
-	p_matrix(p_matrix.NumRows(), rowno) =
-	  (profile.GetPayoff(player->GetStrategy(1)) - 
-	   profile.GetPayoff(player->GetStrategy(j)));
       }
+      // Fill the last column, the derivative wrt lambda
+      p_matrix(length + 1, rowno) = values[first] - values[rowno];
     }
   }
 }
 
-//----------------------------------------------------------------------------
-//               StrategicQREPathTracer: Criterion function
-//----------------------------------------------------------------------------
-
-class StrategicQREPathTracer::LambdaCriterion : public PathTracer::CriterionFunction {
-public:
-  LambdaCriterion(double p_lambda) : m_lambda(p_lambda) { }
-
-  virtual double operator()(const Vector<double> &p_point,
-			    const Vector<double> &p_tangent) const
-  { return p_point[p_point.Length()] - m_lambda; }
-
-private:
-  double m_lambda;
-};
-
 //----------------------------------------------------------------------------
 //               StrategicQREPathTracer: Callback function
 //----------------------------------------------------------------------------
@@ -233,8 +240,9 @@ StrategicQREPathTracer::TraceStrategicPath(const LogitQREMixedStrategyProfile &p
   }
   x[x.Length()] = p_start.GetLambda();
   CallbackFunction func(p_stream, p_start.GetGame(), m_fullGraph, m_decimals);
-  TracePath(EquationSystem(p_start.GetGame()),
-	    x, p_maxLambda, p_omega, func);
+  TraceCachedPath(EquationSystem(p_start.GetGame()),
+		  GetCacheKey(p_start.GetGame(), "strategic"),
+		  x, p_maxLambda, p_omega, func);
   return func.GetProfiles();
 }
 
@@ -249,10 +257,18 @@ StrategicQREPathTracer::SolveAtLambda(const LogitQREMixedStrategyProfile &p_star
   }
   x[x.Length()] = p_start.GetLambda();
   CallbackFunction func(p_stream, p_start.GetGame(), m_fullGraph, m_decimals);
-  TracePath(EquationSystem(p_start.GetGame()),
-	    x, std::max(1.0, 3.0*p_targetLambda), p_omega,
-	    func,
-	    LambdaCriterion(p_targetLambda));
+  SolveCachedAtLambda(EquationSystem(p_start.GetGame()),
+		      GetCacheKey(p_start.GetGame(), "strategic"),
+		      x, p_targetLambda, std::max(1.0, 3.0*p_targetLambda),
+		      p_omega, func);
+  if (func.GetProfiles().size() == 0) {
+    // No points are recorded when only the terminal one is reported
+    MixedStrategyProfile<double> profile(p_start.GetGame()->NewMixedStrategyProfile(0.0));
+    for (int i = 1; i < x.Length(); i++) {
+      profile[i] = exp(x[i]);
+    }
+    return LogitQREMixedStrategyProfile(profile, x[x.Length()]);
+  }
   return func.GetProfiles().back();
 }
 
@@ -423,4 +439,151 @@ StrategicQREEstimator::Estimate(const LogitQREMixedStrategyProfile &p_start,
   return callback.GetMaximizer();
 }
 
+//----------------------------------------------------------------------------
+//          StrategicQREEstimator: Estimation from many data sets
+//----------------------------------------------------------------------------
+
+//
+// Records the points of the branch, with their tangents in the direction
+// of travel, as it is traced.
+//
+class StrategicQREEstimator::BranchCallbackFunction
+  : public PathTracer::CallbackFunction {
+public:
+  virtual ~BranchCallbackFunction() { }
+
+  virtual void operator()(const Vector<double> &, bool) const { }
+  virtual void operator()(const Vector<double> &p_point,
+			  const Vector<double> &p_tangent,
+			  bool p_isTerminal) const
+  {
+    // The terminal point repeats the last accepted one
+    if (!p_isTerminal) {
+      m_points.push_back(p_point);
+      m_tangents.push_back(p_tangent);
+    }
+  }
+
+  mutable std::vector<Vector<double> > m_points, m_tangents;
+};
+
+//
+// Keeps the point of highest likelihood among those visited, without
+// reporting the points themselves.
+//
+class StrategicQREEstimator::MaximizerCallbackFunction
+  : public PathTracer::CallbackFunction {
+public:
+  MaximizerCallbackFunction(const Game &p_game,
+			    const Vector<double> &p_frequencies)
+    : m_frequencies(p_frequencies),
+      m_bestProfile(p_game->NewMixedStrategyProfile(0.0)),
+      m_profile(p_game->NewMixedStrategyProfile(0.0)),
+      m_bestLambda(0.0),
+      m_maxlogL(LogLike(p_frequencies, m_bestProfile))
+  { }
+  virtual ~MaximizerCallbackFunction() { }
+
+  virtual void operator()(const Vector<double> &x, bool) const
+  {
+    for (int i = 1; i < x.Length(); i++) {
+      m_profile[i] = exp(x[i]);
+    }
+    double logL = LogLike(m_frequencies, m_profile);
+    if (logL > m_maxlogL) {
+      m_maxlogL = logL;
+      m_bestLambda = x[x.Length()];
+      m_bestProfile = m_profile;
+    }
+  }
+
+  const Vector<double> &m_frequencies;
+  mutable MixedStrategyProfile<double> m_bestProfile, m_profile;
+  mutable double m_bestLambda;
+  mutable double m_maxlogL;
+};
+
+//
+// The branch does not depend on the data, so it is traced once, and its
+// points and tangents kept.  The derivative of the log-likelihood along
+// the branch is the criterion function evaluated at a tangent; for each
+// data set, wherever it changes from positive to negative between two
+// successive points, the branch is traced again from the first of them,
+// with the step which reached the second, to locate the maximum.
+//
+List<LogitQREMixedStrategyProfile>
+StrategicQREEstimator::EstimateBatch(const LogitQREMixedStrategyProfile &p_start,
+				     const List<MixedStrategyProfile<double> > &p_frequencies,
+				     std::ostream &p_stream,
+				     double p_maxLambda, double p_omega)
+{
+  for (size_t d = 1; d <= p_frequencies.size(); d++) {
+    if (p_start.GetGame() != p_frequencies[d].GetGame()) {
+      throw MismatchException();
+    }
+  }
+
+  Vector<double> x(p_start.MixedProfileLength() + 1);
+  for (int i = 1; i <= p_start.MixedProfileLength(); i++) {
+    x[i] = log(p_start[i]);
+  }
+  x[x.Length()] = p_start.GetLambda();
+
+  EquationSystem system(p_start.GetGame());
+  BranchCallbackFunction branch;
+  double omega = p_omega;
+  TracePath(system, x, p_maxLambda, omega, branch);
+  const std::vector<Vector<double> > &points = branch.m_points;
+  const std::vector<Vector<double> > &tangents = branch.m_tangents;
+  int lambda = x.Length();
+
+  double hStart = GetStepsize();
+  List<LogitQREMixedStrategyProfile> estimates;
+  for (size_t d = 1; d <= p_frequencies.size(); d++) {
+    const Vector<double> &frequencies = p_frequencies[d];
+    CriterionFunction criterion(frequencies);
+    MaximizerCallbackFunction callback(p_start.GetGame(), frequencies);
+    for (size_t k = 0; k < points.size(); k++) {
+      callback(points[k], false);
+    }
+
+    for (size_t k = 0; k + 1 < points.size(); k++) {
+      if (criterion(points[k], tangents[k]) <= 0.0 ||
+	  criterion(points[k+1], tangents[k+1]) > 0.0) {
+	continue;
+      }
+      // Allow the retracing to run a step beyond the bracketing points
+      double maxLambda = p_maxLambda;
+      if (k + 2 < points.size()) {
+	maxLambda = std::min(p_maxLambda,
+			     std::max(points[k+2][lambda],
+				      std::max(points[k][lambda],
+					       points[k+1][lambda])));
+      }
+      Vector<double> y(points[k]);
+      double omega = p_omega;
+      SetStepsize(std::sqrt((points[k+1] - points[k]).NormSquared()));
+      TracePath(system, y, maxLambda, omega, callback, criterion,
+		&tangents[k]);
+    }
+    SetStepsize(hStart);
+
+    p_stream.setf(std::ios::fixed);
+    // By convention, we output lambda first
+    p_stream << std::setprecision(m_decimals) << callback.m_bestLambda;
+    p_stream.unsetf(std::ios::fixed);
+    for (int i = 1; i <= callback.m_bestProfile.MixedProfileLength(); i++) {
+      p_stream << "," << std::setprecision(m_decimals) 
+	       << callback.m_bestProfile[i];
+    }
+    p_stream.setf(std::ios::fixed);
+    p_stream << "," << std::setprecision(m_decimals) << callback.m_maxlogL;
+    p_stream.unsetf(std::ios::fixed);
+    p_stream << std::endl;
+    estimates.push_back(LogitQREMixedStrategyProfile(callback.m_bestProfile,
+						     callback.m_bestLambda));
+  }
+  return estimates;
+}
+
 }   // end namespace Gambit
@@ -83,7 +83,6 @@ protected:
   int m_decimals;
 
   class EquationSystem;
-  class LambdaCriterion;
   class CallbackFunction;
 };
 
@@ -98,10 +97,19 @@ public:
            const MixedStrategyProfile<double> &p_frequencies,
 	   std::ostream &p_logStream,
 	   double p_maxLambda, double p_omega);
+  // Estimate from each of a list of data sets, tracing the branch once.
+  // Only the maximizer for each data set is written to the stream.
+  List<LogitQREMixedStrategyProfile>
+  EstimateBatch(const LogitQREMixedStrategyProfile &p_start,
+		const List<MixedStrategyProfile<double> > &p_frequencies,
+		std::ostream &p_logStream,
+		double p_maxLambda, double p_omega);
   
 protected:
   class CriterionFunction;
   class CallbackFunction;
+  class BranchCallbackFunction;
+  class MaximizerCallbackFunction;
 };
 
 }  // end namespace Gambit
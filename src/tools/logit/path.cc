@@ -21,8 +21,14 @@
 //
 
 #include <cmath>
+#include <cstdio>      // for std::rename, std::remove
 #include <algorithm>   // for std::max
+#include <vector>
 #include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <unistd.h>    // for getpid
 
 #include <gambit/gambit.h>
 #include <gambit/sqmatrix.h>
@@ -38,72 +44,327 @@ namespace {
   
 inline double sqr(double x) { return x*x; }
 
-void Givens(Matrix<double> &b, Matrix<double> &q,
-            double &c1, double &c2, int l1, int l2, int l3)
+//
+// A plane rotation acting on two adjacent coordinates i and i+1
+//
+struct Rotation {
+  int row;
+  double c, s;
+};
+
+//
+// Computes the rotation taking (x1, x2) to (r, 0), with r >= 0.
+// Returns false if both are zero, in which case no rotation is needed.
+//
+bool MakeRotation(double x1, double x2, double &c, double &s)
 {
-  if (fabs(c1) + fabs(c2) == 0.0) {
-    return;
+  if (fabs(x1) + fabs(x2) == 0.0) {
+    return false;
   }
-
-  double sn;
-  if (fabs(c2) >= fabs(c1)) {
-    sn = std::sqrt(1.0 + sqr(c1/c2)) * fabs(c2);
+  double r;
+  if (fabs(x2) >= fabs(x1)) {
+    r = std::sqrt(1.0 + sqr(x1/x2)) * fabs(x2);
   }
   else {
-    sn = std::sqrt(1.0 + sqr(c2/c1)) * fabs(c1);
+    r = std::sqrt(1.0 + sqr(x2/x1)) * fabs(x1);
   }
-  double s1 = c1/sn;
-  double s2 = c2/sn;
+  c = x1 / r;
+  s = x2 / r;
+  return true;
+}
+
+//
+// A QR factorization b = QR of the n x (n-1) transposed Jacobian of
+// a system of equations, as used by the predictor-corrector steps.
+//
+// The factorization is computed by Givens rotations, which unlike
+// Householder reflections remain accurate when the rows of the matrix
+// differ in scale by many orders of magnitude, as they do far along a
+// branch.  The matrix is stored by columns.  Each column is reduced by
+// rotating each of the rows below the diagonal into the diagonal one,
+// skipping those which are already zero; the trailing columns are
+// processed in panels, each column having the rotations of a whole
+// panel applied to it while it is in cache.  Q is held implicitly, as
+// the rotations of the factorization followed by those introduced by
+// any rank-one updates since factoring.
+//
+class QRFactorization {
+public:
+  QRFactorization(int p_rows);
+
+  /// Factors the matrix
+  void Factor(const Matrix<double> &p_matrix);
+  /// Updates the factorization to that of b + (s r^T) / (s^T s), where
+  /// r = p_value - b^T s.  This is Broyden's secant update of the
+  /// Jacobian, for a step s over which the system changed by p_value.
+  void Update(const Vector<double> &p_step, const Vector<double> &p_value);
+
+  /// Returns the tangent to the curve, oriented so that the determinant
+  /// of the matrix augmented by the tangent is positive
+  void GetTangent(Vector<double> &p_tangent) const;
+  /// Takes a Newton step from u, the system having value y at u.
+  /// The length of the step is returned in d.
+  void NewtonStep(Vector<double> &u, const Vector<double> &y,
+		  double &d) const;
+
+private:
+  static const int c_panel = 32;   // number of columns in a panel
 
-  for (int k = 1; k <= q.NumColumns(); k++) {
-    double sv1 = q(l1, k);
-    double sv2 = q(l2, k);
-    q(l1, k) = s1 * sv1 + s2 * sv2;
-    q(l2, k) = -s2 * sv1 + s1 * sv2;
+  int m_rows, m_cols;
+  // The rotation of row i into row k when reducing column k is stored
+  // at k * m_rows + i; s is zero for rows which were not rotated.
+  std::vector<double> m_c, m_s;
+  // R, by columns
+  std::vector<double> m_r;
+  std::vector<Rotation> m_rotations;
+  mutable std::vector<double> m_work, m_work2;
+
+  // Applies the rotations reducing column k to x
+  void ApplyColumnRotations(int k, double *x) const;
+  // Applies the rotations reducing column k to columns j..j+3 of R,
+  // which interleaves the otherwise sequential updates of each
+  void ApplyColumnRotations4(int k, int j);
+  // Computes Q^T x in place
+  void ApplyQTranspose(double *x) const;
+  // Computes Q x in place
+  void ApplyQ(double *x) const;
+  // Applies the rotation to rows of R, from column p_first on
+  void Rotate(const Rotation &p_rotation, int p_first);
+};
+
+QRFactorization::QRFactorization(int p_rows)
+  : m_rows(p_rows), m_cols(p_rows - 1),
+    m_c(p_rows * (p_rows - 1)), m_s(p_rows * (p_rows - 1)),
+    m_r(p_rows * (p_rows - 1)),
+    m_work(p_rows), m_work2(p_rows)
+{ }
+
+inline void QRFactorization::ApplyColumnRotations(int k, double *x) const
+{
+  const double *c = &m_c[k * m_rows], *s = &m_s[k * m_rows];
+  for (int i = k + 1; i < m_rows; i++) {
+    if (s[i] != 0.0) {
+      double x1 = x[k], x2 = x[i];
+      x[k] = c[i] * x1 + s[i] * x2;
+      x[i] = -s[i] * x1 + c[i] * x2;
+    }
+  }
+}
+
+void QRFactorization::ApplyColumnRotations4(int k, int j)
+{
+  const double *c = &m_c[k * m_rows], *s = &m_s[k * m_rows];
+  double *x0 = &m_r[j * m_rows], *x1 = x0 + m_rows;
+  double *x2 = x1 + m_rows, *x3 = x2 + m_rows;
+  double y0 = x0[k], y1 = x1[k], y2 = x2[k], y3 = x3[k];
+  for (int i = k + 1; i < m_rows; i++) {
+    if (s[i] != 0.0) {
+      double t0 = y0, t1 = y1, t2 = y2, t3 = y3;
+      y0 = c[i] * t0 + s[i] * x0[i];
+      y1 = c[i] * t1 + s[i] * x1[i];
+      y2 = c[i] * t2 + s[i] * x2[i];
+      y3 = c[i] * t3 + s[i] * x3[i];
+      x0[i] = -s[i] * t0 + c[i] * x0[i];
+      x1[i] = -s[i] * t1 + c[i] * x1[i];
+      x2[i] = -s[i] * t2 + c[i] * x2[i];
+      x3[i] = -s[i] * t3 + c[i] * x3[i];
+    }
   }
+  x0[k] = y0;
+  x1[k] = y1;
+  x2[k] = y2;
+  x3[k] = y3;
+}
 
-  for (int k = l3; k <= b.NumColumns(); k++) {
-    double sv1 = b(l1, k);
-    double sv2 = b(l2, k);
-    b(l1, k) = s1 * sv1 + s2 * sv2;
-    b(l2, k) = -s2 * sv1 + s1 * sv2;
+void QRFactorization::Factor(const Matrix<double> &p_matrix)
+{
+  for (int j = 0; j < m_cols; j++) {
+    double *col = &m_r[j * m_rows];
+    for (int i = 0; i < m_rows; i++) {
+      col[i] = p_matrix(i + 1, j + 1);
+    }
   }
 
-  c1 = sn;
-  c2 = 0.0;
+  m_rotations.clear();
+  for (int panel = 0; panel < m_cols; panel += c_panel) {
+    int end = std::min(panel + c_panel, m_cols);
+    for (int k = panel; k < end; k++) {
+      double *col = &m_r[k * m_rows];
+      double *c = &m_c[k * m_rows], *s = &m_s[k * m_rows];
+      for (int i = k + 1; i < m_rows; i++) {
+	if (col[i] == 0.0) {
+	  c[i] = 1.0;
+	  s[i] = 0.0;
+	  continue;
+	}
+	MakeRotation(col[k], col[i], c[i], s[i]);
+	col[k] = c[i] * col[k] + s[i] * col[i];
+	col[i] = 0.0;
+      }
+      for (int j = k + 1; j < end; j++) {
+	ApplyColumnRotations(k, &m_r[j * m_rows]);
+      }
+    }
+
+    int j = end;
+    for (; j + 4 <= m_cols; j += 4) {
+      for (int k = panel; k < end; k++) {
+	ApplyColumnRotations4(k, j);
+      }
+    }
+    for (; j < m_cols; j++) {
+      double *col = &m_r[j * m_rows];
+      for (int k = panel; k < end; k++) {
+	ApplyColumnRotations(k, col);
+      }
+    }
+  }
+}
+
+void QRFactorization::ApplyQTranspose(double *x) const
+{
+  // Q^T = G_m ... G_1 F_{n-1} ... F_1, where F_k reduces column k
+  for (int k = 0; k < m_cols; k++) {
+    ApplyColumnRotations(k, x);
+  }
+  for (std::vector<Rotation>::const_iterator rot = m_rotations.begin();
+       rot != m_rotations.end(); ++rot) {
+    double x1 = x[rot->row], x2 = x[rot->row + 1];
+    x[rot->row] = rot->c * x1 + rot->s * x2;
+    x[rot->row + 1] = -rot->s * x1 + rot->c * x2;
+  }
 }
 
-void QRDecomp(Matrix<double> &b, Matrix<double> &q)
+void QRFactorization::ApplyQ(double *x) const
 {
-  q.MakeIdent();
-  for (int m = 1; m <= b.NumColumns(); m++) {
-    for (int k = m + 1; k <= b.NumRows(); k++) {
-      Givens(b, q, b(m, m), b(k, m), m, k, m + 1);
+  // Q = F_1^T ... F_{n-1}^T G_1^T ... G_m^T
+  for (std::vector<Rotation>::const_reverse_iterator rot = m_rotations.rbegin();
+       rot != m_rotations.rend(); ++rot) {
+    double x1 = x[rot->row], x2 = x[rot->row + 1];
+    x[rot->row] = rot->c * x1 - rot->s * x2;
+    x[rot->row + 1] = rot->s * x1 + rot->c * x2;
+  }
+  for (int k = m_cols - 1; k >= 0; k--) {
+    const double *c = &m_c[k * m_rows], *s = &m_s[k * m_rows];
+    for (int i = m_rows - 1; i > k; i--) {
+      if (s[i] != 0.0) {
+	double x1 = x[k], x2 = x[i];
+	x[k] = c[i] * x1 - s[i] * x2;
+	x[i] = s[i] * x1 + c[i] * x2;
+      }
+    }
+  }
+}
+
+void QRFactorization::Rotate(const Rotation &p_rotation, int p_first)
+{
+  int i = p_rotation.row;
+  for (int j = p_first; j < m_cols; j++) {
+    double *col = &m_r[j * m_rows];
+    double x1 = col[i], x2 = col[i + 1];
+    col[i] = p_rotation.c * x1 + p_rotation.s * x2;
+    col[i + 1] = -p_rotation.s * x1 + p_rotation.c * x2;
+  }
+}
+
+void QRFactorization::GetTangent(Vector<double> &p_tangent) const
+{
+  // The tangent is the last column of Q.  Q is a product of rotations,
+  // so the determinant of the augmented matrix has the sign of the
+  // product of the diagonal of R.
+  double *x = &m_work[0];
+  std::fill(m_work.begin(), m_work.end(), 0.0);
+  x[m_rows - 1] = 1.0;
+  ApplyQ(x);
+  bool negative = false;
+  for (int k = 0; k < m_cols; k++) {
+    if (m_r[k * m_rows + k] < 0.0) {
+      negative = !negative;
     }
   }
+  for (int i = 0; i < m_rows; i++) {
+    p_tangent[i + 1] = (negative) ? -x[i] : x[i];
+  }
 }
 
-void NewtonStep(Matrix<double> &q, Matrix<double> &b,
-                Vector<double> &u, Vector<double> &y,
-		double &d)
+void QRFactorization::NewtonStep(Vector<double> &u, const Vector<double> &y,
+				 double &d) const
 {
-  for (int k = 1; k <= b.NumColumns(); k++) {
-    for (int l = 1; l <= k - 1; l++) {
-      y[k] -= b(l, k) * y[l];
+  // Solve R^T z = y by forward substitution; the step is Q (z, 0)
+  double *z = &m_work[0];
+  for (int k = 0; k < m_cols; k++) {
+    const double *col = &m_r[k * m_rows];
+    double s = y[k + 1];
+    for (int l = 0; l < k; l++) {
+      s -= col[l] * z[l];
     }
-    y[k] /= b(k, k);
+    z[k] = s / col[k];
   }
+  z[m_rows - 1] = 0.0;
 
   d = 0.0;
-  for (int k = 1; k <= b.NumRows(); k++) {
+  for (int k = 0; k < m_cols; k++) {
+    d += z[k] * z[k];
+  }
+  d = std::sqrt(d);
+
+  ApplyQ(z);
+  for (int k = 0; k < m_rows; k++) {
+    u[k + 1] -= z[k];
+  }
+}
+
+void QRFactorization::Update(const Vector<double> &p_step,
+			     const Vector<double> &p_value)
+{
+  // w = Q^T s, so that b^T s = R^T w
+  double *w = &m_work[0], *r = &m_work2[0];
+  double norm = 0.0;
+  for (int i = 0; i < m_rows; i++) {
+    w[i] = p_step[i + 1];
+    norm += w[i] * w[i];
+  }
+  if (norm == 0.0) {
+    return;
+  }
+  ApplyQTranspose(w);
+  for (int k = 0; k < m_cols; k++) {
+    const double *col = &m_r[k * m_rows];
     double s = 0.0;
-    for (int l = 1; l <= b.NumColumns(); l++) {
-      s += q(l, k) * y[l];
+    for (int l = 0; l <= k; l++) {
+      s += col[l] * w[l];
+    }
+    r[k] = p_value[k + 1] - s;
+  }
+  for (int i = 0; i < m_rows; i++) {
+    w[i] /= norm;
+  }
+
+  // The update is Q (R + w r^T).  Reduce w to a multiple of the first
+  // unit vector, which makes R upper Hessenberg...
+  Rotation rot;
+  for (int i = m_rows - 2; i >= 0; i--) {
+    if (MakeRotation(w[i], w[i + 1], rot.c, rot.s)) {
+      rot.row = i;
+      w[i] = rot.c * w[i] + rot.s * w[i + 1];
+      w[i + 1] = 0.0;
+      Rotate(rot, i);
+      m_rotations.push_back(rot);
+    }
+  }
+  for (int j = 0; j < m_cols; j++) {
+    m_r[j * m_rows] += w[0] * r[j];
+  }
+  // ...and restore it to triangular form.
+  for (int i = 0; i < m_cols; i++) {
+    double *col = &m_r[i * m_rows];
+    if (MakeRotation(col[i], col[i + 1], rot.c, rot.s)) {
+      rot.row = i;
+      Rotate(rot, i);
+      col[i + 1] = 0.0;
+      m_rotations.push_back(rot);
     }
-    u[k] -= s;
-    d += s * s;
   }
-  d = std::sqrt(d);
 }
 
 }   // end anonymous namespace
@@ -118,7 +379,8 @@ PathTracer::TracePath(const EquationSystem &p_system,
 		      Vector<double> &x,
 		      double p_maxLambda, double &p_omega,
 		      const CallbackFunction &p_callback,
-		      const CriterionFunction &p_criterion) const
+		      const CriterionFunction &p_criterion,
+		      const Vector<double> *p_direction) const
 {
   const double c_tol = 1.0e-4;     // tolerance for corrector iteration
   const double c_maxDist = 0.4;    // maximal distance to curve
@@ -136,12 +398,29 @@ PathTracer::TracePath(const EquationSystem &p_system,
   Vector<double> t(x.Length()), newT(x.Length());
   Vector<double> y(x.Length() - 1);
   Matrix<double> b(x.Length(), x.Length() - 1);
-  SquareMatrix<double> q(x.Length());
+  QRFactorization qr(x.Length());
+  // When updating the Jacobian, the value of the system at x, and the
+  // predictor step and change in value used in the secant update
+  Vector<double> value(x.Length() - 1);
+  Vector<double> step(x.Length()), change(x.Length() - 1);
+  int updates = 0;                 // updates since the last factorization
+  bool refactor = false;           // set to force a factorization
+  std::string *steps = 0;          // the record of this path, if kept
+  if (m_stepRecord) {
+    m_stepRecord->push_back(std::string());
+    steps = &m_stepRecord->back();
+  }
 
-  p_callback(x, false);
   p_system.GetJacobian(x, b);
-  QRDecomp(b, q);
-  q.GetRow(q.NumRows(), t);
+  qr.Factor(b);
+  qr.GetTangent(t);
+  if (p_direction) {
+    p_omega = (t * *p_direction < 0.0) ? -fabs(p_omega) : fabs(p_omega);
+  }
+  p_callback(x, t * p_omega, false);
+  if (m_maxUpdates > 0) {
+    p_system.GetValue(x, value);
+  }
   
   while (x[x.Length()] >= 0.0 && x[x.Length()] < p_maxLambda) {
     bool accept = true;
@@ -160,16 +439,39 @@ PathTracer::TracePath(const EquationSystem &p_system,
     }
 
     double decel = 1.0 / m_maxDecel;  // initialize deceleration factor
-    p_system.GetJacobian(u, b);
-    QRDecomp(b, q);
+    bool updated = false;
+    // The zero-finding steps rely on accurate tangents, so the Jacobian
+    // is always computed for them
+    if (refactor || newton || updates >= m_maxUpdates) {
+      p_system.GetJacobian(u, b);
+      qr.Factor(b);
+      updates = 0;
+      refactor = false;
+    }
+    else {
+      // Broyden update of the Jacobian over the predictor step, which
+      // also gives the value for the first corrector iteration
+      p_system.GetValue(u, y);
+      for (int k = 1; k <= x.Length(); k++) {
+	step[k] = u[k] - x[k];
+      }
+      for (int k = 1; k <= y.Length(); k++) {
+	change[k] = y[k] - value[k];
+      }
+      qr.Update(step, change);
+      updates++;
+      updated = true;
+    }
 
     int iter = 1;
     double disto = 0.0;
     while (true) {
       double dist;
 
-      p_system.GetValue(u, y);
-      NewtonStep(q, b, u, y, dist); 
+      if (!updated || iter > 1) {
+	p_system.GetValue(u, y);
+      }
+      qr.NewtonStep(u, y, dist);
 
       if (dist >= c_maxDist) {
 	accept = false;
@@ -193,7 +495,14 @@ PathTracer::TracePath(const EquationSystem &p_system,
       disto = dist;
       iter++;
       if (iter > c_maxIter) {
-	p_callback(x, true);
+	if (updated) {
+	  accept = false;
+	  break;
+	}
+	if (steps) {
+	  *steps += 'f';
+	}
+	p_callback(x, t * p_omega, true);
 	if (newton) {
 	  // Restore the place to restart if desired
 	  x = restart;
@@ -202,10 +511,18 @@ PathTracer::TracePath(const EquationSystem &p_system,
       }
     }
 
+    if (steps) {
+      *steps += (updated) ? (accept ? 'U' : 'u') : (accept ? 'F' : 'f');
+    }
     if (!accept) {
+      if (updated) {
+	// Retry the step with the Jacobian computed afresh
+	refactor = true;
+	continue;
+      }
       h /= m_maxDecel;   // PC not accepted; change stepsize and retry
       if (fabs(h) <= c_hmin) {
-	p_callback(x, true);
+	p_callback(x, t * p_omega, true);
 	if (newton) {
 	  // Restore the place to restart if desired
 	  x = restart;
@@ -222,7 +539,7 @@ PathTracer::TracePath(const EquationSystem &p_system,
     }
 
     // Obtain the tangent at the next step
-    q.GetRow(q.NumRows(), newT); 
+    qr.GetTangent(newT);
 
     // If we are at a bifurcation point, the orientation of the tangent
     // will flip.  This will confuse many criterion functions, especially
@@ -247,7 +564,9 @@ PathTracer::TracePath(const EquationSystem &p_system,
 
     // PC step was successful; update and iterate
     x = u;
-    p_callback(x, false);
+    if (m_maxUpdates > 0) {
+      p_system.GetValue(x, value);
+    }
 
     if (t * newT < 0.0) {
       // Bifurcation detected; for now, just "jump over" and continue,
@@ -256,12 +575,461 @@ PathTracer::TracePath(const EquationSystem &p_system,
       p_omega = -p_omega;
     }
     t = newT;
+    p_callback(x, t * p_omega, false);
   }
 
-  p_callback(x, true);
+  p_callback(x, t * p_omega, true);
   if (newton) {
     x = restart;
   }
 }
 
+//----------------------------------------------------------------------------
+//                  PathTracer: Branches kept between runs
+//----------------------------------------------------------------------------
+
+//
+// A traced branch as kept in the cache: the points accepted by the
+// tracer with their tangents in the direction of travel, and the
+// distance along the branch to each, measured along the chords.
+//
+// The file is a header of the magic string, the key, the length of the
+// points, the number of points and the lambda towards which the branch
+// was traced, followed by the point, tangent and distance for each
+// point, all in the binary representation of the machine.
+//
+class CachedBranch {
+public:
+  CachedBranch(void) : m_maxLambda(0.0) { }
+
+  // Reads the branch from the file, returning false if it does not
+  // exist or does not hold a branch with the given key and length
+  bool Read(const std::string &p_filename, const std::string &p_key,
+	    int p_length);
+  // Writes the branch to the file, replacing any existing one
+  void Write(const std::string &p_filename, const std::string &p_key) const;
+
+  int NumPoints(void) const { return m_points.size(); }
+  void Append(const Vector<double> &p_point, const Vector<double> &p_tangent);
+  // Returns the index of the first point with lambda at least p_lambda,
+  // or -1 if there is none
+  int Find(double p_lambda) const;
+  // Interpolates a point at p_lambda between points k-1 and k, with its
+  // tangent, by a cubic Hermite curve in the distance along the branch
+  void Interpolate(int k, double p_lambda,
+		   Vector<double> &p_point, Vector<double> &p_tangent) const;
+  // Returns true if the branch was traced towards at least p_lambda
+  bool Covers(double p_lambda) const
+  { return Find(p_lambda) >= 0 || p_lambda <= m_maxLambda; }
+
+  std::vector<Vector<double> > m_points, m_tangents;
+  std::vector<double> m_distances;
+  double m_maxLambda;
+};
+
+namespace {
+
+const char c_cacheMagic[8] = { 'G', 'B', 'T', 'Q', 'R', 'E', '0', '1' };
+
+template <class T> void WriteBinary(std::ostream &p_stream, const T &p_value)
+{
+  p_stream.write(reinterpret_cast<const char *>(&p_value), sizeof(T));
+}
+
+template <class T> bool ReadBinary(std::istream &p_stream, T &p_value)
+{
+  p_stream.read(reinterpret_cast<char *>(&p_value), sizeof(T));
+  return !p_stream.fail();
+}
+
+}  // end anonymous namespace
+
+bool CachedBranch::Read(const std::string &p_filename,
+			const std::string &p_key, int p_length)
+{
+  std::ifstream file(p_filename.c_str(), std::ios::in | std::ios::binary);
+  if (!file.is_open()) {
+    return false;
+  }
+  char magic[sizeof(c_cacheMagic)];
+  std::string key(p_key.length(), ' ');
+  file.read(magic, sizeof(magic));
+  file.read(&key[0], key.length());
+  int length, count;
+  if (!file || !std::equal(magic, magic + sizeof(magic), c_cacheMagic) ||
+      key != p_key ||
+      !ReadBinary(file, length) || length != p_length ||
+      !ReadBinary(file, count) || count < 1 ||
+      !ReadBinary(file, m_maxLambda)) {
+    return false;
+  }
+
+  m_points.clear();
+  m_tangents.clear();
+  m_distances.clear();
+  Vector<double> point(length), tangent(length);
+  for (int k = 0; k < count; k++) {
+    for (int i = 1; i <= length; i++) {
+      ReadBinary(file, point[i]);
+    }
+    for (int i = 1; i <= length; i++) {
+      ReadBinary(file, tangent[i]);
+    }
+    double distance;
+    if (!ReadBinary(file, distance)) {
+      return false;
+    }
+    m_points.push_back(point);
+    m_tangents.push_back(tangent);
+    m_distances.push_back(distance);
+  }
+  // A file with data beyond the points it declares is not one we wrote
+  return (file.peek() == std::ifstream::traits_type::eof());
+}
+
+void CachedBranch::Write(const std::string &p_filename,
+			 const std::string &p_key) const
+{
+  // Write to a temporary file, and then move it into place, so that
+  // other processes reading the cache never see part of a file.  The
+  // name is unique to this write, as other processes may be writing the
+  // same branch at once.
+  static int s_writes = 0;
+  std::ostringstream name;
+  name << p_filename << '.' << getpid() << '.' << s_writes++ << ".tmp";
+  std::string temporary = name.str();
+  {
+    std::ofstream file(temporary.c_str(), std::ios::out | std::ios::binary);
+    if (!file.is_open()) {
+      // The cache is an optimization; failing to write to it is not an error
+      return;
+    }
+    int length = m_points.front().Length(), count = m_points.size();
+    file.write(c_cacheMagic, sizeof(c_cacheMagic));
+    file.write(p_key.c_str(), p_key.length());
+    WriteBinary(file, length);
+    WriteBinary(file, count);
+    WriteBinary(file, m_maxLambda);
+    for (int k = 0; k < count; k++) {
+      for (int i = 1; i <= length; i++) {
+	WriteBinary(file, m_points[k][i]);
+      }
+      for (int i = 1; i <= length; i++) {
+	WriteBinary(file, m_tangents[k][i]);
+      }
+      WriteBinary(file, m_distances[k]);
+    }
+    if (!file) {
+      file.close();
+      std::remove(temporary.c_str());
+      return;
+    }
+  }
+  if (std::rename(temporary.c_str(), p_filename.c_str()) != 0) {
+    // Some platforms do not replace an existing file on renaming
+    std::remove(p_filename.c_str());
+    if (std::rename(temporary.c_str(), p_filename.c_str()) != 0) {
+      std::remove(temporary.c_str());
+    }
+  }
+}
+
+void CachedBranch::Append(const Vector<double> &p_point,
+			  const Vector<double> &p_tangent)
+{
+  double distance = 0.0;
+  if (!m_points.empty()) {
+    distance = (m_distances.back() +
+		std::sqrt((p_point - m_points.back()).NormSquared()));
+  }
+  m_points.push_back(p_point);
+  m_tangents.push_back(p_tangent);
+  m_distances.push_back(distance);
+}
+
+int CachedBranch::Find(double p_lambda) const
+{
+  for (size_t k = 0; k < m_points.size(); k++) {
+    const Vector<double> &point = m_points[k];
+    if (point[point.Length()] >= p_lambda) {
+      return k;
+    }
+  }
+  return -1;
+}
+
+void CachedBranch::Interpolate(int k, double p_lambda,
+			       Vector<double> &p_point,
+			       Vector<double> &p_tangent) const
+{
+  const Vector<double> &x0 = m_points[k-1], &x1 = m_points[k];
+  const Vector<double> &t0 = m_tangents[k-1], &t1 = m_tangents[k];
+  double ds = m_distances[k] - m_distances[k-1];
+  int n = x0.Length();
+
+  // Bisect on the position along the segment for lambda, which is less
+  // than p_lambda at the start and not less at the end
+  double lo = 0.0, hi = 1.0;
+  for (int iter = 0; iter < 60; iter++) {
+    double tau = 0.5 * (lo + hi);
+    double h00 = (1.0 + 2.0 * tau) * (1.0 - tau) * (1.0 - tau);
+    double h10 = tau * (1.0 - tau) * (1.0 - tau);
+    double h01 = tau * tau * (3.0 - 2.0 * tau);
+    double h11 = tau * tau * (tau - 1.0);
+    double lambda = (h00 * x0[n] + h10 * ds * t0[n] +
+		     h01 * x1[n] + h11 * ds * t1[n]);
+    if (lambda < p_lambda) {
+      lo = tau;
+    }
+    else {
+      hi = tau;
+    }
+  }
+
+  double tau = hi;
+  double h00 = (1.0 + 2.0 * tau) * (1.0 - tau) * (1.0 - tau);
+  double h10 = tau * (1.0 - tau) * (1.0 - tau);
+  double h01 = tau * tau * (3.0 - 2.0 * tau);
+  double h11 = tau * tau * (tau - 1.0);
+  for (int i = 1; i <= n; i++) {
+    p_point[i] = (h00 * x0[i] + h10 * ds * t0[i] +
+		  h01 * x1[i] + h11 * ds * t1[i]);
+    p_tangent[i] = (1.0 - tau) * t0[i] + tau * t1[i];
+  }
+  p_point[n] = p_lambda;
+  double norm = std::sqrt(p_tangent.NormSquared());
+  if (norm > 0.0) {
+    p_tangent *= 1.0 / norm;
+  }
+}
+
+namespace {
+
+//
+// Refines p_x to a zero of the system by Newton's method, holding lambda
+// fixed.  Returns false if the iteration fails to converge.
+//
+bool Polish(const PathTracer::EquationSystem &p_system, Vector<double> &p_x)
+{
+  const double c_tol = 1.0e-10;
+  const int c_maxIter = 10;
+
+  int n = p_x.Length() - 1;
+  Vector<double> value(n);
+  Matrix<double> b(n + 1, n);
+  SquareMatrix<double> jacobian(n);
+  for (int iter = 1; iter <= c_maxIter; iter++) {
+    p_system.GetValue(p_x, value);
+    p_system.GetJacobian(p_x, b);
+    // The matrix is the transpose of the Jacobian, and the last row is
+    // the derivative with respect to lambda, which is held fixed
+    for (int i = 1; i <= n; i++) {
+      for (int j = 1; j <= n; j++) {
+	jacobian(i, j) = b(j, i);
+      }
+    }
+    Vector<double> step(n);
+    try {
+      step = jacobian.Inverse() * value;
+    }
+    catch (SingularMatrixException &) {
+      return false;
+    }
+    for (int i = 1; i <= n; i++) {
+      p_x[i] -= step[i];
+    }
+    double norm = std::sqrt(step.NormSquared());
+    if (!(norm < 1.0e10)) {
+      // Diverged, or produced a NaN
+      return false;
+    }
+    if (norm <= c_tol) {
+      return true;
+    }
+  }
+  return false;
+}
+
+//
+// Appends the points reported by the tracer to a branch
+//
+class BranchCallbackFunction : public PathTracer::CallbackFunction {
+public:
+  BranchCallbackFunction(CachedBranch &p_branch, bool p_skipFirst)
+    : m_branch(p_branch), m_skip(p_skipFirst) { }
+  virtual ~BranchCallbackFunction() { }
+
+  virtual void operator()(const Vector<double> &, bool) const { }
+  virtual void operator()(const Vector<double> &p_point,
+			  const Vector<double> &p_tangent,
+			  bool p_isTerminal) const
+  {
+    // The terminal point repeats the last accepted one, and when
+    // extending a branch the first point is its previous end
+    if (m_skip) {
+      m_skip = false;
+    }
+    else if (!p_isTerminal) {
+      m_branch.Append(p_point, p_tangent);
+    }
+  }
+
+private:
+  CachedBranch &m_branch;
+  mutable bool m_skip;
+};
+
+//
+// A criterion function which is zero where the path reaches a value
+// of lambda
+//
+class LambdaCriterion : public PathTracer::CriterionFunction {
+public:
+  LambdaCriterion(double p_lambda) : m_lambda(p_lambda) { }
+  virtual ~LambdaCriterion() { }
+
+  virtual double operator()(const Vector<double> &p_point,
+			    const Vector<double> &) const
+  { return p_point[p_point.Length()] - m_lambda; }
+
+private:
+  double m_lambda;
+};
+
+}   // end anonymous namespace
+
+std::string PathTracer::GetCacheKey(const Game &p_game,
+				    const std::string &p_kind) const
+{
+  if (m_cacheDirectory == "") {
+    return "";
+  }
+  // The branch depends on the game, and the points on it chosen on the
+  // parameters of the tracing
+  std::ostringstream s;
+  try {
+    p_game->Write(s);
+  }
+  catch (UndefinedException &) {
+    return "";
+  }
+  s << p_kind << ' ' << std::setprecision(17)
+    << m_hStart << ' ' << m_maxDecel << ' ' << m_maxUpdates;
+
+  // 64-bit FNV-1a hash of the description
+  std::string text = s.str();
+  unsigned long long hash = 14695981039346656037ULL;
+  for (size_t i = 0; i < text.length(); i++) {
+    hash ^= (unsigned char) text[i];
+    hash *= 1099511628211ULL;
+  }
+  std::ostringstream key;
+  key << std::hex << std::setw(16) << std::setfill('0') << hash;
+  return key.str();
+}
+
+void PathTracer::TraceCachedPath(const EquationSystem &p_system,
+				 const std::string &p_key,
+				 Vector<double> &p_x, double p_maxLambda,
+				 double &p_omega,
+				 const CallbackFunction &p_callback) const
+{
+  CachedBranch branch;
+  if (p_key == "" || !ReadCachedBranch(p_system, p_key, p_x, p_maxLambda,
+				       p_omega, branch)) {
+    TracePath(p_system, p_x, p_maxLambda, p_omega, p_callback);
+    return;
+  }
+
+  int last = branch.Find(p_maxLambda);
+  if (last < 0) {
+    last = branch.NumPoints() - 1;
+  }
+  for (int k = 0; k <= last; k++) {
+    p_callback(branch.m_points[k], branch.m_tangents[k], false);
+  }
+  p_x = branch.m_points[last];
+  p_callback(p_x, branch.m_tangents[last], true);
+}
+
+void PathTracer::SolveCachedAtLambda(const EquationSystem &p_system,
+				     const std::string &p_key,
+				     Vector<double> &p_x, double p_lambda,
+				     double p_maxLambda, double &p_omega,
+				     const CallbackFunction &p_callback) const
+{
+  CachedBranch branch;
+  if (p_key == "" || !ReadCachedBranch(p_system, p_key, p_x, p_maxLambda,
+				       p_omega, branch)) {
+    TracePath(p_system, p_x, p_maxLambda, p_omega, p_callback,
+	      LambdaCriterion(p_lambda));
+    return;
+  }
+
+  int k = branch.Find(p_lambda);
+  if (k < 0) {
+    // The branch ended before reaching p_lambda
+    TraceCachedPath(p_system, p_key, p_x, p_maxLambda, p_omega, p_callback);
+    return;
+  }
+  for (int j = 0; j < k; j++) {
+    p_callback(branch.m_points[j], branch.m_tangents[j], false);
+  }
+  if (k == 0) {
+    // The branch starts at or beyond p_lambda
+    p_x = branch.m_points[0];
+    p_callback(p_x, branch.m_tangents[0], false);
+    return;
+  }
+
+  Vector<double> x(p_x.Length()), tangent(p_x.Length());
+  branch.Interpolate(k, p_lambda, x, tangent);
+  if (Polish(p_system, x)) {
+    p_x = x;
+    p_callback(p_x, tangent, false);
+  }
+  else {
+    // Fall back on tracing from the last point before p_lambda
+    p_x = branch.m_points[k-1];
+    TracePath(p_system, p_x, p_maxLambda, p_omega, p_callback,
+	      LambdaCriterion(p_lambda), &branch.m_tangents[k-1]);
+  }
+}
+
+//
+// Reads the branch kept under p_key, tracing it, or extending it from its
+// last point, if it does not reach p_maxLambda.  Returns false if the
+// branch kept does not start at p_x, in which case it is not used.
+//
+bool PathTracer::ReadCachedBranch(const EquationSystem &p_system,
+				  const std::string &p_key,
+				  const Vector<double> &p_x,
+				  double p_maxLambda, double p_omega,
+				  CachedBranch &p_branch) const
+{
+  std::string filename = m_cacheDirectory + "/" + p_key + ".qre";
+  if (p_branch.Read(filename, p_key, p_x.Length())) {
+    if (!(p_branch.m_points.front() == p_x)) {
+      return false;
+    }
+    if (p_branch.Covers(p_maxLambda)) {
+      return true;
+    }
+    Vector<double> x(p_branch.m_points.back());
+    Vector<double> tangent(p_branch.m_tangents.back());
+    TracePath(p_system, x, p_maxLambda, p_omega,
+	      BranchCallbackFunction(p_branch, true),
+	      NullCriterionFunction(), &tangent);
+  }
+  else {
+    p_branch = CachedBranch();
+    Vector<double> x(p_x);
+    TracePath(p_system, x, p_maxLambda, p_omega,
+	      BranchCallbackFunction(p_branch, false));
+  }
+  p_branch.m_maxLambda = p_maxLambda;
+  p_branch.Write(filename, p_key);
+  return true;
+}
+
 }  // end namespace Gambit
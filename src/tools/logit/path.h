@@ -23,8 +23,13 @@
 #ifndef PATH_H
 #define PATH_H
 
+#include <string>
+#include <vector>
+
 namespace Gambit {
 
+class CachedBranch;
+
 //
 // This class implements a generic path-following algorithm for smooth curves.
 // It is based on the ideas and codes presented in Allgower and Georg's
@@ -75,6 +80,12 @@ public:
     virtual ~CallbackFunction() { }
     virtual void operator()(const Vector<double> &p_point,
 			    bool p_isTerminal) const = 0;
+    // Called by the tracer with the unit tangent at the point, oriented
+    // in the direction of travel.  By default the tangent is ignored.
+    virtual void operator()(const Vector<double> &p_point,
+			    const Vector<double> &p_tangent,
+			    bool p_isTerminal) const
+    { (*this)(p_point, p_isTerminal); }
   };
 
   //
@@ -85,27 +96,89 @@ public:
     virtual ~NullCallbackFunction() { }
     virtual void operator()(const Vector<double> &p_point,
 			    bool p_isTerminal) const { }
+    virtual void operator()(const Vector<double> &p_point,
+			    const Vector<double> &p_tangent,
+			    bool p_isTerminal) const { }
   };
   
 
+  //
+  // A record of the steps taken, with one string for each path traced,
+  // holding a character for each predictor-corrector step attempted:
+  // 'F' if the Jacobian was computed and factored, 'U' if the previous
+  // factorization was updated, in lower case if the step was rejected.
+  //
+  typedef std::vector<std::string> StepRecord;
+
   void SetMaxDecel(double p_maxDecel) { m_maxDecel = p_maxDecel; }
   double GetMaxDecel(void) const { return m_maxDecel; }
 
   void SetStepsize(double p_hStart) { m_hStart = p_hStart; }
   double GetStepsize(void) const { return m_hStart; }
 
+  // Set the number of consecutive steps which may use Broyden's secant
+  // update of the Jacobian instead of computing it; zero computes it at
+  // every step.  A step which fails with an updated Jacobian is retried
+  // with a computed one.
+  void SetMaxUpdates(int p_maxUpdates) { m_maxUpdates = p_maxUpdates; }
+  int GetMaxUpdates(void) const { return m_maxUpdates; }
+
+  // Set a record to which the steps of each path traced are added;
+  // if null, as by default, no record is kept.
+  void SetStepRecord(StepRecord *p_record) { m_stepRecord = p_record; }
+
+  // Set a directory in which traced branches are kept between runs;
+  // if empty, as by default, branches are always traced afresh.
+  void SetCacheDirectory(const std::string &p_directory)
+    { m_cacheDirectory = p_directory; }
+  const std::string &GetCacheDirectory(void) const { return m_cacheDirectory; }
+
 protected:
-  PathTracer(void) : m_maxDecel(1.1), m_hStart(0.03)
+  PathTracer(void) : m_maxDecel(1.1), m_hStart(0.03), m_maxUpdates(0),
+		     m_stepRecord(0)
     { } 
   virtual ~PathTracer() { }
 
+  // Trace the path from p_x, in the direction given by the sign of
+  // p_omega.  If p_direction is given, the sign of p_omega is instead set
+  // so that the path is traced in the direction closest to it.
   void TracePath(const EquationSystem &p_system,
 		 Vector<double> &p_x, double p_maxLambda, double &p_omega,
 		 const CallbackFunction &p_callback = NullCallbackFunction(),
-		 const CriterionFunction &p_criterion = NullCriterionFunction()) const;
+		 const CriterionFunction &p_criterion = NullCriterionFunction(),
+		 const Vector<double> *p_direction = 0) const;
+
+  // Returns the key under which branches of the game are cached, for
+  // tracers of the given kind, or an empty string if not caching.
+  std::string GetCacheKey(const Game &p_game, const std::string &p_kind) const;
+  // As TracePath() without a criterion, except that the points of the
+  // branch kept under p_key are reported instead of tracing them again.
+  // The branch is traced, or extended, and kept only if it does not
+  // already reach p_maxLambda.
+  void TraceCachedPath(const EquationSystem &p_system, const std::string &p_key,
+		       Vector<double> &p_x, double p_maxLambda, double &p_omega,
+		       const CallbackFunction &p_callback) const;
+  // Computes the first point on the branch at p_lambda, by interpolation
+  // between the points of the branch kept under p_key followed by
+  // Newton's method, tracing the branch towards p_maxLambda if it does
+  // not reach p_lambda.  The points before p_lambda are reported, then
+  // the point found, which is returned in p_x.
+  void SolveCachedAtLambda(const EquationSystem &p_system,
+			   const std::string &p_key,
+			   Vector<double> &p_x, double p_lambda,
+			   double p_maxLambda, double &p_omega,
+			   const CallbackFunction &p_callback) const;
 
 private:
   double m_maxDecel, m_hStart;
+  int m_maxUpdates;
+  std::string m_cacheDirectory;
+  StepRecord *m_stepRecord;
+
+  bool ReadCachedBranch(const EquationSystem &p_system,
+			const std::string &p_key, const Vector<double> &p_x,
+			double p_maxLambda, double p_omega,
+			CachedBranch &p_branch) const;
 };
 
 }  // end namespace Gambit
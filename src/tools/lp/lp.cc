@@ -53,6 +53,7 @@ void PrintHelp(char *progname)
   std::cerr << "                   display results with DECIMALS digits\n";
   std::cerr << "  -S               use strategic game\n";
   std::cerr << "  -P               find only subgame-perfect equilibria\n";
+  std::cerr << "  -j THREADS       with -P, solve up to THREADS subgames at once\n";
   std::cerr << "  -h, --help       print this help message\n";
   std::cerr << "  -q               quiet mode (suppresses banner)\n";
   std::cerr << "  -v, --version    print version information\n";
@@ -62,7 +63,7 @@ void PrintHelp(char *progname)
 int main(int argc, char *argv[])
 {
   int c;
-  int numDecimals = 6;
+  int numDecimals = 6, numThreads = 1;
   bool useFloat = false, useStrategic = false, quiet = false, printDetail = false;
   bool bySubgames = false;
 
@@ -72,7 +73,7 @@ int main(int argc, char *argv[])
     { "version", 0, NULL, 'v'  },
     { 0,    0,    0,    0   }
   };
-  while ((c = getopt_long(argc, argv, "d:DvqhSP", long_options, &long_opt_index)) != -1) {
+  while ((c = getopt_long(argc, argv, "d:DvqhSPj:", long_options, &long_opt_index)) != -1) {
     switch (c) {
     case 'v':
       PrintBanner(std::cerr); exit(1);
@@ -95,6 +96,9 @@ int main(int argc, char *argv[])
     case 'P':
       bySubgames = true;
       break;
+    case 'j':
+      numThreads = atoi(optarg);
+      break;
     case '?':
       if (isprint(optopt)) {
 	std::cerr << argv[0] << ": Unknown option `-" << ((char) optopt) << "'.\n";
@@ -126,7 +130,8 @@ int main(int argc, char *argv[])
   }
 
   try {
-    Gambit::Game game = Gambit::ReadGame(*input_stream);
+    Gambit::Game game = (optind < argc) ? Gambit::ReadGameFile(argv[optind]) :
+      Gambit::ReadGame(*input_stream);
     if (!game->IsTree() || useStrategic) {
       if (useFloat) {
 	shared_ptr<StrategyProfileRenderer<double> > renderer;
@@ -192,7 +197,7 @@ int main(int argc, char *argv[])
 	    renderer = new BehavStrategyCSVRenderer<double>(std::cout, 
 							    numDecimals);
 	  }
-	  SubgameBehavSolver<double> algorithm(stage, renderer);
+	  SubgameBehavSolver<double> algorithm(stage, renderer, numThreads);
 	  algorithm.Solve(game);
 	}
 	else {
@@ -207,7 +212,7 @@ int main(int argc, char *argv[])
 	    renderer = new BehavStrategyCSVRenderer<Rational>(std::cout, 
 							      numDecimals);
 	  }
-	  SubgameBehavSolver<Rational> algorithm(stage, renderer);
+	  SubgameBehavSolver<Rational> algorithm(stage, renderer, numThreads);
 	  algorithm.Solve(game);
 	}
       }
@@ -27,6 +27,7 @@
 #include <cerrno>
 #include <iomanip>
 #include <fstream>
+#include <sstream>
 #include "gambit/gambit.h"
 #include "gambit/nash.h"
 #include "gambit/nash/simpdiv.h"
@@ -87,8 +88,14 @@ void PrintHelp(char *progname)
   std::cerr << "With no options, computes one approximate Nash equilibrium.\n\n";
 
   std::cerr << "Options:\n";
-  std::cerr << "  -g MULT          granularity of grid refinement at each step (default is 2)\n";
+  std::cerr << "  -f               compute labels in floating point where this is safe\n";
+  std::cerr << "  -g MULT          granularity of grid refinement at each step (default is 2);\n";
+  std::cerr << "                   a comma-separated list runs from each starting point\n";
+  std::cerr << "                   once with each granularity\n";
   std::cerr << "  -h, --help       print this help message\n";
+  std::cerr << "  -j THREADS       run from THREADS starting points at once\n";
+  std::cerr << "  -e EQA           stop after finding EQA distinct equilibria\n";
+  std::cerr << "  -t SECONDS       stop after SECONDS seconds\n";
   std::cerr << "  -r DENOM         generate random starting points with denominator DENOM\n";
   std::cerr << "  -n COUNT         number of starting points to generate (requires -r)\n";
   std::cerr << "  -s FILE          file containing starting points\n";
@@ -104,8 +111,10 @@ int main(int argc, char *argv[])
   opterr = 0;
   std::string startFile;
   bool useRandom = false;
-  int randDenom = 1, gridResize = 2, stopAfter = 1;
-  bool verbose = false, quiet = false;
+  int randDenom = 1, numStarts = 1, numThreads = 1, stopAfter = 0;
+  double maxSeconds = 0.0;
+  Array<int> gridResizes;
+  bool verbose = false, quiet = false, fastLabels = false;
 
   int long_opt_index = 0;
   struct option long_options[] = {
@@ -115,13 +124,21 @@ int main(int argc, char *argv[])
     { 0,    0,    0,    0   }
   };
   int c;
-  while ((c = getopt_long(argc, argv, "g:hVvn:r:s:d:qS", long_options, &long_opt_index)) != -1) {
+  while ((c = getopt_long(argc, argv, "fg:hVvn:r:s:d:j:e:t:qS", long_options, &long_opt_index)) != -1) {
     switch (c) {
     case 'v':
       PrintBanner(std::cerr); exit(1);
-    case 'g':
-      gridResize = atoi(optarg);
+    case 'f':
+      fastLabels = true;
       break;
+    case 'g': {
+      std::istringstream list(optarg);
+      std::string item;
+      while (std::getline(list, item, ',')) {
+	gridResizes.Append(atoi(item.c_str()));
+      }
+      break;
+    }
     case 'h':
       PrintHelp(argv[0]);
       break;
@@ -130,8 +147,17 @@ int main(int argc, char *argv[])
       randDenom = atoi(optarg);
       break;
     case 'n':
+      numStarts = atoi(optarg);
+      break;
+    case 'j':
+      numThreads = atoi(optarg);
+      break;
+    case 'e':
       stopAfter = atoi(optarg);
       break;
+    case 't':
+      maxSeconds = atof(optarg);
+      break;
     case 's':
       startFile = optarg;
       break;
@@ -174,14 +200,15 @@ int main(int argc, char *argv[])
   }
 
   try {
-    Game game = ReadGame(*input_stream);
+    Game game = (optind < argc) ? ReadGameFile(argv[optind]) :
+      ReadGame(*input_stream);
     List<MixedStrategyProfile<Rational> > starts;
     if (startFile != "") {
       std::ifstream startPoints(startFile.c_str());
       starts = ReadProfiles(game, startPoints);
     }
     else if (useRandom) {
-      starts = RandomProfiles(game, stopAfter, randDenom);
+      starts = RandomProfiles(game, numStarts, randDenom);
     }
     else {
       starts.push_back(game->NewMixedStrategyProfile(Rational(0)));
@@ -190,12 +217,29 @@ int main(int argc, char *argv[])
 	starts[1][game->Players()[pl]->Strategies()[1]] = Rational(1);
       }
     }
-    for (int i = 1; i <= starts.size(); i++) {
-      shared_ptr<StrategyProfileRenderer<Rational> > renderer;
-      renderer = new MixedStrategyCSVRenderer<Rational>(std::cout);
-      NashSimpdivStrategySolver algorithm(gridResize, 0, verbose,
-					  renderer);
-      algorithm.Solve(starts[i]);
+    if (gridResizes.Length() == 0) {
+      gridResizes.Append(2);
+    }
+    shared_ptr<StrategyProfileRenderer<Rational> > renderer;
+    renderer = new MixedStrategyCSVRenderer<Rational>(std::cout);
+    NashSimpdivStrategySolver algorithm(gridResizes[1], 0, verbose,
+					renderer, fastLabels);
+    List<NashSimpdivRunSummary> summaries;
+    algorithm.Solve(starts, gridResizes, numThreads, stopAfter, maxSeconds,
+		    &summaries);
+    if (!quiet) {
+      for (int i = 1; i <= summaries.size(); i++) {
+	const NashSimpdivRunSummary &summary = summaries[i];
+	std::cerr << "Run " << i << ": start " 
+		  << (i - 1) / gridResizes.Length() + 1 
+		  << ", grid " << summary.m_gridResize << ", "
+		  << summary.m_grids << " grids, "
+		  << summary.m_labels << " labels ("
+		  << summary.m_exactLabels << " exact), "
+		  << summary.m_pivots << " pivots, "
+		  << ((summary.m_converged) ? "converged, " : "stopped, ")
+		  << summary.m_seconds << " seconds\n";
+      }
     }
     return 0;
   }